@@ -11,6 +11,7 @@
 #include <benchmark/benchmark.h>
 
 #include <dynd/array.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -28,6 +29,20 @@ BENCHMARK_TEMPLATE(BM_Array_BuiltinEmpty, int64_t);
 BENCHMARK_TEMPLATE(BM_Array_BuiltinEmpty, float);
 BENCHMARK_TEMPLATE(BM_Array_BuiltinEmpty, double);
 
+// The same, without the free lists of the pool allocator
+template <typename T>
+static void BM_Array_BuiltinEmpty_SystemAllocator(benchmark::State &state)
+{
+  ndt::type tp = ndt::type::make<T>();
+  set_memory_allocator(get_system_memory_allocator());
+  while (state.KeepRunning()) {
+    nd::empty(tp);
+  }
+  set_memory_allocator(NULL);
+}
+BENCHMARK_TEMPLATE(BM_Array_BuiltinEmpty_SystemAllocator, int32_t);
+BENCHMARK_TEMPLATE(BM_Array_BuiltinEmpty_SystemAllocator, double);
+
 template <typename T>
 static void BM_Array_1DEmpty(benchmark::State &state)
 {
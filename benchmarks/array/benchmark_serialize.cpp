@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/array.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/serialize.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static nd::array make_records(intptr_t size)
+{
+  stringstream ss;
+  ss << "[";
+  for (intptr_t i = 0; i < size; ++i) {
+    ss << (i == 0 ? "" : ", ") << "{\"name\": \"record number " << i << " of the benchmark\", \"values\": [" << i
+       << ", " << i + 1 << "]}";
+  }
+  ss << "]";
+
+  return parse_json(ndt::type("var * {name: string, values: var * int32}"), ss.str(), &eval::default_eval_context);
+}
+
+static void BM_Array_Serialize(benchmark::State &state)
+{
+  nd::array a = make_records(state.range_x());
+  while (state.KeepRunning()) {
+    nd::deserialize(nd::serialize(a));
+  }
+}
+BENCHMARK(BM_Array_Serialize)->Arg(1000)->Arg(100000);
+
+static void BM_Array_SerializeInPlace(benchmark::State &state)
+{
+  nd::array buffer = nd::serialize(make_records(state.range_x()));
+  while (state.KeepRunning()) {
+    nd::deserialize(buffer, nd::deserialize_in_place);
+  }
+}
+BENCHMARK(BM_Array_SerializeInPlace)->Arg(1000)->Arg(100000);
+
+// The same round trip through JSON
+static void BM_Array_JSONRoundTrip(benchmark::State &state)
+{
+  nd::array a = make_records(state.range_x());
+  while (state.KeepRunning()) {
+    parse_json(a.get_type(), format_json(a), &eval::default_eval_context);
+  }
+}
+BENCHMARK(BM_Array_JSONRoundTrip)->Arg(1000)->Arg(100000);
@@ -0,0 +1,153 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/number_conversion.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/array.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static const int number_count = 100000;
+
+static vector<double> random_doubles()
+{
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  vector<double> values(number_count);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = dist(rng);
+  }
+  return values;
+}
+
+static vector<std::string> random_double_strings()
+{
+  vector<double> values = random_doubles();
+  vector<std::string> strings(values.size());
+  char buffer[64];
+  for (size_t i = 0; i < values.size(); ++i) {
+    snprintf(buffer, sizeof(buffer), "%.17g", values[i]);
+    strings[i] = buffer;
+  }
+  return strings;
+}
+
+static void BM_NumberConversion_Strtod(benchmark::State &state)
+{
+  vector<std::string> strings = random_double_strings();
+  while (state.KeepRunning()) {
+    double sum = 0;
+    for (size_t i = 0; i < strings.size(); ++i) {
+      sum += strtod(strings[i].c_str(), NULL);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_NumberConversion_Strtod);
+
+static void BM_NumberConversion_ParseFloat64(benchmark::State &state)
+{
+  vector<std::string> strings = random_double_strings();
+  while (state.KeepRunning()) {
+    double sum = 0, value;
+    for (size_t i = 0; i < strings.size(); ++i) {
+      parse_float64(strings[i].data(), strings[i].data() + strings[i].size(), value);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+
+BENCHMARK(BM_NumberConversion_ParseFloat64);
+
+static void BM_NumberConversion_Snprintf(benchmark::State &state)
+{
+  vector<double> values = random_doubles();
+  char buffer[64];
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < values.size(); ++i) {
+      benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%.17g", values[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_NumberConversion_Snprintf);
+
+static void BM_NumberConversion_FormatFloat64(benchmark::State &state)
+{
+  vector<double> values = random_doubles();
+  char buffer[number_format_max_size];
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < values.size(); ++i) {
+      benchmark::DoNotOptimize(format_float64(buffer, values[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_NumberConversion_FormatFloat64);
+
+static void BM_NumberConversion_FormatInt64(benchmark::State &state)
+{
+  std::mt19937_64 rng(0);
+  vector<int64_t> values(number_count);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int64_t>(rng()) >> (rng() % 64);
+  }
+  char buffer[number_format_max_size];
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < values.size(); ++i) {
+      benchmark::DoNotOptimize(format_int64(buffer, values[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_NumberConversion_FormatInt64);
+
+// String <-> float64 assignment of whole arrays, which uses the batch functions
+
+static void BM_NumberConversion_AssignStringToFloat64(benchmark::State &state)
+{
+  vector<double> values = random_doubles();
+  nd::array a = nd::empty(number_count, ndt::string_type::make());
+  format_float64_strided(a.data(), sizeof(dynd::string), reinterpret_cast<const char *>(values.data()),
+                         sizeof(double), values.size());
+  nd::array b = nd::empty(number_count, ndt::type::make<double>());
+  while (state.KeepRunning()) {
+    b.vals() = a;
+  }
+  state.SetItemsProcessed(state.iterations() * number_count);
+}
+
+BENCHMARK(BM_NumberConversion_AssignStringToFloat64);
+
+static void BM_NumberConversion_FormatJSON(benchmark::State &state)
+{
+  vector<double> values = random_doubles();
+  nd::array a = nd::empty(number_count, ndt::type::make<double>());
+  memcpy(a.data(), values.data(), values.size() * sizeof(double));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(format_json(a));
+  }
+  state.SetItemsProcessed(state.iterations() * number_count);
+}
+
+BENCHMARK(BM_NumberConversion_FormatJSON);
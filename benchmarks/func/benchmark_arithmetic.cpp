@@ -11,6 +11,8 @@
 #include <benchmark/benchmark.h>
 
 #include <dynd/func/arithmetic.hpp>
+#include <dynd/func/comparison.hpp>
+#include <dynd/func/lazy.hpp>
 #include <dynd/func/random.hpp>
 
 using namespace std;
@@ -30,6 +32,30 @@ static void BM_Func_Arithmetic_Add(benchmark::State &state)
 
 BENCHMARK(BM_Func_Arithmetic_Add);
 
+static void BM_Func_Arithmetic_MultiplyAdd(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  while (state.KeepRunning()) {
+    nd::add(nd::multiply(a, b), c);
+  }
+}
+
+BENCHMARK(BM_Func_Arithmetic_MultiplyAdd)->Arg(1 << 16)->Arg(1 << 22);
+
+static void BM_Func_Arithmetic_Lazy_MultiplyAdd(benchmark::State &state)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::make_fixed_dim(state.range_x(), ndt::type::make<double>())));
+  while (state.KeepRunning()) {
+    (nd::functional::lazy(a) * b + c).eval();
+  }
+}
+
+BENCHMARK(BM_Func_Arithmetic_Lazy_MultiplyAdd)->Arg(1 << 16)->Arg(1 << 22);
+
 static void BM_Func_Arithmetic_Dispatch_time(benchmark::State &state){
   nd::array a = 5;
   nd::array b = (short)6;
@@ -72,6 +98,29 @@ static void BM_Func_Arithmetic_Dispatch_time_4(benchmark::State &state){
 
 BENCHMARK(BM_Func_Arithmetic_Dispatch_time_4);
 
+// Dispatching and instantiating a scalar kernel, without allocating or running it
+static void BM_Func_Arithmetic_Dispatch_Prepare(benchmark::State &state)
+{
+  ndt::type src_tp[2] = {ndt::type::make<int>(), ndt::type::make<double>()};
+  const char *src_arrmeta[2] = {NULL, NULL};
+  while (state.KeepRunning()) {
+    nd::add::get().prepare(ndt::type::make<double>(), NULL, 2, src_tp, src_arrmeta);
+  }
+}
+
+BENCHMARK(BM_Func_Arithmetic_Dispatch_Prepare);
+
+static void BM_Func_Comparison_Dispatch_Prepare(benchmark::State &state)
+{
+  ndt::type src_tp[2] = {ndt::type::make<int>(), ndt::type::make<double>()};
+  const char *src_arrmeta[2] = {NULL, NULL};
+  while (state.KeepRunning()) {
+    nd::less::get().prepare(ndt::type::make<bool1>(), NULL, 2, src_tp, src_arrmeta);
+  }
+}
+
+BENCHMARK(BM_Func_Comparison_Dispatch_Prepare);
+
 /*
 
 #ifdef DYND_CUDA
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include <benchmark/benchmark.h>
+
+#include <dynd/func/apply.hpp>
+#include <dynd/func/elwise.hpp>
+#include <dynd/types/typevar_map.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static const char *names[] = {"Dims", "R", "T", "N"};
+
+// Binding and looking up a few typevars, as one call to a callable does,
+// with the previous std::map representation
+static void BM_Type_TypeVars_StdMap(benchmark::State &state)
+{
+  ndt::type tp = ndt::type::make<int>();
+  while (state.KeepRunning()) {
+    std::map<std::string, ndt::type> tp_vars;
+    for (const char *name : names) {
+      tp_vars[name] = tp;
+    }
+    for (const char *name : names) {
+      benchmark::DoNotOptimize(tp_vars.find(name));
+    }
+  }
+}
+
+BENCHMARK(BM_Type_TypeVars_StdMap);
+
+static void BM_Type_TypeVars_TypeVarMap(benchmark::State &state)
+{
+  ndt::type tp = ndt::type::make<int>();
+  ndt::typevar_symbol symbols[] = {names[0], names[1], names[2], names[3]};
+  while (state.KeepRunning()) {
+    ndt::typevar_map tp_vars;
+    for (const ndt::typevar_symbol &symbol : symbols) {
+      tp_vars[symbol] = tp;
+    }
+    for (const ndt::typevar_symbol &symbol : symbols) {
+      benchmark::DoNotOptimize(tp_vars.find(symbol));
+    }
+  }
+}
+
+BENCHMARK(BM_Type_TypeVars_TypeVarMap);
+
+static void BM_Type_Match_TypeVars(benchmark::State &state)
+{
+  ndt::type pattern("(Dims... * T, Dims... * T, Fixed * S) -> Dims... * S");
+  ndt::type candidate("(3 * 4 * int32, 3 * 4 * int32, 5 * float64) -> 3 * 4 * float64");
+  while (state.KeepRunning()) {
+    ndt::typevar_map tp_vars;
+    benchmark::DoNotOptimize(pattern.match(candidate, tp_vars));
+  }
+}
+
+BENCHMARK(BM_Type_Match_TypeVars);
+
+static int add(int x, int y) { return x + y; }
+
+// The per-call dispatch time of a lifted callable, which matches typevars
+// and substitutes them into its return type on every call
+static void BM_Func_Elwise_Dispatch(benchmark::State &state)
+{
+  nd::callable af = nd::functional::elwise(nd::functional::apply<decltype(&add), &add>());
+
+  nd::array a = nd::array({1, 2, 3});
+  nd::array b = nd::array({4, 5, 6});
+  nd::array c = nd::empty(a.get_type());
+  while (state.KeepRunning()) {
+    af(a, b, kwds("dst", c));
+  }
+}
+
+BENCHMARK(BM_Func_Elwise_Dispatch);
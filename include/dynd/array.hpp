@@ -891,10 +891,12 @@ namespace nd {
   };
 
   /** Makes a strided array with uninitialized data. If axis_perm is NULL, it is
-   * C-order */
+   * C-order. The data is allocated following the data_alignment,
+   * separate_data_threshold and huge_page_threshold settings of ectx. */
   DYND_API array make_strided_array(const ndt::type &uniform_dtype, intptr_t ndim, const intptr_t *shape,
                                     int64_t access_flags = read_access_flag | write_access_flag,
-                                    const int *axis_perm = NULL);
+                                    const int *axis_perm = NULL,
+                                    const eval::eval_context *ectx = &eval::default_eval_context);
 
   /**
    * \brief Makes a strided array pointing to existing data
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+
+#include <dynd/array.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+
+namespace dynd {
+
+/**
+ * The header at the start of a dynd binary file, as written by
+ * ``nd::save_binary``. It is followed by the datashape of the array,
+ * its arrmeta, and padding up to ``data_offset``, where the data
+ * of the array starts.
+ *
+ * All fields are in the byte order of the machine which wrote the file,
+ * and the arrmeta holds values of ``intptr_t`` size, so a file can only be
+ * loaded on a machine like the one which wrote it. The ``byte_order`` and
+ * ``pointer_size`` fields check this.
+ */
+struct binary_file_header {
+  /** "DYNDBIN" followed by a zero */
+  char magic[8];
+  uint32_t version;
+  /** 0x01020304 as written, to check the byte order */
+  uint32_t byte_order;
+  uint32_t pointer_size;
+  /** The alignment of ``data_offset`` */
+  uint32_t data_alignment;
+  uint64_t datashape_size;
+  uint64_t arrmeta_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+namespace nd {
+
+  /**
+   * Writes an array to a dynd binary file (see binary_file_header), which
+   * ``nd::load_mmap`` maps back without copying. The data is written in
+   * C order, and is aligned to 64 bytes in the file, so it is aligned for
+   * SIMD loads when mapped.
+   *
+   * The type must be POD, with fixed dimensions, structs, tuples and other
+   * types whose data is self-contained. Types which point to other memory,
+   * like ``string`` or ``var`` dimensions, are rejected.
+   */
+  DYND_API void save_binary(const std::string &filename, const array &a);
+
+  /**
+   * Memory-maps a file written by ``nd::save_binary``, returning an array
+   * with its type, whose data is the mapped file. The array keeps the
+   * mapping alive.
+   *
+   * \param filename  The name of the file to map.
+   * \param access  The access permissions of the array. The file is opened
+   *                for writing only when ``nd::write_access_flag`` is set,
+   *                and writes go to the file.
+   * \param advice  How the data is going to be accessed, as a hint to the
+   *                operating system.
+   */
+  DYND_API array load_mmap(const std::string &filename, uint32_t access = read_access_flag | immutable_access_flag,
+                           memmap_advice_t advice = memmap_advice_normal);
+
+} // namespace dynd::nd
+} // namespace dynd
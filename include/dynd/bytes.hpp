@@ -6,110 +6,239 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 #include <dynd/config.hpp>
+#include <dynd/memblock/memory_block.hpp>
 
 namespace dynd {
 
+/**
+ * An owned sequence of bytes, the data of the ``bytes`` type and the base of
+ * ``dynd::string``.
+ *
+ * Data of up to ``inline_capacity`` bytes is stored inside the object itself,
+ * so short values need no allocation. Longer data is allocated with
+ * ``new[]``, or alternatively from a POD memory block serving as an arena,
+ * which frees all of its allocations in bulk.
+ *
+ * The zero-initialized object is the empty value.
+ */
 class DYND_API bytes {
 protected:
   char *m_data;
   size_t m_size;
 
+  // The last byte of the object describes how the data is stored. With the
+  // inline flag set, its low bits are the size and the data is stored from
+  // the start of the object. Otherwise m_data points at the data, which is
+  // deleted by the object unless the borrowed flag is set, and the remaining
+  // bits of m_size hold the size.
+  static const unsigned char inline_flag = 0x80;
+  static const unsigned char borrowed_flag = 0x40;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  static const int size_shift = 8;
+  static const int flag_shift = 0;
+#else
+  static const int size_shift = 0;
+  static const int flag_shift = 8 * sizeof(size_t) - 8;
+#endif
+
+  unsigned char tag() const { return reinterpret_cast<const unsigned char *>(this)[sizeof(char *) + sizeof(size_t) - 1]; }
+
+  bool is_owned() const { return (tag() & (inline_flag | borrowed_flag)) == 0; }
+
+  void set_allocated(char *data, size_t size, unsigned char flags)
+  {
+    if (size > max_size) {
+      throw std::length_error("dynd bytes value is too large");
+    }
+    m_data = data;
+    m_size = (size << size_shift) | (static_cast<size_t>(flags) << flag_shift);
+  }
+
+  /** Copies into the inline storage, where ``data`` may overlap it. */
+  void set_inline(const char *data, size_t size)
+  {
+    memmove(reinterpret_cast<char *>(this), data, size);
+    reinterpret_cast<unsigned char *>(this)[sizeof(char *) + sizeof(size_t) - 1] =
+        static_cast<unsigned char>(inline_flag | size);
+  }
+
 public:
+  /** The largest size stored inside the object without allocating. */
+  static const size_t inline_capacity = sizeof(char *) + sizeof(size_t) - 1;
+  /** The largest size representable. */
+  static const size_t max_size = (~static_cast<size_t>(0) >> 2) >> size_shift;
+
   bytes() : m_data(NULL), m_size(0)
   {
   }
 
-  bytes(const char *data, size_t size) : m_data(new char[size]), m_size(size) { memcpy(m_data, data, size); }
+  bytes(const char *data, size_t size) : m_data(NULL), m_size(0) { assign(data, size); }
 
-  bytes(const bytes &other) : m_data(new char[other.m_size]), m_size(other.m_size)
+  bytes(const bytes &other) : m_data(NULL), m_size(0)
   {
-    memcpy(m_data, other.m_data, other.m_size);
+    assign(other.data(), other.size());
   }
 
-  ~bytes() { delete[] m_data; }
+  ~bytes()
+  {
+    if (is_owned()) {
+      delete[] m_data;
+    }
+  }
+
+  /** Whether the data is stored inside the object. */
+  bool is_inline() const { return (tag() & inline_flag) != 0; }
 
   char *data()
   {
-    return m_data;
+    return is_inline() ? reinterpret_cast<char *>(this) : m_data;
   }
 
   const char *data() const
   {
-    return m_data;
+    return is_inline() ? reinterpret_cast<const char *>(this) : m_data;
   }
 
   size_t size() const
   {
-    return m_size;
+    unsigned char t = tag();
+    if (t & inline_flag) {
+      return t & ~inline_flag;
+    }
+    return (m_size & ~(static_cast<size_t>(inline_flag | borrowed_flag) << flag_shift)) >> size_shift;
   }
 
   bytes &assign(const char *data, size_t size)
   {
-    if (size != m_size) {
-      delete[] m_data;
-      m_data = new char[size];
-      m_size = size;
+    char *previous = is_owned() ? m_data : NULL;
+    if (size <= inline_capacity) {
+      set_inline(data, size);
+    } else if (previous != NULL && size == this->size()) {
+      memmove(m_data, data, size);
+      return *this;
+    } else {
+      char *new_data = new char[size];
+      memcpy(new_data, data, size);
+      set_allocated(new_data, size, 0);
     }
+    delete[] previous;
 
-    memcpy(m_data, data, m_size);
+    return *this;
+  }
+
+  /**
+   * Assigns a copy of the data which, if it doesn't fit inline, is allocated
+   * from ``arena`` instead of the heap. The arena is a POD memory block for a
+   * one byte type, such as the one returned by
+   * ``get_objectarray_memory_block_arena``, and must outlive this value.
+   * Nothing is freed when the value is destroyed, and the arena frees all
+   * its memory at once.
+   *
+   * POD memory blocks are not thread-safe, so one arena may only be used by
+   * one thread at a time.
+   */
+  bytes &assign(const char *data, size_t size, memory_block_data *arena)
+  {
+    char *previous = is_owned() ? m_data : NULL;
+    if (size <= inline_capacity) {
+      set_inline(data, size);
+    } else {
+      char *new_data = arena->get_api()->allocate(arena, size);
+      memcpy(new_data, data, size);
+      set_allocated(new_data, size, borrowed_flag);
+    }
+    delete[] previous;
 
     return *this;
   }
 
+  /**
+   * Makes the value view ``size`` bytes at ``data`` in place, without
+   * copying them, even if they would fit inline. The data must outlive the
+   * value, and is not freed by it.
+   */
+  bytes &borrow(char *data, size_t size)
+  {
+    char *previous = is_owned() ? m_data : NULL;
+    set_allocated(data, size, borrowed_flag);
+    delete[] previous;
+
+    return *this;
+  }
+
+  /** Whether the value views data it doesn't own, see ``borrow``. */
+  bool is_borrowed() const { return (tag() & (inline_flag | borrowed_flag)) == borrowed_flag; }
+
   void clear()
   {
-    if (m_size != 0) {
+    if (is_owned()) {
       delete[] m_data;
-      m_size = 0;
     }
+    m_data = NULL;
+    m_size = 0;
   }
 
   void resize(size_t size)
   {
-    if (size != m_size) {
-      char *data = new char[size];
-      memcpy(data, m_data, std::min(size, m_size));
-      delete[] m_data;
+    size_t previous_size = this->size();
+    if (size == previous_size) {
+      return;
+    }
 
-      m_data = data;
-      m_size = size;
+    if (size <= inline_capacity) {
+      char *previous = is_owned() ? m_data : NULL;
+      set_inline(data(), std::min(size, previous_size));
+      reinterpret_cast<unsigned char *>(this)[sizeof(char *) + sizeof(size_t) - 1] =
+          static_cast<unsigned char>(inline_flag | size);
+      delete[] previous;
+    } else {
+      char *new_data = new char[size];
+      memcpy(new_data, data(), std::min(size, previous_size));
+      if (is_owned()) {
+        delete[] m_data;
+      }
+      set_allocated(new_data, size, 0);
     }
   }
 
   char *begin()
   {
-    return m_data;
+    return data();
   }
 
   const char *begin() const
   {
-    return m_data;
+    return data();
   }
 
   char *end()
   {
-    return m_data + m_size;
+    return data() + size();
   }
 
   const char *end() const
   {
-    return m_data + m_size;
+    return data() + size();
   }
 
   bytes &operator=(const bytes &rhs)
   {
-    return assign(rhs.m_data, rhs.m_size);
+    return assign(rhs.data(), rhs.size());
   }
+
   bool operator==(const bytes &rhs) const
   {
-    return m_size == rhs.m_size && std::memcmp(m_data, rhs.m_data, m_size) == 0;
+    size_t n = size();
+    return n == rhs.size() && std::memcmp(data(), rhs.data(), n) == 0;
   }
 
   bool operator!=(const bytes &rhs) const
   {
-    return m_size != rhs.m_size || std::memcmp(m_data, rhs.m_data, m_size) != 0;
+    return !(*this == rhs);
   }
 };
 
@@ -9,6 +9,7 @@
 #include <map>
 
 #include <dynd/array.hpp>
+#include <dynd/types/typevar_map.hpp>
 
 namespace dynd {
 namespace nd {
@@ -25,7 +26,7 @@ namespace nd {
    */
   typedef char *(*callable_data_init_t)(char *static_data, const ndt::type &dst_tp, intptr_t nsrc,
                                         const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                        const std::map<std::string, ndt::type> &tp_vars);
+                                        const ndt::typevar_map &tp_vars);
 
   /**
    * Resolves the destination type for this callable based on the types
@@ -39,7 +40,7 @@ namespace nd {
    */
   typedef void (*callable_resolve_dst_type_t)(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                               const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                              const std::map<std::string, ndt::type> &tp_vars);
+                                              const ndt::typevar_map &tp_vars);
 
   /**
    * Function prototype for instantiating a kernel from an
@@ -77,7 +78,7 @@ namespace nd {
                                              const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                              const ndt::type *src_tp, const char *const *src_arrmeta,
                                              kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                             const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                                             const array *kwds, const ndt::typevar_map &tp_vars);
 
   /**
    * A function which deallocates the memory behind data_ptr after
@@ -169,19 +170,19 @@ namespace nd {
 
     array operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                      char *const *src_data, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars);
+                     const ndt::typevar_map &tp_vars);
 
     array operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
                      array *const *src_data, intptr_t nkwd, const array *kwds,
-                     const std::map<std::string, ndt::type> &tp_vars);
+                     const ndt::typevar_map &tp_vars);
 
     void operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                     const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data, intptr_t nkwd,
-                    const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                    const array *kwds, const ndt::typevar_map &tp_vars);
 
     void operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                     const ndt::type *src_tp, const char *const *src_arrmeta, array *const *src_data, intptr_t nkwd,
-                    const array *kwds, const std::map<std::string, ndt::type> &tp_vars);
+                    const array *kwds, const ndt::typevar_map &tp_vars);
 
     static void *operator new(size_t size, size_t static_data_size = 0)
     {
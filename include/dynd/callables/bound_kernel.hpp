@@ -0,0 +1,103 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+
+#include <dynd/arrmeta_holder.hpp>
+#include <dynd/jit.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+#include <dynd/callables/base_callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A ckernel that has been instantiated from a callable once, for fixed
+   * argument types and arrmeta, and that can then be executed any number of
+   * times on new data pointers. Executing it does no type matching and no
+   * allocation.
+   *
+   * Created by ``callable::prepare``.
+   */
+  class DYND_API bound_kernel {
+    intrusive_ptr<base_callable> m_self;
+    kernel_request_t m_kernreq;
+    ndt::type m_dst_tp;
+    // Owns the destination arrmeta when it was not provided to prepare
+    std::unique_ptr<arrmeta_holder> m_dst_arrmeta_holder;
+    const char *m_dst_arrmeta;
+    std::unique_ptr<ckernel_builder<kernel_request_host>> m_ckb;
+    // The size of the ckernel tree, as returned by instantiate
+    intptr_t m_ckb_size;
+
+  public:
+    bound_kernel() : m_kernreq(kernel_request_single), m_dst_arrmeta(NULL), m_ckb_size(0) {}
+
+    bound_kernel(const intrusive_ptr<base_callable> &self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                 std::unique_ptr<arrmeta_holder> &&dst_arrmeta_holder, const char *dst_arrmeta,
+                 std::unique_ptr<ckernel_builder<kernel_request_host>> &&ckb, intptr_t ckb_size)
+        : m_self(self), m_kernreq(kernreq), m_dst_tp(dst_tp), m_dst_arrmeta_holder(std::move(dst_arrmeta_holder)),
+          m_dst_arrmeta(dst_arrmeta), m_ckb(std::move(ckb)), m_ckb_size(ckb_size)
+    {
+    }
+
+    bound_kernel(bound_kernel &&) = default;
+
+    bound_kernel &operator=(bound_kernel &&) = default;
+
+    bool is_null() const { return m_ckb == NULL; }
+
+    kernel_request_t get_kernreq() const { return m_kernreq; }
+
+    /** The resolved destination type the ckernel writes. */
+    const ndt::type &get_dst_type() const { return m_dst_tp; }
+
+    /**
+     * The destination arrmeta the ckernel was instantiated with. Destination
+     * data must be laid out according to it.
+     */
+    const char *get_dst_arrmeta() const { return m_dst_arrmeta; }
+
+    ckernel_prefix *get() const { return m_ckb->get(); }
+
+    /**
+     * Replaces the function of a ckernel prepared with kernel_request_strided
+     * by one compiled by the JIT for this ckernel tree, with the calls to its
+     * children inlined and its strides folded to constants. Returns false, and
+     * leaves the ckernel as it was, if the JIT is not available or can't
+     * compile it. See ``jit::specialize``.
+     */
+    bool specialize()
+    {
+      if (is_null() || m_kernreq != kernel_request_strided) {
+        return false;
+      }
+
+      expr_strided_t fn = jit::specialize(get(), m_ckb_size);
+      if (fn == NULL) {
+        return false;
+      }
+
+      get()->function = reinterpret_cast<void *>(fn);
+      return true;
+    }
+
+    /** Executes a ckernel prepared with kernel_request_single. */
+    void single(char *dst, char *const *src) const
+    {
+      get()->get_function<expr_single_t>()(get(), dst, src);
+    }
+
+    /** Executes a ckernel prepared with kernel_request_strided. */
+    void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) const
+    {
+      get()->get_function<expr_strided_t>()(get(), dst, dst_stride, src, src_stride, count);
+    }
+  };
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -0,0 +1,118 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <dynd/callables/base_callable.hpp>
+
+namespace dynd {
+namespace nd {
+
+  /**
+   * A bounded, thread-safe cache of instantiated ckernels.
+   *
+   * Entries are keyed by the callable, the requested destination type, the
+   * source types, and a fingerprint of the arrmeta the ckernel was built
+   * against. Only types whose arrmeta is self-contained (builtin types, and
+   * fixed dimensions of them) are cached, because ckernels for other types may
+   * hold pointers into the arrmeta or into memory blocks that they reference.
+   *
+   * An entry is checked out of the cache while its ckernel is executing, so a
+   * ckernel is never run by two threads at the same time. Least recently used
+   * entries are evicted once the capacity is exceeded.
+   */
+  class DYND_API ckernel_cache {
+  public:
+    struct entry {
+      intrusive_ptr<base_callable> self;
+      size_t hash;
+      kernel_request_t kernreq;
+      ndt::type dst_tp;
+      ndt::type resolved_dst_tp;
+      std::vector<ndt::type> src_tp;
+      std::vector<char> arrmeta;
+      ckernel_builder<kernel_request_host> ckb;
+
+      bool matches(size_t hash, const base_callable *self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                   const char *const *src_arrmeta) const;
+    };
+
+  private:
+    typedef std::list<std::unique_ptr<entry>> entry_list;
+
+    std::mutex m_mutex;
+    entry_list m_entries;
+    std::unordered_multimap<size_t, entry_list::iterator> m_index;
+    std::atomic<size_t> m_capacity;
+    std::atomic<size_t> m_hits;
+    std::atomic<size_t> m_misses;
+
+    void evict(entry_list &evicted);
+
+  public:
+    ckernel_cache(size_t capacity = 256) : m_capacity(capacity), m_hits(0), m_misses(0) {}
+
+    ckernel_cache(const ckernel_cache &) = delete;
+
+    /**
+     * Returns true if a ckernel built for these types can be reused by a later
+     * call with equal types and equal arrmeta.
+     */
+    bool is_cacheable(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) const;
+
+    /**
+     * Looks up a ckernel, removing it from the cache on a hit. The caller
+     * returns it with ``release`` once it has finished executing it. Returns
+     * NULL on a miss.
+     */
+    std::unique_ptr<entry> acquire(base_callable *self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                                   const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                                   const char *const *src_arrmeta);
+
+    /**
+     * Makes an empty entry for the given key, into which the caller
+     * instantiates the ckernel before passing it to ``release``.
+     */
+    std::unique_ptr<entry> make_entry(base_callable *self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                                      const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                                      const char *const *src_arrmeta) const;
+
+    /** Puts an entry (back) into the cache, evicting old entries as needed. */
+    void release(std::unique_ptr<entry> &&e);
+
+    /** Removes all entries from the cache. */
+    void clear();
+
+    size_t size();
+
+    size_t get_capacity() const { return m_capacity; }
+
+    /** Sets the maximum number of entries. A capacity of 0 disables the cache. */
+    void set_capacity(size_t capacity);
+
+    size_t get_hits() const { return m_hits; }
+
+    size_t get_misses() const { return m_misses; }
+
+    void reset_stats()
+    {
+      m_hits = 0;
+      m_misses = 0;
+    }
+  };
+
+  /** The process-wide ckernel cache used by ``base_callable::operator()``. */
+  DYND_API ckernel_cache &get_ckernel_cache();
+
+} // namespace dynd::nd
+} // namespace dynd
@@ -33,6 +33,13 @@
 /** The number of elements to process at once when doing chunking/buffering */
 #define DYND_BUFFER_CHUNK_SIZE 128
 
+/**
+ * The number of elements per block when evaluating a fused expression. Every
+ * intermediate of the expression gets a temporary of this many elements, so
+ * all of them together should stay in cache.
+ */
+#define DYND_FUSED_BLOCK_SIZE 1024
+
 #ifdef __clang__
 
 #if __has_feature(cxx_constexpr)
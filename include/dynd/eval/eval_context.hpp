@@ -37,6 +37,18 @@ struct DYND_API eval_context {
     std::atomic<date_parse_order_t> date_parse_order;
     // Century selection for 2 digit years in date strings
     std::atomic<int> century_window;
+    // Number of threads elementwise operations may use, 0 for one per hardware thread
+    std::atomic<int> num_threads;
+    // Minimum number of elements each thread is given
+    std::atomic<intptr_t> min_grain_size;
+    // Alignment in memory of the data of new arrays with at least separate_data_threshold bytes
+    std::atomic<intptr_t> data_alignment;
+    // Size in bytes from which the data of a new array is allocated apart from its arrmeta
+    std::atomic<intptr_t> separate_data_threshold;
+    // Size in bytes from which the data of a new array is allocated on huge pages, 0 to never use them
+    std::atomic<intptr_t> huge_page_threshold;
+    // Whether strings and bytes assigned into a var dimension allocate their data from its memory block
+    std::atomic<bool> use_string_arena;
 #else
     // Default error mode for computations
     assign_error_mode errmode;
@@ -46,12 +58,27 @@ struct DYND_API eval_context {
     date_parse_order_t date_parse_order;
     // Century selection for 2 digit years in date strings
     int century_window;
+    // Number of threads elementwise operations may use, 0 for one per hardware thread
+    int num_threads;
+    // Minimum number of elements each thread is given
+    intptr_t min_grain_size;
+    // Alignment in memory of the data of new arrays with at least separate_data_threshold bytes
+    intptr_t data_alignment;
+    // Size in bytes from which the data of a new array is allocated apart from its arrmeta
+    intptr_t separate_data_threshold;
+    // Size in bytes from which the data of a new array is allocated on huge pages, 0 to never use them
+    intptr_t huge_page_threshold;
+    // Whether strings and bytes assigned into a var dimension allocate their data from its memory block
+    bool use_string_arena;
 #endif
 
     DYND_CONSTEXPR eval_context()
         : errmode(assign_error_fractional),
           cuda_device_errmode(assign_error_nocheck),
-          date_parse_order(date_parse_no_ambig), century_window(70)
+          date_parse_order(date_parse_no_ambig), century_window(70),
+          num_threads(1), min_grain_size(65536), data_alignment(64),
+          separate_data_threshold(256), huge_page_threshold(4 * 1024 * 1024),
+          use_string_arena(false)
     {
     }
 
@@ -61,7 +88,13 @@ struct DYND_API eval_context {
         : errmode(rhs.errmode.load()),
           cuda_device_errmode(rhs.cuda_device_errmode.load()),
           date_parse_order(rhs.date_parse_order.load()),
-          century_window(rhs.century_window.load())
+          century_window(rhs.century_window.load()),
+          num_threads(rhs.num_threads.load()),
+          min_grain_size(rhs.min_grain_size.load()),
+          data_alignment(rhs.data_alignment.load()),
+          separate_data_threshold(rhs.separate_data_threshold.load()),
+          huge_page_threshold(rhs.huge_page_threshold.load()),
+          use_string_arena(rhs.use_string_arena.load())
     {
     }
 
@@ -70,6 +103,12 @@ struct DYND_API eval_context {
         cuda_device_errmode.store(rhs.cuda_device_errmode.load());
         date_parse_order.store(rhs.date_parse_order.load());
         century_window.store(rhs.century_window.load());
+        num_threads.store(rhs.num_threads.load());
+        min_grain_size.store(rhs.min_grain_size.load());
+        data_alignment.store(rhs.data_alignment.load());
+        separate_data_threshold.store(rhs.separate_data_threshold.load());
+        huge_page_threshold.store(rhs.huge_page_threshold.load());
+        use_string_arena.store(rhs.use_string_arena.load());
         return *this;
     }
 #endif
@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace eval {
+
+  struct eval_context;
+
+  /**
+   * A pool of worker threads for running loops in parallel.
+   *
+   * ``parallel_for`` divides a range into chunks, and deals them out to the
+   * workers as contiguous runs. A worker which finishes its own run steals
+   * the back half of the remaining run of another worker, so an uneven load
+   * still keeps every worker busy until the end. The calling thread takes
+   * part as worker 0.
+   */
+  class DYND_API thread_pool {
+  public:
+    typedef std::function<void(int worker, intptr_t begin, intptr_t end)> loop_function;
+
+  private:
+    struct job;
+
+    std::vector<std::thread> m_threads;
+    std::atomic<int> m_num_threads;
+    // Held for the whole of a parallel_for, so only one runs at a time
+    std::mutex m_run_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    job *m_job;
+    size_t m_generation;
+    int m_active;
+    bool m_stop;
+
+    void worker_main(int worker, size_t generation);
+
+  public:
+    /** Creates a pool which runs loops on ``num_threads`` threads, including the caller. */
+    explicit thread_pool(int num_threads);
+
+    thread_pool(const thread_pool &) = delete;
+
+    ~thread_pool();
+
+    /** The number of threads a loop can run on, including the calling thread. */
+    int get_num_threads() const { return m_num_threads; }
+
+    /** Adds worker threads until the pool can run loops on ``num_threads`` threads. */
+    void reserve(int num_threads);
+
+    /**
+     * Calls ``func(worker, begin, end)`` for disjoint chunks covering
+     * ``[0, size)``, each at least ``grain`` long except perhaps the last, on
+     * up to ``num_workers`` threads. The worker index passed is less than
+     * ``num_workers``, and a worker only runs one chunk at a time. Blocks
+     * until every chunk has run, and rethrows the first exception thrown by
+     * ``func``, after which the chunks not yet started are skipped.
+     *
+     * A parallel_for called from inside another runs on the calling thread.
+     */
+    void parallel_for(int num_workers, intptr_t size, intptr_t grain, const loop_function &func);
+  };
+
+  /**
+   * Returns the process-wide thread pool, with at least ``num_threads``
+   * threads. A ``num_threads`` of 0 means one per hardware thread.
+   */
+  DYND_API thread_pool &get_thread_pool(int num_threads);
+
+  /**
+   * Resolves the ``num_threads`` setting of an evaluation context, where 0
+   * means one per hardware thread, to a thread count.
+   */
+  DYND_API int resolve_num_threads(int num_threads);
+
+  /**
+   * Decides how many workers a loop over ``size`` elements runs on, from the
+   * ``num_threads`` setting of ``ectx`` and a ``grain`` of elements each
+   * worker should at least get, where 0 means the ``min_grain_size`` of
+   * ``ectx``. Returns 1 when the loop should stay on the calling thread, and
+   * otherwise the number of workers, with ``*pool`` set to a thread pool
+   * having that many threads.
+   */
+  DYND_API int plan_workers(const eval_context *ectx, intptr_t size, thread_pool **pool, intptr_t grain = 0);
+
+} // namespace dynd::eval
+} // namespace dynd
@@ -27,16 +27,9 @@ namespace nd {
         children[i0] = functional::elwise(child_tp, self);
       }
 
-      return functional::multidispatch(self.get_array_type(),
-                                       [children](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
-                                                  const ndt::type *src_tp) mutable -> callable & {
-                                         callable &child = children[src_tp[0].get_type_id()];
-                                         if (child.is_null()) {
-                                           throw std::runtime_error(FuncType::what(src_tp[0]));
-                                         }
-
-                                         return child;
-                                       });
+      return functional::dispatch(self.get_array_type(), children,
+                                  [](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
+                                     const ndt::type *src_tp) { throw std::runtime_error(FuncType::what(src_tp[0])); });
     }
   };
 
@@ -83,16 +76,11 @@ namespace nd {
         }
       }
 
-      return functional::multidispatch(
-          ndt::type("(Any, Any) -> Any"), [children](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
-                                                     const ndt::type *src_tp) mutable -> callable & {
-            callable &child = children[{{src_tp[0].get_type_id(), src_tp[1].get_type_id()}}];
-            if (child.is_null()) {
-              throw std::runtime_error(FuncType::what(src_tp[0], src_tp[1]));
-            }
-
-            return child;
-          });
+      return functional::dispatch(ndt::type("(Any, Any) -> Any"), children,
+                                  [](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
+                                     const ndt::type *src_tp) {
+                                    throw std::runtime_error(FuncType::what(src_tp[0], src_tp[1]));
+                                  });
     }
   };
 
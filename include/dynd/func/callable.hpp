@@ -17,6 +17,7 @@
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/callables/static_data_callable.hpp>
+#include <dynd/callables/bound_kernel.hpp>
 
 namespace dynd {
 namespace nd {
@@ -46,7 +47,7 @@ namespace nd {
     DYND_API void check_narg(const ndt::callable_type *af_tp, intptr_t narg);
 
     DYND_API void check_arg(const ndt::callable_type *af_tp, intptr_t i, const ndt::type &actual_tp,
-                            const char *actual_arrmeta, std::map<std::string, ndt::type> &tp_vars);
+                            const char *actual_arrmeta, ndt::typevar_map &tp_vars);
 
     inline void set_data(char *&data, array &value) { data = const_cast<char *>(value.cdata()); }
 
@@ -324,9 +325,37 @@ namespace nd {
 
     const array &get_arg_types() const { return get_type()->get_pos_types(); }
 
+    /**
+     * Matches the argument types against the signature of the callable,
+     * resolves the destination type, and instantiates the ckernel once,
+     * returning it bound for repeated execution on new data. Optional keyword
+     * arguments are passed as missing.
+     *
+     * \param dst_tp  The destination type, or a null type to resolve it from
+     *                the return type of the callable.
+     * \param dst_arrmeta  The destination arrmeta, which must outlive the
+     *                     bound kernel, or NULL to default construct it.
+     * \param nsrc  The number of source arguments.
+     * \param src_tp  An array of the source types.
+     * \param src_arrmeta  An array of the source arrmeta. The source data
+     *                     passed to the bound kernel must match it.
+     * \param kernreq  Either kernel_request_single or kernel_request_strided.
+     */
+    bound_kernel prepare(const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                         const char *const *src_arrmeta, kernel_request_t kernreq = kernel_request_single) const;
+
+    bound_kernel prepare(intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
+                         kernel_request_t kernreq = kernel_request_single) const
+    {
+      return prepare(ndt::type(), NULL, nsrc, src_tp, src_arrmeta, kernreq);
+    }
+
+    /** Prepares the callable for arguments with the types and arrmeta of ``src`` */
+    bound_kernel prepare(intptr_t nsrc, const array *src, kernel_request_t kernreq = kernel_request_single) const;
+
     /** Implements the general call operator which returns an array */
     template <typename ArgsType, typename KwdsType>
-    array call(const ArgsType &args, const KwdsType &kwds, std::map<std::string, ndt::type> &tp_vars)
+    array call(const ArgsType &args, const KwdsType &kwds, ndt::typevar_map &tp_vars)
     {
       const ndt::callable_type *self_tp = get_type();
 
@@ -432,7 +461,7 @@ namespace nd {
     template <template <typename...> class ArgsType, typename AT0, typename... K>
     array _call(detail::kwds<K...> &&k)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
       return call(ArgsType<AT0>(tp_vars, get_type()), std::forward<detail::kwds<K...>>(k), tp_vars);
     }
 
@@ -442,7 +471,7 @@ namespace nd {
     template <template <typename...> class ArgsType, typename AT0, typename... T>
     typename std::enable_if<sizeof...(T) != 3, array>::type _call(T &&... a)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
 
       typedef typename instantiate<ArgsType, typename to<type_sequence<AT0, T...>, sizeof...(T)>::type>::type args_type;
       typedef make_index_sequence<sizeof...(T) + 1> I;
@@ -455,7 +484,7 @@ namespace nd {
                             array>::type
     _call(A0 &&a0, A1 &&a1, const detail::kwds<K...> &kwds)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
 
       return call(
           ArgsType<AT0, array, array>(tp_vars, get_type(), array(std::forward<A0>(a0)), array(std::forward<A1>(a1))),
@@ -467,7 +496,7 @@ namespace nd {
                             array>::type
     _call(A0 &&a0, A1 &&a1, const detail::kwds<K...> &kwds)
     {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
       return call(ArgsType<AT0, size_t, array *>(tp_vars, get_type(), std::forward<A0>(a0), std::forward<A1>(a1)), kwds,
                   tp_vars);
     }
@@ -637,7 +666,7 @@ namespace nd {
     ndt::type *tp;
     const char *const *arrmeta;
 
-    args(std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars), const ndt::callable_type *self_tp)
+    args(ndt::typevar_map &DYND_UNUSED(tp_vars), const ndt::callable_type *self_tp)
         : values(nullptr), tp(nullptr), arrmeta(nullptr)
     {
       detail::check_narg(self_tp, 0);
@@ -655,7 +684,7 @@ namespace nd {
     const char *arrmeta[sizeof...(A)];
     DataType m_data[sizeof...(A)];
 
-    args(std::map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, A &&... a)
+    args(ndt::typevar_map &tp_vars, const ndt::callable_type *self_tp, A &&... a)
         : values{std::forward<A>(a)...}
     {
       if (!self_tp->is_pos_variadic() && (static_cast<intptr_t>(sizeof...(A)) < self_tp->get_npos())) {
@@ -686,7 +715,7 @@ namespace nd {
     const char **arrmeta;
     std::vector<DataType> m_data;
 
-    args(std::map<std::string, ndt::type> &tp_vars, const ndt::callable_type *self_tp, size_t size, array *values)
+    args(ndt::typevar_map &tp_vars, const ndt::callable_type *self_tp, size_t size, array *values)
         : size(size), values(values), tp(new ndt::type[size]), arrmeta(new const char *[size]), m_data(size)
     {
       detail::check_narg(self_tp, size);
@@ -3,6 +3,8 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#pragma once
+
 #include <dynd/func/callable.hpp>
 #include <dynd/func/call.hpp>
 #include <dynd/func/elwise.hpp>
@@ -59,16 +61,11 @@ namespace nd {
     static callable make()
     {
       auto children = FuncType::make_children();
-      return functional::multidispatch(
-          ndt::type("(Any, Any) -> Any"), [children](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
-                                                     const ndt::type *src_tp) mutable -> callable & {
-            callable &child = children[{{src_tp[0].get_type_id(), src_tp[1].get_type_id()}}];
-            if (child.is_null()) {
-              throw std::runtime_error("no child found");
-            }
-
-            return child;
-          });
+      return functional::dispatch(ndt::type("(Any, Any) -> Any"), children,
+                                  [](const ndt::type &DYND_UNUSED(dst_tp), intptr_t DYND_UNUSED(nsrc),
+                                     const ndt::type *DYND_UNUSED(src_tp)) {
+                                    throw std::runtime_error("no child found");
+                                  });
     }
   };
 
@@ -89,6 +86,8 @@ namespace nd {
       children[{{tuple_type_id, tuple_type_id}}] = callable::make<equal_kernel<tuple_type_id, tuple_type_id>>(0);
       children[{{struct_type_id, struct_type_id}}] = callable::make<equal_kernel<tuple_type_id, tuple_type_id>>(0);
       children[{{type_type_id, type_type_id}}] = callable::make<equal_kernel<type_type_id, type_type_id>>(0);
+      children[{{categorical_type_id, categorical_type_id}}] =
+          callable::make<equal_kernel<categorical_type_id, categorical_type_id>>(0);
 
       return children;
     }
@@ -105,6 +104,8 @@ namespace nd {
       children[{{tuple_type_id, tuple_type_id}}] = callable::make<not_equal_kernel<tuple_type_id, tuple_type_id>>(0);
       children[{{struct_type_id, struct_type_id}}] = callable::make<not_equal_kernel<tuple_type_id, tuple_type_id>>(0);
       children[{{type_type_id, type_type_id}}] = callable::make<not_equal_kernel<type_type_id, type_type_id>>(0);
+      children[{{categorical_type_id, categorical_type_id}}] =
+          callable::make<not_equal_kernel<categorical_type_id, categorical_type_id>>(0);
 
       return children;
     }
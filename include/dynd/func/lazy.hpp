@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <memory>
+
+#include <dynd/func/callable.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    namespace detail {
+      struct lazy_node;
+    } // namespace dynd::nd::functional::detail
+
+    /**
+     * An elementwise expression which is recorded, but not evaluated, until
+     * ``eval`` is called. Each node applies a callable to other expressions,
+     * with arrays at the leaves.
+     *
+     * Evaluating the expression fuses it into one ckernel, which runs all
+     * the callables on blocks of DYND_FUSED_BLOCK_SIZE elements. The
+     * intermediate results only ever fill a block temporary, so a formula
+     * like ``a * b + c`` makes one pass over its arrays instead of
+     * allocating and rereading a full array for ``a * b``. A subexpression
+     * which appears more than once is evaluated once per block.
+     *
+     * The callables must be elementwise, taking scalars to a scalar and with
+     * no keyword arguments, like ``nd::add`` or ``nd::sin``. The leaves are
+     * broadcast against each other as in any elementwise call.
+     */
+    class DYND_API lazy {
+      std::shared_ptr<const detail::lazy_node> m_node;
+
+      friend struct detail::lazy_node;
+
+    public:
+      /** An expression which is the array ``a`` */
+      lazy(const array &a);
+
+      /**
+       * An expression applying ``f`` to ``args``. The result type is
+       * resolved here, so an invalid expression is reported when it is built.
+       */
+      lazy(const callable &f, const std::vector<lazy> &args);
+
+      /** The scalar type of the elements of the expression */
+      const ndt::type &get_dtype() const;
+
+      /**
+       * Returns the fused callable for this expression, and fills ``args`` with
+       * the leaf arrays it should be called with. The callable is elementwise,
+       * so it can also be called with other arrays of the same dtypes.
+       */
+      callable fuse(std::vector<array> &args) const;
+
+      /** Evaluates the expression into a new array */
+      array eval() const;
+
+      /** Evaluates the expression into ``dst``, converting to its type if needed */
+      void eval(const array &dst) const;
+    };
+
+    DYND_API lazy operator+(const lazy &a0, const lazy &a1);
+    DYND_API lazy operator-(const lazy &a0, const lazy &a1);
+    DYND_API lazy operator*(const lazy &a0, const lazy &a1);
+    DYND_API lazy operator/(const lazy &a0, const lazy &a1);
+    DYND_API lazy operator-(const lazy &a0);
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -6,9 +6,11 @@
 #pragma once
 
 #include <numeric>
+#include <sstream>
 
 #include <dynd/iterator.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/kernels/dispatch_kernel.hpp>
 #include <dynd/kernels/multidispatch_kernel.hpp>
 
 namespace dynd {
@@ -51,7 +53,7 @@ namespace nd {
             continue;
           }
 
-          std::map<std::string, ndt::type> tp_vars;
+          ndt::typevar_map tp_vars;
           if (!tp.match(child.get_array_type(), tp_vars)) {
           }
 
@@ -193,6 +195,103 @@ namespace nd {
       return multidispatch(tp, std::begin(children), std::end(children), permutation);
     }
 
+    /**
+     * Creates a callable which dispatches on the type ids of its first ``N``
+     * arguments through a dense table (see dispatch_kernel), for children
+     * keyed by built-in type ids. When there is no child for the arguments,
+     * ``on_null`` is called with ``(dst_tp, nsrc, src_tp)`` and must throw.
+     */
+    template <size_t N, typename OnNullType>
+    callable dispatch(const ndt::type &tp, const std::map<std::array<type_id_t, N>, callable> &children,
+                      const OnNullType &on_null)
+    {
+      typedef dispatch_kernel<N, dispatch_src, OnNullType> kernel_type;
+
+      return callable::make<kernel_type>(tp, typename kernel_type::static_data_type(children, on_null));
+    }
+
+    template <typename OnNullType>
+    callable dispatch(const ndt::type &tp, const std::map<type_id_t, callable> &children, const OnNullType &on_null)
+    {
+      std::map<std::array<type_id_t, 1>, callable> keyed_children;
+      for (const auto &pair : children) {
+        keyed_children[{{pair.first}}] = pair.second;
+      }
+
+      return dispatch<1>(tp, keyed_children, on_null);
+    }
+
+    /**
+     * Creates a callable which dispatches through a dense table on the type
+     * id of the dtype of its destination, for children indexed by it, like the
+     * random number callables.
+     */
+    template <typename OnNullType>
+    callable dispatch_dst(const ndt::type &tp, const callable (&children)[DYND_TYPE_ID_MAX + 1],
+                          const OnNullType &on_null)
+    {
+      typedef dispatch_kernel<1, dispatch_dst_dtype, OnNullType> kernel_type;
+
+      std::map<std::array<type_id_t, 1>, callable> keyed_children;
+      for (type_id_t i = uninitialized_type_id; i <= static_cast<type_id_t>(DYND_TYPE_ID_MAX);
+           i = static_cast<type_id_t>(i + 1)) {
+        if (!children[i].is_null()) {
+          keyed_children[{{i}}] = children[i];
+        }
+      }
+
+      return callable::make<kernel_type>(tp, typename kernel_type::static_data_type(keyed_children, on_null));
+    }
+
+    /**
+     * Creates a callable which dispatches on the type ids of the arguments of
+     * children with concrete signatures, like ``multidispatch``, but through
+     * a dense table. The callable must take one or two arguments.
+     */
+    template <typename IteratorType>
+    callable dispatch(const ndt::type &tp, const IteratorType &begin_child, const IteratorType &end_child)
+    {
+      auto on_null = [](const ndt::type &DYND_UNUSED(dst_tp), intptr_t nsrc, const ndt::type *src_tp) {
+        std::stringstream ss;
+        ss << "no viable overload for nd::functional::dispatch with argument types";
+        for (intptr_t i = 0; i < nsrc; ++i) {
+          ss << (i == 0 ? " " : ", ") << "\"" << src_tp[i] << "\"";
+        }
+        throw std::runtime_error(ss.str());
+      };
+
+      intptr_t npos = tp.extended<ndt::callable_type>()->get_npos();
+      if (tp.extended<ndt::callable_type>()->is_pos_variadic() || npos < 1 || npos > 2) {
+        throw std::invalid_argument("dispatch requires a callable with one or two arguments");
+      }
+
+      std::map<std::array<type_id_t, 2>, callable> children;
+      for (IteratorType it = begin_child; it != end_child; ++it) {
+        const callable &child = *it;
+        if (child.is_null()) {
+          continue;
+        }
+
+        const ndt::type *arg_tp = reinterpret_cast<const ndt::type *>(child.get_arg_types().cdata());
+        children[{{arg_tp[0].get_type_id(), (npos == 1) ? uninitialized_type_id : arg_tp[1].get_type_id()}}] = child;
+      }
+
+      if (npos == 1) {
+        std::map<std::array<type_id_t, 1>, callable> unary_children;
+        for (const auto &pair : children) {
+          unary_children[{{pair.first[0]}}] = pair.second;
+        }
+        return dispatch<1>(tp, unary_children, on_null);
+      }
+
+      return dispatch<2>(tp, children, on_null);
+    }
+
+    inline callable dispatch(const ndt::type &tp, const std::initializer_list<callable> &children)
+    {
+      return dispatch(tp, std::begin(children), std::end(children));
+    }
+
   } // namespace dynd::nd::functional
 } // namespace dynd::nd
 } // namespace dynd
@@ -51,7 +51,7 @@ namespace kernels {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       const std::pair<nd::callable, std::vector<intptr_t>> *data =
           reinterpret_cast<std::pair<nd::callable, std::vector<intptr_t>> *>(static_data);
@@ -134,7 +134,7 @@ namespace kernels {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       const std::pair<nd::callable, std::vector<intptr_t>> *data =
           reinterpret_cast<std::pair<nd::callable, std::vector<intptr_t>> *>(static_data);
@@ -10,12 +10,43 @@ namespace dynd {
 namespace nd {
   namespace random {
 
+    // The random number callables fill the array given by "dst_tp" or "dst"
+    // from a counter-based generator. They take optional "seed" and "stream"
+    // keyword arguments. The same seed, stream and shape always give the same
+    // values, whether or not the fill runs on several threads. Without a seed,
+    // each call uses a new stream of a seed drawn once per process.
+
+    /**
+     * Uniform values in [a, b] for integers, defaulting to the whole
+     * non-negative range, and in [a, b) for real and complex numbers,
+     * defaulting to [0, 1).
+     */
     extern DYND_API struct uniform : declfunc<uniform> {
       static DYND_API callable children[DYND_TYPE_ID_MAX + 1];
 
       static DYND_API callable make();
     } uniform;
 
+    /**
+     * Normally distributed real values, with keyword arguments ``mean``
+     * (default 0) and ``stddev`` (default 1).
+     */
+    extern DYND_API struct normal : declfunc<normal> {
+      static DYND_API callable children[DYND_TYPE_ID_MAX + 1];
+
+      static DYND_API callable make();
+    } normal;
+
+    /**
+     * Exponentially distributed real values, with the rate keyword argument
+     * ``lambda`` (default 1).
+     */
+    extern DYND_API struct exponential : declfunc<exponential> {
+      static DYND_API callable children[DYND_TYPE_ID_MAX + 1];
+
+      static DYND_API callable make();
+    } exponential;
+
   } // namespace dynd::nd::random
 
   inline array rand(const ndt::type &tp)
@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/ckernel_prefix.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace jit {
+
+    /**
+     * Whether libdynd was built with the LLVM JIT (the DYND_LLVM option).
+     * Without it, ``specialize`` always returns NULL.
+     */
+    DYND_API bool is_available();
+
+    /**
+     * Records the LLVM IR emitted for the kernel functions ``single`` and
+     * ``strided`` of one ckernel type. The IR is a module defining functions
+     * named "single_wrapper" and "strided_wrapper", as produced by the clang
+     * plugin for functions annotated with DYND_EMIT_LLVM. Called once per
+     * ckernel type the first time it is instantiated.
+     */
+    DYND_API void register_ir(void *single, void *strided, const char *ir);
+
+    /**
+     * Compiles the strided ckernel tree of ``size`` bytes at ``self`` into one
+     * native function. The data of the tree is folded in as constants, so the
+     * child function pointers become direct calls which are inlined, the
+     * strides and offsets become immediates, and the element loop is
+     * optimized and vectorized as a whole.
+     *
+     * The returned function ignores its ``self`` argument, but the tree must
+     * stay alive while it is used, because the heap memory it refers to is
+     * still used. Functions are cached by the contents of the tree, which
+     * holds the kernel functions and strides of its types and arrmeta.
+     *
+     * Returns NULL if the JIT is not available, if a kernel in the tree has
+     * no IR, or if a kernel writes to its own data, which can't be folded.
+     */
+    DYND_API expr_strided_t specialize(ckernel_prefix *self, intptr_t size);
+
+    namespace detail {
+
+#ifdef DYND_LLVM
+      template <typename KernelType>
+      void register_ir(void *single, void *strided)
+      {
+        static const bool registered = (jit::register_ir(single, strided, const_cast<const char *>(KernelType::ir)),
+                                        true);
+        (void)registered;
+      }
+#else
+      template <typename KernelType>
+      void register_ir(void *DYND_UNUSED(single), void *DYND_UNUSED(strided))
+      {
+      }
+#endif
+
+    } // namespace dynd::nd::jit::detail
+
+  } // namespace dynd::nd::jit
+} // namespace dynd::nd
+} // namespace dynd
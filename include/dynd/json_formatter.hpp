@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <functional>
+#include <ostream>
+
 #include <dynd/array.hpp>
 
 namespace dynd {
@@ -18,4 +21,77 @@ namespace dynd {
  */
 DYND_API nd::array format_json(const nd::array &a, bool struct_as_list = false);
 
+/**
+ * A destination for JSON that is formatted incrementally. The formatter
+ * fills a fixed size buffer, and passes its contents to ``write`` each time
+ * it is full, so the memory used doesn't depend on the size of the output.
+ */
+class DYND_API json_sink {
+public:
+  virtual ~json_sink();
+
+  /** Consumes the formatted characters ``[begin, end)``. */
+  virtual void write(const char *begin, const char *end) = 0;
+
+  /** Called after the last ``write`` of a formatting call. The default does nothing. */
+  virtual void flush();
+};
+
+/** A sink that calls a function with each chunk of output. */
+class DYND_API json_callback_sink : public json_sink {
+  std::function<void(const char *, const char *)> m_callback;
+
+public:
+  json_callback_sink(const std::function<void(const char *, const char *)> &callback) : m_callback(callback) {}
+
+  void write(const char *begin, const char *end);
+};
+
+/** A sink that writes to an ``std::ostream``, and flushes it at the end. */
+class DYND_API json_ostream_sink : public json_sink {
+  std::ostream &m_os;
+
+public:
+  json_ostream_sink(std::ostream &os) : m_os(os) {}
+
+  void write(const char *begin, const char *end);
+  void flush();
+};
+
+/**
+ * A sink that writes to an open file descriptor, retrying partial writes.
+ * The descriptor is not closed.
+ */
+class DYND_API json_fd_sink : public json_sink {
+  int m_fd;
+
+public:
+  json_fd_sink(int fd) : m_fd(fd) {}
+
+  void write(const char *begin, const char *end);
+};
+
+/**
+ * Formats the nd::array as JSON into a sink, through a buffer of
+ * ``buffer_size`` bytes.
+ *
+ * \param a  The array to format as JSON.
+ * \param sink  Where the formatted JSON is written.
+ * \param struct_as_list  If true, formats struct objects as lists, otherwise
+ *                        formats them as objects/dicts.
+ * \param buffer_size  The largest chunk passed to the sink. Values below 64
+ *                     are raised to 64.
+ */
+DYND_API void format_json(const nd::array &a, json_sink &sink, bool struct_as_list = false,
+                          intptr_t buffer_size = 65536);
+
+/**
+ * Formats each element of the outermost dimension of the nd::array as JSON
+ * on a line of its own, the newline-delimited layout which
+ * ``nd::json::parse_lines`` reads. Records are written to the sink as the
+ * buffer fills, so arbitrarily large arrays are formatted in bounded memory.
+ */
+DYND_API void format_json_lines(const nd::array &a, json_sink &sink, bool struct_as_list = false,
+                                intptr_t buffer_size = 65536);
+
 } // namespace dynd
@@ -34,6 +34,38 @@ namespace nd {
 
     DYND_API array parse(const ndt::type &tp, const std::string &str);
 
+    /**
+     * Parses newline-delimited JSON, encoded as UTF-8, into a ``var * tp``
+     * array with one element per non-blank line.
+     *
+     * The buffer is split at line boundaries into one piece per thread, and
+     * the pieces are parsed concurrently, each directly into its own slice
+     * of the result. A ``tp`` containing var dims is parsed on the calling
+     * thread, because its records share one memory block.
+     *
+     * \param tp  The type of each line's value.
+     * \param begin  The beginning of the UTF-8 buffer containing the JSON.
+     * \param end  One past the end of the UTF-8 buffer containing the JSON.
+     * \param nthreads  The maximum number of threads to parse with, where 0
+     *                  means one per hardware thread.
+     */
+    DYND_API array parse_lines(const ndt::type &tp, const char *begin, const char *end, int nthreads);
+
+    inline array parse_lines(const ndt::type &tp, const char *begin, const char *end)
+    {
+      return parse_lines(tp, begin, end, eval::default_eval_context.num_threads);
+    }
+
+    inline array parse_lines(const ndt::type &tp, const std::string &str, int nthreads)
+    {
+      return parse_lines(tp, str.data(), str.data() + str.size(), nthreads);
+    }
+
+    inline array parse_lines(const ndt::type &tp, const std::string &str)
+    {
+      return parse_lines(tp, str.data(), str.data() + str.size());
+    }
+
   } // namespace dynd::nd::json
 } // namespace dynd::nd
 
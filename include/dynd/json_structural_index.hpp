@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <vector>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+namespace parse {
+
+  /**
+   * Builds the structural index of UTF-8 encoded JSON. This is the offset of
+   * every '{', '}', '[', ']', ':' and ',' outside of strings, and of the
+   * opening quote of every string, in increasing order.
+   *
+   * The buffer is classified 64 bytes at a time with SSE2 or AVX2, according
+   * to the current simd level, and the strings are found from the quote and
+   * backslash bitmasks without looking at the bytes one by one. The JSON
+   * itself is not validated.
+   */
+  DYND_API void build_json_structural_index(const char *begin, const char *end, std::vector<intptr_t> &out);
+
+  /**
+   * Given ``begin`` pointing at a '{' or '[', returns one past the matching
+   * '}' or ']', using the same 64-byte block scanning as the structural index.
+   * Only the nesting of the brackets outside of strings is checked, not the
+   * rest of the JSON between them.
+   *
+   * Throws a parse_error if the brackets are not closed before ``end``.
+   */
+  DYND_API const char *skip_json_container(const char *begin, const char *end);
+
+  /**
+   * Returns the first '"' or '\\' in ``[begin, end)``, or ``end`` if there
+   * is none, looking at 16 bytes at a time.
+   */
+  DYND_API const char *find_quote_or_backslash(const char *begin, const char *end);
+
+} // namespace dynd::parse
+} // namespace dynd
@@ -32,7 +32,7 @@ namespace nd {
       static void resolve_dst_type(char *static_data, char *DYND_UNUSED(data), ndt::type &dst_tp,
                                    intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                    intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                   const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         dst_tp = reinterpret_cast<static_data_type *>(static_data)->value_tp;
       }
@@ -43,7 +43,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                   const array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, reinterpret_cast<static_data_type *>(static_data)->value_tp,
              reinterpret_cast<static_data_type *>(static_data)->forward);
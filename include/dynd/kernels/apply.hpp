@@ -173,7 +173,7 @@ namespace nd {
                                 const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                      \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds,     \
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                          \
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))                          \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -225,7 +225,7 @@ namespace nd {
                                 const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                      \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds,     \
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                          \
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))                          \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -299,7 +299,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, reinterpret_cast<data_type *>(static_data)->first,                     \
                       dynd::detail::make_value_wrapper(reinterpret_cast<data_type *>(static_data)->second),            \
@@ -311,7 +311,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename T, typename mem_func_type, typename... A, size_t... I, typename... K, size_t... J>                \
@@ -366,7 +366,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, reinterpret_cast<data_type *>(static_data)->first,                     \
                       dynd::detail::make_value_wrapper(reinterpret_cast<data_type *>(static_data)->second),            \
@@ -378,7 +378,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   }
 
     APPLY_MEMBER_FUNCTION_CK();
@@ -393,7 +393,7 @@ namespace nd {
                                                                 kernel_request_t kernreq,
                                                                 const eval::eval_context *ectx, intptr_t nkwd,
                                                                 const nd::array *kwds,
-                                                                const std::map<std::string, ndt::type> &tp_vars)
+                                                                const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -409,7 +409,7 @@ namespace nd {
                                                                 kernel_request_t kernreq,
                                                                 const eval::eval_context *ectx, intptr_t nkwd,
                                                                 const nd::array *kwds,
-                                                                const std::map<std::string, ndt::type> &tp_vars)
+                                                                const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -478,7 +478,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset,                                                                        \
                       dynd::detail::make_value_wrapper(*reinterpret_cast<func_type *>(static_data)),                   \
@@ -490,7 +490,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -543,7 +543,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset,                                                                        \
                       dynd::detail::make_value_wrapper(*reinterpret_cast<func_type *>(static_data)),                   \
@@ -555,7 +555,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,                       \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   }
 
     APPLY_CALLABLE_CK();
@@ -569,7 +569,7 @@ namespace nd {
                                                          const ndt::type *src_tp, const char *const *src_arrmeta,
                                                          kernel_request_t kernreq, const eval::eval_context *ectx,
                                                          intptr_t nkwd, const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -628,7 +628,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
                                                                                                                        \
       self_type::make(ckb, kernreq, ckb_offset, *reinterpret_cast<func_type **>(static_data),                          \
@@ -640,7 +640,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -693,7 +693,7 @@ namespace nd {
                                                     kernel_request_t kernreq,                                          \
                                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd,        \
                                                     const nd::array *kwds,                                             \
-                                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))      \
+                                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))      \
     {                                                                                                                  \
                                                                                                                        \
       self_type::make(ckb, kernreq, ckb_offset, *reinterpret_cast<func_type **>(static_data),                          \
@@ -705,7 +705,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   }
 
     APPLY_CALLABLE_CK();
@@ -719,7 +719,7 @@ namespace nd {
                                                          const ndt::type *src_tp, const char *const *src_arrmeta,
                                                          kernel_request_t kernreq, const eval::eval_context *ectx,
                                                          intptr_t nkwd, const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -734,7 +734,7 @@ namespace nd {
                                                          const ndt::type *src_tp, const char *const *src_arrmeta,
                                                          kernel_request_t kernreq, const eval::eval_context *ectx,
                                                          intptr_t nkwd, const nd::array *kwds,
-                                                         const std::map<std::string, ndt::type> &tp_vars)
+                                                         const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
@@ -801,7 +801,7 @@ namespace nd {
                                     const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),                  \
                                     const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
                                     const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds, \
-                                    const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                      \
+                                    const ndt::typevar_map &DYND_UNUSED(tp_vars))                      \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -811,7 +811,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   };                                                                                                                   \
                                                                                                                        \
   template <typename func_type, typename... A, size_t... I, typename... K, size_t... J>                                \
@@ -861,7 +861,7 @@ namespace nd {
         intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),               \
         intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq, \
         const eval::eval_context *DYND_UNUSED(ectx), intptr_t nkwd, const nd::array *kwds,                             \
-        const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))                                                  \
+        const ndt::typevar_map &DYND_UNUSED(tp_vars))                                                  \
     {                                                                                                                  \
       self_type::make(ckb, kernreq, ckb_offset, args_type(src_tp, src_arrmeta, kwds), kwds_type(nkwd, kwds));          \
       return ckb_offset;                                                                                               \
@@ -871,7 +871,7 @@ namespace nd {
                                 intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,  \
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,     \
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,                  \
-                                const std::map<std::string, ndt::type> &tp_vars);                                      \
+                                const ndt::typevar_map &tp_vars);                                      \
   }
 
     CONSTRUCT_THEN_APPLY_CALLABLE_CK();
@@ -883,7 +883,7 @@ namespace nd {
                                            const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                            const ndt::type *src_tp, const char *const *src_arrmeta,
                                            kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                           const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                           const nd::array *kwds, const ndt::typevar_map &tp_vars)
     {
       return instantiate_without_cuda_launch(static_data, NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
                                              src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
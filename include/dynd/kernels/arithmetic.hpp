@@ -4,6 +4,7 @@
 #include <dynd/func/option.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/kernels/apply.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 
 namespace dynd {
 namespace nd {
@@ -56,6 +57,33 @@ namespace nd {
   DYND_DEF_BINARY_OP_KERNEL(<<, left_shift)
   DYND_DEF_BINARY_OP_KERNEL(>>, right_shift)
 
+  // When both operands have the same type, add, subtract, multiply and divide
+  // use a vectorized loop over contiguous data
+
+#define DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL(NAME)                                                                     \
+  template <type_id_t Src0TypeID>                                                                                      \
+  struct NAME##_kernel<Src0TypeID, Src0TypeID>                                                                         \
+      : detail::contiguous_binary_kernel<                                                                              \
+            NAME##_kernel<Src0TypeID, Src0TypeID>, Src0TypeID,                                                         \
+            typename return_of<decltype(&detail::inline_##NAME<Src0TypeID, Src0TypeID>::f)>::type,                     \
+            detail::simd_##NAME> {                                                                                     \
+    typedef typename type_of<Src0TypeID>::type A0;                                                                     \
+    typedef typename return_of<decltype(&detail::inline_##NAME<Src0TypeID, Src0TypeID>::f)>::type R;                   \
+                                                                                                                       \
+    void single(char *dst, char *const *src)                                                                           \
+    {                                                                                                                  \
+      *reinterpret_cast<R *>(dst) = detail::inline_##NAME<Src0TypeID, Src0TypeID>::f(*reinterpret_cast<A0 *>(src[0]),  \
+                                                                                     *reinterpret_cast<A0 *>(src[1])); \
+    }                                                                                                                  \
+  };
+
+  DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL(add)
+  DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL(subtract)
+  DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL(multiply)
+  DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL(divide)
+
+#undef DYND_DEF_CONTIGUOUS_BINARY_OP_KERNEL
+
   namespace detail {
     template <type_id_t Src0TypeID, type_id_t Src1TypeID>
     struct inline_logical_xor {
@@ -96,7 +124,7 @@ namespace nd {
 
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {src_tp[0].extended<ndt::option_type>()->get_value_type(), src_tp[1]};
@@ -108,7 +136,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
@@ -158,7 +186,7 @@ namespace nd {
 
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {src_tp[0], src_tp[1].extended<ndt::option_type>()->get_value_type()};
@@ -170,7 +198,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
@@ -224,7 +252,7 @@ namespace nd {
 
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       auto k = FuncType::get().get();
       const ndt::type child_src_tp[2] = {src_tp[0].extended<ndt::option_type>()->get_value_type(),
@@ -237,7 +265,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_arith_offset = ckb_offset;
       option_arithmetic_kernel::make(ckb, kernreq, ckb_offset);
@@ -19,6 +19,7 @@
 #include <dynd/kernels/base_virtual_kernel.hpp>
 #include <dynd/kernels/option_assignment_kernels.hpp>
 #include <dynd/kernels/pointer_assignment_kernels.hpp>
+#include <dynd/memblock/objectarray_memory_block.hpp>
 #include <dynd/eval/eval_context.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/types/type_id.hpp>
@@ -32,6 +33,7 @@
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/parser_util.hpp>
+#include <dynd/number_conversion.hpp>
 #include <map>
 
 #if defined(_MSC_VER)
@@ -254,26 +256,18 @@ namespace nd {
   // Assign from a categorical type to some other type
   template <typename UIntType>
   struct categorical_to_other_kernel : base_kernel<categorical_to_other_kernel<UIntType>, 1> {
-    typedef categorical_to_other_kernel extra_type;
-
     ndt::type src_cat_tp;
 
-    void single(char *dst, char *const *src)
-    {
-      ckernel_prefix *echild = this->get_child();
-      expr_single_t opchild = echild->get_function<expr_single_t>();
+    categorical_to_other_kernel(const ndt::type &src_cat_tp) : src_cat_tp(src_cat_tp) {}
 
-      uint32_t value = *reinterpret_cast<const UIntType *>(src[0]);
-      char *src_val = const_cast<char *>(
-          reinterpret_cast<const ndt::categorical_type *>(src_cat_tp.extended())->get_category_data_from_value(value));
-      opchild(echild, dst, &src_val);
-    }
+    ~categorical_to_other_kernel() { this->get_child()->destroy(); }
 
-    static void destruct(ckernel_prefix *self)
+    void single(char *dst, char *const *src)
     {
-      extra_type *e = reinterpret_cast<extra_type *>(self);
-      e->src_cat_tp.~type();
-      self->get_child(sizeof(extra_type))->destroy();
+      uint32_t value = *reinterpret_cast<const UIntType *>(src[0]);
+      char *src_val =
+          const_cast<char *>(src_cat_tp.extended<ndt::categorical_type>()->get_category_data_from_value(value));
+      this->get_child()->single(dst, &src_val);
     }
   };
 
@@ -290,7 +284,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         switch (ectx->errmode) {
         case assign_error_nocheck:
@@ -1638,6 +1632,49 @@ namespace nd {
       }
     };
 
+    /**
+     * Copies a string. With the ``use_string_arena`` option, data which
+     * doesn't fit inline is allocated from the arena of the var dimension
+     * being assigned, if there is one.
+     */
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<string_type_id, string_kind, string_type_id, string_kind, ErrorMode>
+        : base_kernel<assignment_kernel<string_type_id, string_kind, string_type_id, string_kind, ErrorMode>, 1> {
+      bool m_use_arena;
+
+      assignment_kernel(bool use_arena) : m_use_arena(use_arena) {}
+
+      void single(char *dst, char *const *src)
+      {
+        bytes *dst_d = reinterpret_cast<bytes *>(dst);
+        const bytes *src_d = reinterpret_cast<const bytes *>(src[0]);
+        memory_block_data *arena = m_use_arena ? get_string_arena() : NULL;
+        if (arena == NULL) {
+          dst_d->assign(src_d->data(), src_d->size());
+        }
+        else {
+          dst_d->assign(src_d->data(), src_d->size(), arena);
+        }
+      }
+
+      static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                  intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
+                                  const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
+                                  const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
+                                  kernel_request_t kernreq, const eval::eval_context *ectx,
+                                  intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
+      {
+        assignment_kernel::make(ckb, kernreq, ckb_offset, static_cast<bool>(ectx->use_string_arena));
+        return ckb_offset;
+      }
+    };
+
+    template <assign_error_mode ErrorMode>
+    struct assignment_kernel<bytes_type_id, bytes_kind, bytes_type_id, bytes_kind, ErrorMode>
+        : assignment_kernel<string_type_id, string_kind, string_type_id, string_kind, ErrorMode> {
+    };
+
     template <assign_error_mode ErrorMode>
     struct assignment_kernel<date_type_id, datetime_kind, string_type_id, string_kind, ErrorMode>
         : base_kernel<assignment_kernel<date_type_id, datetime_kind, string_type_id, string_kind, ErrorMode>, 1> {
@@ -1676,7 +1713,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], src_arrmeta[0], ectx->errmode,
                                 ectx->date_parse_order, ectx->century_window);
@@ -1714,7 +1751,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, ectx);
         return ckb_offset;
@@ -1759,7 +1796,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, src_tp[0], src_arrmeta[0], ectx->date_parse_order,
                                 ectx->century_window);
@@ -1802,7 +1839,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], ectx);
         return ckb_offset;
@@ -1844,7 +1881,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], src_arrmeta[0], ectx->errmode);
         return ckb_offset;
@@ -1881,7 +1918,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_kernel::make(ckb, kernreq, ckb_offset, dst_tp, dst_arrmeta, ectx);
         return ckb_offset;
@@ -1990,7 +2027,7 @@ namespace nd {
                                   intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         intptr_t root_ckb_offset = ckb_offset;
         typedef assignment_kernel self_type;
@@ -2079,7 +2116,7 @@ namespace nd {
                                   intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         // Deal with some float32 to option[T] conversions where any NaN is
         // interpreted
@@ -2097,7 +2134,7 @@ namespace nd {
                                   intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         // Deal with some string to option[T] conversions where string values
         // might mean NA
@@ -2218,7 +2255,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t root_ckb_offset = ckb_offset;
       typedef dynd::nd::option_to_value_ck self_type;
@@ -2691,7 +2728,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_pod_typed_data_assignment_kernel(ckb, ckb_offset, dst_tp->get_data_size(),
                                                      dst_tp->get_data_alignment(), kernreq);
@@ -2708,7 +2745,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         const ndt::fixed_bytes_type *src_fs = src_tp[0].extended<ndt::fixed_bytes_type>();
         if (dst_tp.get_data_size() != src_fs->get_data_size()) {
@@ -2720,6 +2757,110 @@ namespace nd {
       }
     };
 
+    /**
+     * Assigns between categorical types. The codes of identical types are
+     * copied, and otherwise each code is looked up in the source categories,
+     * and its category looked up in the destination ones, which throws if it
+     * is not there.
+     */
+    template <>
+    struct assignment_virtual_kernel<categorical_type_id, custom_kind, categorical_type_id, custom_kind>
+        : base_virtual_kernel<
+              assignment_virtual_kernel<categorical_type_id, custom_kind, categorical_type_id, custom_kind>> {
+      template <typename UIntType>
+      static void make_to_categorical(void *ckb, intptr_t &ckb_offset, const ndt::type &dst_tp,
+                                      const char *category_arrmeta)
+      {
+        category_to_categorical_kernel_extra<UIntType> *e =
+            category_to_categorical_kernel_extra<UIntType>::make(ckb, kernel_request_single, ckb_offset);
+        e->dst_cat_tp = dst_tp;
+        e->src_arrmeta = category_arrmeta;
+      }
+
+      static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                  intptr_t ckb_offset, const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
+                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                                  const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+                                  const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
+                                  const nd::array *DYND_UNUSED(kwds),
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
+      {
+        if (dst_tp == src_tp[0]) {
+          return make_pod_typed_data_assignment_kernel(ckb, ckb_offset, dst_tp.get_data_size(),
+                                                       dst_tp.get_data_alignment(), kernreq);
+        }
+
+        const ndt::categorical_type *dst_cat_tp = dst_tp.extended<ndt::categorical_type>();
+        const ndt::categorical_type *src_cat_tp = src_tp[0].extended<ndt::categorical_type>();
+        if (dst_cat_tp->get_category_type() != src_cat_tp->get_category_type()) {
+          std::stringstream ss;
+          ss << "Cannot assign from " << src_tp[0] << " to " << dst_tp << ", their categories have different types";
+          throw type_error(ss.str());
+        }
+
+        switch (src_cat_tp->get_storage_type().get_type_id()) {
+        case uint8_type_id:
+          categorical_to_other_kernel<uint8_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        case uint16_type_id:
+          categorical_to_other_kernel<uint16_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        case uint32_type_id:
+          categorical_to_other_kernel<uint32_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        default:
+          throw std::runtime_error("internal error in categorical assignment kernel");
+        }
+        switch (dst_cat_tp->get_storage_type().get_type_id()) {
+        case uint8_type_id:
+          make_to_categorical<uint8_t>(ckb, ckb_offset, dst_tp, src_cat_tp->get_category_arrmeta());
+          break;
+        case uint16_type_id:
+          make_to_categorical<uint16_t>(ckb, ckb_offset, dst_tp, src_cat_tp->get_category_arrmeta());
+          break;
+        case uint32_type_id:
+          make_to_categorical<uint32_t>(ckb, ckb_offset, dst_tp, src_cat_tp->get_category_arrmeta());
+          break;
+        default:
+          throw std::runtime_error("internal error in categorical assignment kernel");
+        }
+        return ckb_offset;
+      }
+    };
+
+    /**
+     * Assigns from a categorical type by looking up the category of each code
+     * and assigning it with a child kernel.
+     */
+    template <type_id_t DstTypeID, type_kind_t DstTypeKind>
+    struct assignment_virtual_kernel<DstTypeID, DstTypeKind, categorical_type_id, custom_kind>
+        : base_virtual_kernel<assignment_virtual_kernel<DstTypeID, DstTypeKind, categorical_type_id, custom_kind>> {
+      static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                  intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+                                  const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+                                  const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
+                                  const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+      {
+        const ndt::categorical_type *src_cat_tp = src_tp[0].extended<ndt::categorical_type>();
+        switch (src_cat_tp->get_storage_type().get_type_id()) {
+        case uint8_type_id:
+          categorical_to_other_kernel<uint8_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        case uint16_type_id:
+          categorical_to_other_kernel<uint16_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        case uint32_type_id:
+          categorical_to_other_kernel<uint32_t>::make(ckb, kernreq, ckb_offset, src_tp[0]);
+          break;
+        default:
+          throw std::runtime_error("internal error in categorical assignment kernel");
+        }
+        return make_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_cat_tp->get_category_type(),
+                                      src_cat_tp->get_category_arrmeta(), kernel_request_single, ectx);
+      }
+    };
+
     template <type_id_t Src0TypeID>
     struct assignment_virtual_kernel<string_type_id, string_kind, Src0TypeID, sint_kind>
         : base_kernel<assignment_virtual_kernel<string_type_id, string_kind, Src0TypeID, sint_kind>, 1> {
@@ -2736,11 +2877,16 @@ namespace nd {
 
       void single(char *dst, char *const *src)
       {
+        // Integers and floats are formatted without any allocation, with
+        // floats in the shortest form that parses back to the same value
+        char buffer[number_format_max_size];
+        char *buffer_end = format_builtin_number(buffer, src_type_id, src[0]);
+        if (buffer_end != NULL) {
+          dst_string_tp->set_from_utf8_string(dst_arrmeta, dst, buffer, buffer_end, &ectx);
+          return;
+        }
+
         // TODO: There are much faster ways to do this, but it's very generic!
-        //       Also, for floating point values, a printing scheme like
-        //       Python's, where it prints the shortest string that's
-        //       guaranteed to parse to the same float number, would be
-        //       better.
         std::stringstream ss;
         ndt::type(src_type_id).print_data(ss, NULL, src[0]);
         dst_string_tp->set_from_utf8_string(dst_arrmeta, dst, ss.str(), &ectx);
@@ -2752,7 +2898,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_virtual_kernel::make(ckb, kernreq, ckb_offset, dst_tp, src_tp[0].get_type_id(), *ectx, dst_arrmeta);
         return ckb_offset;
@@ -2772,7 +2918,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         if (dst_tp.extended() == src_tp[0].extended()) {
           return make_tuple_identical_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_arrmeta[0], kernreq,
@@ -2801,7 +2947,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         if (dst_tp.extended() == src_tp[0].extended()) {
           return make_tuple_identical_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_arrmeta[0], kernreq,
@@ -2896,7 +3042,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_virtual_kernel::make(
             ckb, kernreq, ckb_offset, dst_tp.extended<ndt::base_string_type>()->get_encoding(),
@@ -2917,7 +3063,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -2932,7 +3078,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -2947,7 +3093,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -2962,7 +3108,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -2977,7 +3123,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -2992,7 +3138,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_expression_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                  kernreq, ectx);
@@ -3026,7 +3172,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3082,7 +3228,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_virtual_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3136,7 +3282,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3192,7 +3338,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_virtual_kernel::make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3244,7 +3390,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3311,7 +3457,7 @@ namespace nd {
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3332,6 +3478,12 @@ namespace nd {
 
       void single(char *dst, char *const *src)
       {
+        if (src_string_tp.get_type_id() == string_type_id) {
+          // A UTF-8 string can be parsed in place
+          parse_float64_strided(dst, 0, src[0], 0, 1, errmode);
+          return;
+        }
+
         // Get the string from the source
         std::string s = reinterpret_cast<const ndt::base_string_type *>(src_string_tp.extended())
                             ->get_utf8_string(src_arrmeta, src[0], errmode);
@@ -3340,13 +3492,27 @@ namespace nd {
         *reinterpret_cast<double *>(dst) = value;
       }
 
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        if (src_string_tp.get_type_id() == string_type_id) {
+          parse_float64_strided(dst, dst_stride, src[0], src_stride[0], count, errmode);
+          return;
+        }
+
+        char *src0 = src[0];
+        intptr_t src0_stride = src_stride[0];
+        for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+          single(dst, &src0);
+        }
+      }
+
       static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
                                   intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
                                   const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         make(ckb, kernreq, ckb_offset, src_tp[0], ectx->errmode, src_arrmeta[0]);
         return ckb_offset;
@@ -3441,7 +3607,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         const ndt::fixed_string_type *src_fs = src_tp[0].extended<ndt::fixed_string_type>();
         assignment_virtual_kernel::make(
@@ -3468,7 +3634,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *DYND_UNUSED(src_tp), const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                  const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                  const nd::array *kwds, const ndt::typevar_map &tp_vars)
       {
         const callable &inverse = dst_tp.extended<ndt::adapt_type>()->get_inverse();
         const ndt::type &value_tp = dst_tp.value_type();
@@ -3501,7 +3667,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const ndt::type &storage_tp = src_tp[0].storage_type();
         if (storage_tp.is_expression()) {
@@ -3580,7 +3746,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         const ndt::base_string_type *src_fs = src_tp[0].extended<ndt::base_string_type>();
         assignment_virtual_kernel::make(ckb, kernreq, ckb_offset,
@@ -3601,7 +3767,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         const ndt::base_string_type *src_fs = src_tp[0].extended<ndt::base_string_type>();
         assignment_virtual_kernel<fixed_string_type_id, string_kind, string_type_id, string_kind>::make(
@@ -3626,7 +3792,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         assignment_virtual_kernel<string_type_id, string_kind, fixed_string_type_id, string_kind>::make(
             ckb, kernreq, ckb_offset, dst_tp.extended<ndt::base_string_type>()->get_encoding(),
@@ -3647,7 +3813,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return make_pod_typed_data_assignment_kernel(ckb, ckb_offset, dst_tp.get_data_size(),
                                                      dst_tp.get_data_alignment(), kernreq);
@@ -3660,7 +3826,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         return kernels::make_option_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, src_tp[0], src_arrmeta[0],
                                                       kernreq, ectx);
@@ -3675,7 +3841,7 @@ namespace nd {
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         if (dst_tp == src_tp[0]) {
           return make_pod_typed_data_assignment_kernel(ckb, ckb_offset, dst_tp.get_data_size(),
@@ -3702,7 +3868,7 @@ namespace nd {
                                   const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         if (src_tp[0].extended<ndt::datetime_type>()->get_timezone() == tz_abstract) {
           // TODO: If the destination timezone is not UTC, do an
@@ -3761,7 +3927,7 @@ namespace nd {
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                 const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       string_to_type_kernel *e = make(ckb, kernreq, ckb_offset);
       // The kernel data owns a reference to this type
@@ -3789,7 +3955,7 @@ namespace nd {
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                 const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       // Type to string
       nd::type_to_string_kernel *e = nd::type_to_string_kernel::make(ckb, kernreq, ckb_offset);
@@ -7,6 +7,7 @@
 
 #include <typeinfo>
 
+#include <dynd/jit.hpp>
 #include <dynd/kernels/ckernel_builder.hpp>
 #include <dynd/types/callable_type.hpp>
 
@@ -99,7 +100,7 @@ namespace nd {
 
     static char *data_init(char *DYND_UNUSED(static_data), const ndt::type &DYND_UNUSED(dst_tp),
                            intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
-                           const array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                           const array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       return NULL;
     }
@@ -110,7 +111,7 @@ namespace nd {
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                 const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       SelfType::make(ckb, kernreq, ckb_offset);
       return ckb_offset;
@@ -164,6 +165,9 @@ namespace nd {
     static SelfType *init(ckernel_prefix *rawself, kernel_request_t kernreq, A &&... args)                             \
     {                                                                                                                  \
       SelfType *self = parent_type::init(rawself, kernreq, std::forward<A>(args)...);                                  \
+      jit::detail::register_ir<base_kernel>(                                                                           \
+          reinterpret_cast<void *>(static_cast<void (*)(ckernel_prefix *, char *, char *const *)>(single_wrapper)),    \
+          reinterpret_cast<void *>(strided_wrapper));                                                                  \
       switch (kernreq) {                                                                                               \
       case kernel_request_single:                                                                                      \
         self->function =                                                                                               \
@@ -212,8 +216,8 @@ namespace nd {
       reinterpret_cast<type *>(self)->single(dst, src);                                                                \
     }                                                                                                                  \
                                                                                                                        \
-    __VA_ARGS__ static void strided_wrapper(ckernel_prefix *self, char *dst, intptr_t dst_stride, char *const *src,    \
-                                            const intptr_t *src_stride, size_t count)                                  \
+    __VA_ARGS__ static void DYND_EMIT_LLVM(strided_wrapper)(ckernel_prefix * self, char *dst, intptr_t dst_stride,    \
+                                                           char *const *src, const intptr_t *src_stride, size_t count) \
     {                                                                                                                  \
       SelfType::get_self(self)->strided(dst, dst_stride, src, src_stride, count);                                      \
     }                                                                                                                  \
@@ -27,7 +27,7 @@ namespace nd {
 
     static char *data_init(char *DYND_UNUSED(static_data), const ndt::type &DYND_UNUSED(dst_tp),
                            intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
-                           const array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                           const array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       return reinterpret_cast<char *>(new ndt::type(kwds[0].as<ndt::type>()));
     }
@@ -37,7 +37,7 @@ namespace nd {
                                 const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                 kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
                                 intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       self_type::make(ckb, kernreq, ckb_offset, *reinterpret_cast<ndt::type *>(data), dst_tp, dst_arrmeta);
       delete reinterpret_cast<ndt::type *>(data);
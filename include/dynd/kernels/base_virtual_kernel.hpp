@@ -35,7 +35,7 @@ namespace nd {
 
     static char *data_init(char *DYND_UNUSED(static_data), const ndt::type &DYND_UNUSED(dst_tp),
                            intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
-                           const array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                           const array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       return NULL;
     }
@@ -43,7 +43,7 @@ namespace nd {
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       dst_tp = ndt::substitute(dst_tp, tp_vars, true);
     }
@@ -59,7 +59,7 @@ namespace nd {
                                 const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
-                                const nd::array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &tp_vars)
     {
       make(ckb, kernreq, ckb_offset, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
            reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride);
@@ -63,7 +63,7 @@ namespace nd {
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                 const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       make(ckb, kernreq, ckb_offset, src_tp[0].get_data_size());
       return ckb_offset;
@@ -104,7 +104,7 @@ namespace nd {
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                 const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       make(ckb, kernreq, ckb_offset, src_tp[0].get_data_size());
       return ckb_offset;
@@ -408,7 +408,7 @@ inline intptr_t ckernel_prefix::instantiate(char *static_data, char *DYND_UNUSED
                                             const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                             const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                                             const nd::array *DYND_UNUSED(kwds),
-                                            const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                            const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   void *func;
   switch (kernreq) {
@@ -14,6 +14,9 @@
 #include <dynd/typed_data_assign.hpp>
 
 namespace dynd {
+namespace ndt {
+  class typevar_map;
+} // namespace dynd::ndt
 
 struct ckernel_prefix;
 
@@ -142,7 +145,7 @@ struct DYND_API ckernel_prefix {
   static char *data_init(char *DYND_UNUSED(static_data), const ndt::type &DYND_UNUSED(dst_tp),
                          intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp), intptr_t DYND_UNUSED(nkwd),
                          const nd::array *DYND_UNUSED(kwds),
-                         const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                         const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     return NULL;
   }
@@ -153,7 +156,7 @@ struct DYND_API ckernel_prefix {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwds),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars));
 };
 
 } // namespace dynd
@@ -8,6 +8,7 @@
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/total_order_kernel.hpp>
 #include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 #include <dynd/kernels/tuple_comparison_kernels.hpp>
 #include <dynd/typed_data_assign.hpp>
 #include <dynd/func/option.hpp>
@@ -25,6 +26,18 @@ namespace nd {
     static const std::size_t data_size = 0;
   };
 
+  /**
+   * The base of comparisons between operands of the same type, which use a
+   * vectorized loop over contiguous data.
+   */
+  template <typename K, detail::simd_binary_op_t Op>
+  struct contiguous_comparison_kernel;
+
+  template <template <type_id_t, type_id_t> class K, type_id_t I0, detail::simd_binary_op_t Op>
+  struct contiguous_comparison_kernel<K<I0, I0>, Op> : detail::contiguous_binary_kernel<K<I0, I0>, I0, bool1, Op> {
+    static const std::size_t data_size = 0;
+  };
+
   template <type_id_t I0, type_id_t I1>
   struct less_kernel : base_comparison_kernel<less_kernel<I0, I1>> {
     typedef typename type_of<I0>::type A0;
@@ -39,7 +52,7 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct less_kernel<I0, I0> : base_comparison_kernel<less_kernel<I0, I0>> {
+  struct less_kernel<I0, I0> : contiguous_comparison_kernel<less_kernel<I0, I0>, detail::simd_less> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -62,7 +75,7 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct less_equal_kernel<I0, I0> : base_comparison_kernel<less_equal_kernel<I0, I0>> {
+  struct less_equal_kernel<I0, I0> : contiguous_comparison_kernel<less_equal_kernel<I0, I0>, detail::simd_less_equal> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -85,7 +98,7 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct equal_kernel<I0, I0> : base_comparison_kernel<equal_kernel<I0, I0>> {
+  struct equal_kernel<I0, I0> : contiguous_comparison_kernel<equal_kernel<I0, I0>, detail::simd_equal> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -145,7 +158,21 @@ namespace nd {
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t DYND_UNUSED(kernreq), const eval::eval_context *ectx,
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars));
+  };
+
+  /**
+   * Compares categorical values of the same type by their codes, which are
+   * equal exactly when the categories are.
+   */
+  template <>
+  struct equal_kernel<categorical_type_id, categorical_type_id>
+      : base_virtual_kernel<equal_kernel<categorical_type_id, categorical_type_id>> {
+    static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
+                                const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                                const char *const *src_arrmeta, kernel_request_t kernreq,
+                                const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+                                const ndt::typevar_map &tp_vars);
   };
 
   template <type_id_t I0, type_id_t I1>
@@ -162,7 +189,7 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct not_equal_kernel<I0, I0> : base_comparison_kernel<not_equal_kernel<I0, I0>> {
+  struct not_equal_kernel<I0, I0> : contiguous_comparison_kernel<not_equal_kernel<I0, I0>, detail::simd_not_equal> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -222,7 +249,21 @@ namespace nd {
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t DYND_UNUSED(kernreq), const eval::eval_context *ectx,
                                 intptr_t DYND_UNUSED(nkwd), const nd::array *DYND_UNUSED(kwds),
-                                const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars));
+                                const ndt::typevar_map &DYND_UNUSED(tp_vars));
+  };
+
+  /**
+   * Compares categorical values of the same type by their codes, which are
+   * equal exactly when the categories are.
+   */
+  template <>
+  struct not_equal_kernel<categorical_type_id, categorical_type_id>
+      : base_virtual_kernel<not_equal_kernel<categorical_type_id, categorical_type_id>> {
+    static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
+                                const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                                const char *const *src_arrmeta, kernel_request_t kernreq,
+                                const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+                                const ndt::typevar_map &tp_vars);
   };
 
   template <type_id_t I0, type_id_t I1>
@@ -239,7 +280,8 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct greater_equal_kernel<I0, I0> : base_comparison_kernel<greater_equal_kernel<I0, I0>> {
+  struct greater_equal_kernel<I0, I0>
+      : contiguous_comparison_kernel<greater_equal_kernel<I0, I0>, detail::simd_greater_equal> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -262,7 +304,7 @@ namespace nd {
   };
 
   template <type_id_t I0>
-  struct greater_kernel<I0, I0> : base_comparison_kernel<greater_kernel<I0, I0>> {
+  struct greater_kernel<I0, I0> : contiguous_comparison_kernel<greater_kernel<I0, I0>, detail::simd_greater> {
     typedef typename type_of<I0>::type A0;
 
     void single(char *dst, char *const *src)
@@ -297,7 +339,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
@@ -348,7 +390,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
@@ -403,7 +445,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t option_comp_offset = ckb_offset;
       option_comparison_kernel::make(ckb, kernreq, ckb_offset);
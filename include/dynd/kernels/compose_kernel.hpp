@@ -101,7 +101,7 @@ namespace nd {
       static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                    intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                    intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &tp_vars)
+                                   const ndt::typevar_map &tp_vars)
       {
         dst_tp = ndt::substitute(dst_tp, tp_vars, true);
       }
@@ -116,7 +116,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const struct static_data *static_data_x = reinterpret_cast<struct static_data *>(static_data);
 
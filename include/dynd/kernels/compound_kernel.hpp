@@ -39,7 +39,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         make(ckb, kernreq, ckb_offset);
@@ -78,7 +78,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         make(ckb, kernreq, ckb_offset);
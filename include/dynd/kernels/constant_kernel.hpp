@@ -45,7 +45,7 @@ namespace nd {
                                   const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         const array &val = *reinterpret_cast<array *>(static_data);
 
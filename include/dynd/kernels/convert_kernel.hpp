@@ -41,12 +41,13 @@ namespace nd {
       char *m_arrmeta;
       ndt::type m_type;
       intptr_t m_stride;
+      intptr_t m_size;
 
       void internal_allocate()
       {
         if (m_type.get_type_id() != uninitialized_type_id) {
           m_stride = m_type.get_data_size();
-          m_storage = new char[DYND_BUFFER_CHUNK_SIZE * m_stride];
+          m_storage = new char[m_size * m_stride];
           m_arrmeta = NULL;
           size_t metasize = m_type.is_builtin() ? 0 : m_type.extended()->get_arrmeta_size();
           if (metasize != 0) {
@@ -64,19 +65,24 @@ namespace nd {
       }
 
     public:
-      buffer_storage() : m_storage(NULL), m_arrmeta(NULL), m_type() {}
+      buffer_storage() : m_storage(NULL), m_arrmeta(NULL), m_type(), m_size(DYND_BUFFER_CHUNK_SIZE) {}
 
-      buffer_storage(const buffer_storage &rhs) : m_storage(NULL), m_arrmeta(NULL), m_type(rhs.m_type)
+      buffer_storage(const buffer_storage &rhs)
+          : m_storage(NULL), m_arrmeta(NULL), m_type(rhs.m_type), m_size(rhs.m_size)
       {
         internal_allocate();
       }
 
-      buffer_storage(const ndt::type &tp) : m_storage(NULL), m_arrmeta(NULL), m_type(tp) { internal_allocate(); }
+      buffer_storage(const ndt::type &tp, intptr_t size = DYND_BUFFER_CHUNK_SIZE)
+          : m_storage(NULL), m_arrmeta(NULL), m_type(tp), m_size(size)
+      {
+        internal_allocate();
+      }
 
       ~buffer_storage()
       {
         if (m_storage && m_type.get_flags() & type_flag_destructor) {
-          m_type.extended()->data_destruct_strided(m_arrmeta, m_storage, m_stride, DYND_BUFFER_CHUNK_SIZE);
+          m_type.extended()->data_destruct_strided(m_arrmeta, m_storage, m_stride, m_size);
         }
         delete[] m_storage;
         if (m_arrmeta) {
@@ -88,11 +94,12 @@ namespace nd {
       // Assignment copies the same type
       buffer_storage &operator=(const buffer_storage &rhs)
       {
-        allocate(rhs.m_type);
+        allocate(rhs.m_type, rhs.m_size);
         return *this;
       }
 
-      void allocate(const ndt::type &tp)
+      /** Allocates a buffer of ``size`` elements of type ``tp`` */
+      void allocate(const ndt::type &tp, intptr_t size = DYND_BUFFER_CHUNK_SIZE)
       {
         delete[] m_storage;
         m_storage = 0;
@@ -102,6 +109,7 @@ namespace nd {
           m_arrmeta = NULL;
         }
         m_type = tp;
+        m_size = size;
         internal_allocate();
       }
 
@@ -109,6 +117,8 @@ namespace nd {
 
       intptr_t get_stride() const { return m_stride; }
 
+      intptr_t get_size() const { return m_size; }
+
       const ndt::type &get_type() const { return m_type; }
 
       char *const &get_storage() const { return m_storage; }
@@ -202,7 +212,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         callable &af = *reinterpret_cast<callable *>(static_data);
         const ndt::type *src_tp_for_af = af.get_type()->get_pos_types_raw();
@@ -0,0 +1,177 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/func/callable.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * Which types a dispatch_kernel looks up its child by.
+     */
+    enum dispatch_key_t {
+      // The type ids of the first N arguments
+      dispatch_src,
+      // The type id of the dtype of the destination, which must be N = 1
+      dispatch_dst_dtype
+    };
+
+    /**
+     * A dense table of children, indexed by N type ids. The type ids which
+     * occur in the keys are remapped to a compact range of slots, so the table
+     * has one entry per combination of them, a few hundred for the built-in
+     * types, and is allocated once on the heap. Finding a child is a lookup of
+     * each slot and one array index, with no search and no reference count
+     * change, so dispatching costs nothing next to instantiating the child.
+     *
+     * The table holds the base_callable of each child, and the callables are
+     * kept alive in ``m_children``.
+     */
+    template <size_t N>
+    class dispatch_table {
+      static_assert(DYND_TYPE_ID_MAX < INT8_MAX, "the slot of every type id must fit in an int8_t");
+
+      std::vector<callable> m_children;
+      // The slot of each type id, or -1 if no key has it
+      std::array<int8_t, DYND_TYPE_ID_MAX + 1> m_slots;
+      intptr_t m_nslot;
+      std::vector<base_callable *> m_table;
+
+    public:
+      dispatch_table(const std::map<std::array<type_id_t, N>, callable> &children) : m_nslot(0)
+      {
+        m_slots.fill(-1);
+        for (const auto &pair : children) {
+          for (type_id_t id : pair.first) {
+            if (static_cast<uint32_t>(id) > DYND_TYPE_ID_MAX) {
+              throw std::invalid_argument("cannot add a child with a dynamic type id to a dispatch table");
+            }
+            if (m_slots[id] < 0) {
+              if (m_nslot == INT8_MAX) {
+                throw std::overflow_error("too many type ids for the slots of a dispatch table");
+              }
+              m_slots[id] = static_cast<int8_t>(m_nslot++);
+            }
+          }
+        }
+
+        intptr_t size = 1;
+        for (size_t i = 0; i < N; ++i) {
+          size *= m_nslot;
+        }
+        m_table.resize(size, NULL);
+        for (const auto &pair : children) {
+          if (!pair.second.is_null()) {
+            m_children.push_back(pair.second);
+          }
+          m_table[index(pair.first)] = const_cast<base_callable *>(pair.second.get());
+        }
+      }
+
+      /** The index of a key, or -1 if no child has one of its type ids */
+      intptr_t index(const std::array<type_id_t, N> &key) const
+      {
+        intptr_t i = 0;
+        for (type_id_t id : key) {
+          if (static_cast<uint32_t>(id) > DYND_TYPE_ID_MAX || m_slots[id] < 0) {
+            return -1;
+          }
+          i = i * m_nslot + m_slots[id];
+        }
+
+        return i;
+      }
+
+      base_callable *find(const std::array<type_id_t, N> &key) const
+      {
+        intptr_t i = index(key);
+        return (i < 0) ? NULL : m_table[i];
+      }
+    };
+
+    /**
+     * A callable which instantiates one of its children, chosen by the type
+     * ids of its arguments through a dispatch_table. It is the dense
+     * counterpart of multidispatch_kernel, for a fixed set of children keyed
+     * by built-in type ids. When there is no child, ``on_null`` is called with
+     * the types, and must throw.
+     */
+    template <size_t N, dispatch_key_t Key, typename OnNullType>
+    struct dispatch_kernel : base_virtual_kernel<dispatch_kernel<N, Key, OnNullType>> {
+      static_assert(Key == dispatch_src || N == 1, "dispatching on the destination uses one type id");
+
+      struct static_data_type {
+        dispatch_table<N> table;
+        OnNullType on_null;
+
+        static_data_type(const std::map<std::array<type_id_t, N>, callable> &children, const OnNullType &on_null)
+            : table(children), on_null(on_null)
+        {
+        }
+
+        base_callable *get(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) const
+        {
+          std::array<type_id_t, N> key;
+          if (Key == dispatch_dst_dtype) {
+            key[0] = dst_tp.get_dtype().get_type_id();
+          }
+          else {
+            if (nsrc < static_cast<intptr_t>(N)) {
+              throw std::invalid_argument("too few arguments to dispatch on");
+            }
+            for (size_t i = 0; i < N; ++i) {
+              key[i] = src_tp[i].get_type_id();
+            }
+          }
+
+          base_callable *child = table.find(key);
+          if (child == NULL) {
+            on_null(dst_tp, nsrc, src_tp);
+            throw std::runtime_error("no child found");
+          }
+
+          return child;
+        }
+      };
+
+      static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
+                                   const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
+                                   const ndt::typevar_map &tp_vars)
+      {
+        base_callable *child = reinterpret_cast<static_data_type *>(static_data)->get(dst_tp, nsrc, src_tp);
+        const ndt::type &child_dst_tp = child->tp.extended<ndt::callable_type>()->get_return_type();
+        if (child_dst_tp.is_symbolic()) {
+          child->resolve_dst_type(child->static_data(), data, dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+        }
+        else {
+          dst_tp = child_dst_tp;
+        }
+      }
+
+      static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset,
+                                  const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                  const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                  const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
+                                  const ndt::typevar_map &tp_vars)
+      {
+        base_callable *child = reinterpret_cast<static_data_type *>(static_data)->get(dst_tp, nsrc, src_tp);
+        return child->instantiate(child->static_data(), data, ckb, ckb_offset, dst_tp, dst_arrmeta, nsrc, src_tp,
+                                  src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -7,11 +7,13 @@
 
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/memblock/objectarray_memory_block.hpp>
 #include <dynd/types/ellipsis_dim_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/dim_fragment_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/eval/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -26,6 +28,154 @@ namespace nd {
     template <type_id_t DstTypeID, type_id_t SrcTypeID, int N>
     struct elwise_ck;
 
+    /**
+     * Runs the outermost strided dimension of an elwise ckernel on several
+     * threads. The dimension is split into chunks that are scheduled on the
+     * thread pool, and each worker runs its own copy of the child ckernel, so
+     * a child with state is never shared between threads. The copies follow
+     * this ckernel one after another, each ``m_child_stride`` bytes long.
+     */
+    template <int N>
+    struct parallel_elwise_ck : base_kernel<parallel_elwise_ck<N>, N> {
+      intptr_t m_size;
+      intptr_t m_dst_stride, m_src_stride[N];
+      intptr_t m_grain;
+      eval::thread_pool *m_pool;
+      // The number of child copies instantiated so far
+      int m_num_workers;
+      intptr_t m_child_stride;
+
+      parallel_elwise_ck(intptr_t size, intptr_t dst_stride, const intptr_t *src_stride, intptr_t grain,
+                         eval::thread_pool *pool)
+          : m_size(size), m_dst_stride(dst_stride), m_grain(grain), m_pool(pool), m_num_workers(0), m_child_stride(0)
+      {
+        memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
+      }
+
+      ~parallel_elwise_ck()
+      {
+        for (int i = 0; i < m_num_workers; ++i) {
+          get_worker_child(i)->destroy();
+        }
+      }
+
+      ckernel_prefix *get_worker_child(int worker)
+      {
+        return this->get_child(sizeof(parallel_elwise_ck) + worker * m_child_stride);
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        m_pool->parallel_for(m_num_workers, m_size, m_grain, [&](int worker, intptr_t begin, intptr_t end) {
+          ckernel_prefix *child = get_worker_child(worker);
+          expr_strided_t opchild = child->get_function<expr_strided_t>();
+
+          char *child_src[N];
+          for (int j = 0; j != N; ++j) {
+            child_src[j] = src[j] + begin * m_src_stride[j];
+          }
+          opchild(child, dst + begin * m_dst_stride, m_dst_stride, child_src, m_src_stride, end - begin);
+        });
+      }
+
+      /**
+       * Returns the number of iterations of the outer dimension each chunk
+       * should have, so that it covers at least ``min_grain_size`` elements.
+       */
+      static intptr_t get_grain(intptr_t min_grain_size, ndt::type child_dst_tp, const char *child_dst_arrmeta,
+                                intptr_t child_dst_ndim)
+      {
+        intptr_t inner_size = 1;
+        for (intptr_t i = 0; i < child_dst_ndim; ++i) {
+          intptr_t dim_size, stride;
+          ndt::type el_tp;
+          const char *el_arrmeta;
+          if (!child_dst_tp.get_as_strided(child_dst_arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
+            break;
+          }
+          inner_size *= std::max<intptr_t>(dim_size, 1);
+          child_dst_tp = el_tp;
+          child_dst_arrmeta = el_arrmeta;
+        }
+
+        return std::max<intptr_t>((min_grain_size + inner_size - 1) / inner_size, 1);
+      }
+    };
+
+    /**
+     * Merges the strided dimensions below an outer strided dimension into it,
+     * for as long as every operand steps through them with strides that make
+     * them equivalent to one longer loop. For example, a C-contiguous
+     * 1000 * 4 * float32 becomes a single loop of 4000 elements.
+     *
+     * On input, ``size`` and the strides describe the outer dimension, the
+     * child types and arrmeta are the ones below it, and ``dst_ndim`` and
+     * ``src_ndim`` are the number of dimensions still to be lifted below it.
+     * On output, they have been advanced past every merged dimension.
+     */
+    template <int N>
+    void coalesce_strided_dims(intptr_t &size, intptr_t &dst_stride, ndt::type &child_dst_tp,
+                               const char *&child_dst_arrmeta, intptr_t &dst_ndim, intptr_t *src_stride,
+                               ndt::type *child_src_tp, const char **child_src_arrmeta, intptr_t *src_ndim)
+    {
+      while (dst_ndim > 0) {
+        intptr_t inner_size, inner_dst_stride;
+        ndt::type inner_dst_tp;
+        const char *inner_dst_arrmeta;
+        if (!child_dst_tp.get_as_strided(child_dst_arrmeta, &inner_size, &inner_dst_stride, &inner_dst_tp,
+                                         &inner_dst_arrmeta) ||
+            (size != 1 && dst_stride != inner_size * inner_dst_stride)) {
+          return;
+        }
+
+        intptr_t inner_src_stride[N > 0 ? N : 1];
+        ndt::type inner_src_tp[N > 0 ? N : 1];
+        const char *inner_src_arrmeta[N > 0 ? N : 1];
+        bool inner_broadcast[N > 0 ? N : 1];
+        for (int i = 0; i < N; ++i) {
+          inner_broadcast[i] = src_ndim[i] < dst_ndim;
+          if (inner_broadcast[i]) {
+            inner_src_stride[i] = 0;
+            inner_src_tp[i] = child_src_tp[i];
+            inner_src_arrmeta[i] = child_src_arrmeta[i];
+          }
+          else {
+            intptr_t inner_src_size;
+            if (!child_src_tp[i].get_as_strided(child_src_arrmeta[i], &inner_src_size, &inner_src_stride[i],
+                                                &inner_src_tp[i], &inner_src_arrmeta[i])) {
+              return;
+            }
+            if (inner_src_size != inner_size) {
+              if (inner_src_size != 1) {
+                // A broadcast error, which is reported when the dimension is
+                // lifted on its own
+                return;
+              }
+              inner_src_stride[i] = 0;
+            }
+          }
+
+          if (size != 1 && src_stride[i] != inner_size * inner_src_stride[i]) {
+            return;
+          }
+        }
+
+        size *= inner_size;
+        dst_stride = inner_dst_stride;
+        child_dst_tp = inner_dst_tp;
+        child_dst_arrmeta = inner_dst_arrmeta;
+        --dst_ndim;
+        for (int i = 0; i < N; ++i) {
+          src_stride[i] = inner_src_stride[i];
+          child_src_tp[i] = inner_src_tp[i];
+          child_src_arrmeta[i] = inner_src_arrmeta[i];
+          if (!inner_broadcast[i]) {
+            --src_ndim[i];
+          }
+        }
+      }
+    }
+
     /**
      * This defines the type and keyword argument resolution for
      * an elwise callable.
@@ -34,7 +184,7 @@ namespace nd {
     struct elwise_virtual_ck : base_virtual_kernel<elwise_virtual_ck<N>> {
       static void resolve_dst_type(char *static_data, char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const dynd::nd::array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars)
+                                   const ndt::typevar_map &tp_vars)
       {
         const base_callable *child_af = reinterpret_cast<callable *>(static_data)->get();
         const ndt::callable_type *child_af_tp = reinterpret_cast<callable *>(static_data)->get_type();
@@ -131,7 +281,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta,
                                   dynd::kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                  const dynd::nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                  const dynd::nd::array *kwds, const ndt::typevar_map &tp_vars)
 
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
@@ -263,6 +413,18 @@ namespace nd {
         ckernel_prefix *child = this->get_child();
         expr_strided_t opchild = child->get_function<expr_strided_t>();
 
+        // If every operand's outer stride steps exactly over one inner loop,
+        // for example when everything is contiguous, the calls can be run as
+        // one long loop
+        bool contiguous = dst_stride == m_size * m_dst_stride;
+        for (int j = 0; j != N; ++j) {
+          contiguous &= src_stride[j] == m_size * m_src_stride[j];
+        }
+        if (contiguous) {
+          opchild(child, dst, m_dst_stride, src, m_src_stride, count * m_size);
+          return;
+        }
+
         char *src_loop[N];
         for (int j = 0; j != N; ++j) {
           src_loop[j] = src[j];
@@ -281,7 +443,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -306,7 +468,9 @@ namespace nd {
           throw type_error(ss.str());
         }
 
-        bool finished = dst_ndim == 1;
+        // The number of dimensions left to lift below this one
+        intptr_t child_dst_ndim = dst_ndim - 1;
+        intptr_t child_src_ndim[N];
         for (int i = 0; i < N; ++i) {
           intptr_t src_ndim = src_tp[i].get_ndim() - child_tp->get_pos_type(i).get_ndim();
           intptr_t src_size;
@@ -315,7 +479,7 @@ namespace nd {
             src_stride[i] = 0;
             child_src_arrmeta[i] = src_arrmeta[i];
             child_src_tp[i] = src_tp[i];
-            finished &= src_ndim == 0;
+            child_src_ndim[i] = src_ndim;
           }
           else if (src_tp[i].get_as_strided(src_arrmeta[i], &src_size, &src_stride[i], &child_src_tp[i],
                                             &child_src_arrmeta[i])) {
@@ -323,7 +487,11 @@ namespace nd {
             if (src_size != 1 && size != src_size) {
               throw broadcast_error(dst_tp, dst_arrmeta, src_tp[i], src_arrmeta[i]);
             }
-            finished &= src_ndim == 1;
+            // A view may give a dimension of size one a nonzero stride
+            if (src_size == 1) {
+              src_stride[i] = 0;
+            }
+            child_src_ndim[i] = src_ndim - 1;
           }
           else {
             std::stringstream ss;
@@ -334,9 +502,66 @@ namespace nd {
           }
         }
 
+        coalesce_strided_dims<N>(size, dst_stride, child_dst_tp, child_dst_arrmeta, child_dst_ndim, src_stride,
+                                 child_src_tp, child_src_arrmeta, child_src_ndim);
+
+        bool finished = child_dst_ndim == 0;
+        for (int i = 0; i < N; ++i) {
+          finished &= child_src_ndim[i] == 0;
+        }
+
+        // The outermost dimension of a call runs on several threads if the
+        // evaluation context allows it and there is enough work. Destinations
+        // that allocate into a memory block are left on one thread.
+        int num_workers = 1;
+        intptr_t grain = 1;
+        eval::thread_pool *pool = NULL;
+        if ((kernreq & kernel_request_single) && (kernreq & kernel_request_memory) == kernel_request_host &&
+            ectx->num_threads != 1 && !(dst_tp.get_flags() & type_flag_blockref)) {
+          grain = parallel_elwise_ck<N>::get_grain(ectx->min_grain_size, child_dst_tp, child_dst_arrmeta,
+                                                   child_dst_ndim);
+          num_workers = eval::plan_workers(ectx, size, &pool, grain);
+        }
+
+        if (num_workers > 1) {
+          intptr_t root_ckb_offset = ckb_offset;
+          parallel_elwise_ck<N>::make(ckb, kernreq, ckb_offset, size, dst_stride,
+                                      dynd::detail::make_array_wrapper<N>(src_stride), grain, pool);
+          kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
+
+          for (int i = 0; i < num_workers; ++i) {
+            intptr_t child_ckb_offset = ckb_offset;
+            ckb_offset = ckernel_prefix::align_offset(instantiate_child(static_data, data, ckb, ckb_offset, finished,
+                                                                        child_dst_tp, child_dst_arrmeta, nsrc,
+                                                                        child_src_tp, child_src_arrmeta, kernreq,
+                                                                        ectx, nkwd, kwds, tp_vars));
+            parallel_elwise_ck<N> *self = parallel_elwise_ck<N>::get_self(
+                reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+            if (i == 0) {
+              self->m_child_stride = ckb_offset - child_ckb_offset;
+            }
+            else if (ckb_offset - child_ckb_offset != self->m_child_stride) {
+              throw std::runtime_error("internal error: copies of an elwise child ckernel differ in size");
+            }
+            self->m_num_workers = i + 1;
+          }
+
+          return ckb_offset;
+        }
+
         self_type::make(ckb, kernreq, ckb_offset, size, dst_stride, dynd::detail::make_array_wrapper<N>(src_stride));
         kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
 
+        return instantiate_child(static_data, data, ckb, ckb_offset, finished, child_dst_tp, child_dst_arrmeta, nsrc,
+                                 child_src_tp, child_src_arrmeta, kernreq, ectx, nkwd, kwds, tp_vars);
+      }
+
+      static intptr_t instantiate_child(char *static_data, char *data, void *ckb, intptr_t ckb_offset, bool finished,
+                                        const ndt::type &child_dst_tp, const char *child_dst_arrmeta, intptr_t nsrc,
+                                        const ndt::type *child_src_tp, const char *const *child_src_arrmeta,
+                                        kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+                                        const nd::array *kwds, const ndt::typevar_map &tp_vars)
+      {
         // If there are still dimensions to broadcast, recursively lift more
         if (!finished) {
           return nd::functional::elwise_virtual_ck<N>::instantiate(
@@ -345,6 +570,7 @@ namespace nd {
         }
 
         // Instantiate the elementwise handler
+        callable &child = *reinterpret_cast<callable *>(static_data);
         return child.get()->instantiate(child.get()->static_data(), NULL, ckb, ckb_offset, child_dst_tp,
                                         child_dst_arrmeta, nsrc, child_src_tp, child_src_arrmeta, kernreq, ectx, nkwd,
                                         kwds, tp_vars);
@@ -378,6 +604,11 @@ namespace nd {
         ckernel_prefix *child = this->get_child();
         expr_strided_t opchild = child->get_function<expr_strided_t>();
 
+        if (dst_stride == m_size * m_dst_stride) {
+          opchild(child, dst, m_dst_stride, NULL, NULL, count * m_size);
+          return;
+        }
+
         for (size_t i = 0; i < count; i += 1) {
           opchild(child, dst, m_dst_stride, NULL, NULL, m_size);
           dst += dst_stride;
@@ -388,7 +619,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *DYND_UNUSED(src_tp),
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -413,10 +644,14 @@ namespace nd {
           throw type_error(ss.str());
         }
 
+        intptr_t child_dst_ndim = dst_ndim - 1;
+        coalesce_strided_dims<0>(size, dst_stride, child_dst_tp, child_dst_arrmeta, child_dst_ndim, NULL, NULL, NULL,
+                                 NULL);
+
         self_type::make(ckb, kernreq, ckb_offset, size, dst_stride);
         kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
 
-        bool finished = dst_ndim == 1;
+        bool finished = child_dst_ndim == 0;
 
         // If there are still dimensions to broadcast, recursively lift more
         if (!finished) {
@@ -506,7 +741,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -618,7 +853,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *DYND_UNUSED(src_tp),
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -671,12 +906,14 @@ namespace nd {
       size_t m_dst_target_alignment;
       intptr_t m_dst_stride, m_dst_offset, m_src_stride[N], m_src_offset[N], m_src_size[N];
       bool m_is_src_var[N];
+      // The arena of the dst memory block for the strings and bytes of the elements, or NULL
+      memory_block_data *m_string_arena;
 
       elwise_ck(memory_block_data *dst_memblock, size_t dst_target_alignment, intptr_t dst_stride, intptr_t dst_offset,
                 const intptr_t *src_stride, const intptr_t *src_offset, const intptr_t *src_size,
                 const bool *is_src_var)
           : m_dst_memblock(dst_memblock), m_dst_target_alignment(dst_target_alignment), m_dst_stride(dst_stride),
-            m_dst_offset(dst_offset)
+            m_dst_offset(dst_offset), m_string_arena(NULL)
       {
         memcpy(m_src_stride, src_stride, sizeof(m_src_stride));
         memcpy(m_src_offset, src_offset, sizeof(m_src_offset));
@@ -796,7 +1033,13 @@ namespace nd {
         else {
           modified_dst_stride = m_dst_stride;
         }
-        opchild(child, modified_dst, modified_dst_stride, modified_src, modified_src_stride, dim_size);
+        if (m_string_arena != NULL) {
+          string_arena_scope arena_scope(m_string_arena);
+          opchild(child, modified_dst, modified_dst_stride, modified_src, modified_src_stride, dim_size);
+        }
+        else {
+          opchild(child, modified_dst, modified_dst_stride, modified_src, modified_src_stride, dim_size);
+        }
       }
 
       void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
@@ -816,7 +1059,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -873,8 +1116,14 @@ namespace nd {
           }
         }
 
-        self_type::make(ckb, kernreq, ckb_offset, dst_md->blockref.get(), dst_vdd->get_target_alignment(),
-                        dst_md->stride, dst_md->offset, src_stride, src_offset, src_size, is_src_var);
+        self_type *self = self_type::make(ckb, kernreq, ckb_offset, dst_md->blockref.get(),
+                                          dst_vdd->get_target_alignment(), dst_md->stride, dst_md->offset, src_stride,
+                                          src_offset, src_size, is_src_var);
+
+        // Strings and bytes in the elements may allocate their data from the arena of the dst memory block
+        if (ectx->use_string_arena && dst_md->blockref->m_type == objectarray_memory_block_type) {
+          self->m_string_arena = get_objectarray_memory_block_arena(dst_md->blockref.get());
+        }
 
         // If there are still dimensions to broadcast, recursively lift more
         if (!finished) {
@@ -959,7 +1208,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *DYND_UNUSED(src_tp),
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
       {
         callable &child = *reinterpret_cast<callable *>(static_data);
         const ndt::callable_type *child_tp = child.get_type();
@@ -154,8 +154,7 @@ namespace nd {
                   intptr_t DYND_UNUSED(nsrc), const ndt::type
        *DYND_UNUSED(src_tp),
                   nd::array &kwds,
-                  const std::map<std::string, ndt::type>
-       &DYND_UNUSED(tp_vars))
+                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
         {
         }
     */
@@ -164,7 +163,7 @@ namespace nd {
                                 const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
                                 const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       int flags;
       if (kwds[2].is_missing()) {
@@ -227,7 +226,7 @@ namespace nd {
     static typename std::enable_if<real_to_complex, void>::type
     resolve_dst_type_(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                       intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
-                      const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                      const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       nd::array shape = kwds[0];
 
@@ -242,7 +241,7 @@ namespace nd {
     static typename std::enable_if<!real_to_complex, void>::type
     resolve_dst_type_(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                       intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
-                      const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                      const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       nd::array shape = kwds[0];
       if (shape.is_missing()) {
@@ -258,7 +257,7 @@ namespace nd {
 
     static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const nd::array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       resolve_dst_type_<std::is_same<fftw_src_type, double>::value>(static_data, data, dst_tp, nsrc, src_tp, nkwd, kwds,
                                                                     tp_vars);
@@ -0,0 +1,198 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/func/callable.hpp>
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/convert_kernel.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * One callable of a fused expression. Its operands are slots, where the
+     * first slots are the arguments of the fused kernel, and slot
+     * ``nleaf + k`` is the result of step ``k``.
+     */
+    struct fused_step {
+      callable child;
+      std::vector<intptr_t> args;
+      std::vector<ndt::type> src_tp;
+      ndt::type dst_tp;
+      ndt::typevar_map tp_vars;
+    };
+
+    /**
+     * A kernel which evaluates a sequence of scalar callables, in blocks of
+     * DYND_FUSED_BLOCK_SIZE elements. The result of every step but the last
+     * goes to a temporary of one block, and the last step writes the
+     * destination, through one more temporary and an assignment if the
+     * destination type differs from its result type.
+     */
+    // All methods are inlined, so this does not need to be declared DYND_API.
+    struct fused_kernel : base_kernel<fused_kernel> {
+      struct static_data {
+        intptr_t nleaf;
+        std::vector<fused_step> steps;
+
+        static_data(intptr_t nleaf, std::vector<fused_step> &&steps) : nleaf(nleaf), steps(std::move(steps)) {}
+      };
+
+      intptr_t m_nleaf;
+      // The offsets to the child kernel of each step
+      std::vector<intptr_t> m_child_offsets;
+      // The offset to the assignment into the destination, or 0 if there is none
+      intptr_t m_assign_offset;
+      // The block temporary of each step, null for a last step writing the destination
+      std::vector<buffer_storage> m_bufs;
+      // The operand slots of all the steps, with step k at [m_arg_begin[k], m_arg_begin[k + 1])
+      std::vector<intptr_t> m_args;
+      std::vector<intptr_t> m_arg_begin;
+      // Scratch space for the operands of each step and the current source pointers
+      std::vector<char *> m_arg_data;
+      std::vector<intptr_t> m_arg_stride;
+      std::vector<char *> m_src;
+      // Zero strides for the leaves, to run a single element through strided
+      std::vector<intptr_t> m_zero_stride;
+
+      fused_kernel(const struct static_data &data, const ndt::type &dst_tp)
+          : m_nleaf(data.nleaf), m_child_offsets(data.steps.size()), m_assign_offset(0), m_bufs(data.steps.size()),
+            m_arg_begin(1, 0), m_src(data.nleaf), m_zero_stride(data.nleaf)
+      {
+        for (size_t k = 0; k < data.steps.size(); ++k) {
+          const fused_step &step = data.steps[k];
+          m_args.insert(m_args.end(), step.args.begin(), step.args.end());
+          m_arg_begin.push_back(m_args.size());
+          if (k + 1 < data.steps.size() || step.dst_tp != dst_tp) {
+            m_bufs[k].allocate(step.dst_tp, DYND_FUSED_BLOCK_SIZE);
+          }
+        }
+        m_arg_data.resize(m_args.size());
+        m_arg_stride.resize(m_args.size());
+      }
+
+      ~fused_kernel()
+      {
+        for (intptr_t offset : m_child_offsets) {
+          if (offset != 0) {
+            get_child(offset)->destroy();
+          }
+        }
+        if (m_assign_offset != 0) {
+          get_child(m_assign_offset)->destroy();
+        }
+      }
+
+      void single(char *dst, char *const *src) { strided(dst, 0, src, m_zero_stride.data(), 1); }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        intptr_t nstep = m_child_offsets.size();
+        std::copy(src, src + m_nleaf, m_src.begin());
+
+        while (count > 0) {
+          size_t block_size = std::min(count, static_cast<size_t>(DYND_FUSED_BLOCK_SIZE));
+          for (intptr_t k = 0; k < nstep; ++k) {
+            for (intptr_t j = m_arg_begin[k]; j < m_arg_begin[k + 1]; ++j) {
+              intptr_t slot = m_args[j];
+              if (slot < m_nleaf) {
+                m_arg_data[j] = m_src[slot];
+                m_arg_stride[j] = src_stride[slot];
+              }
+              else {
+                m_arg_data[j] = m_bufs[slot - m_nleaf].get_storage();
+                m_arg_stride[j] = m_bufs[slot - m_nleaf].get_stride();
+              }
+            }
+
+            buffer_storage &buf = m_bufs[k];
+            ckernel_prefix *child = get_child(m_child_offsets[k]);
+            if (buf.is_null()) {
+              child->strided(dst, dst_stride, &m_arg_data[m_arg_begin[k]], &m_arg_stride[m_arg_begin[k]], block_size);
+            }
+            else {
+              buf.reset_arrmeta();
+              child->strided(buf.get_storage(), buf.get_stride(), &m_arg_data[m_arg_begin[k]],
+                             &m_arg_stride[m_arg_begin[k]], block_size);
+            }
+          }
+
+          if (m_assign_offset != 0) {
+            char *buf_data = m_bufs.back().get_storage();
+            intptr_t buf_stride = m_bufs.back().get_stride();
+            get_child(m_assign_offset)->strided(dst, dst_stride, &buf_data, &buf_stride, block_size);
+          }
+
+          for (intptr_t i = 0; i < m_nleaf; ++i) {
+            m_src[i] += block_size * src_stride[i];
+          }
+          dst += block_size * dst_stride;
+          count -= block_size;
+        }
+      }
+
+      static intptr_t instantiate(char *static_data, char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+                                  const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
+                                  const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                  const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
+                                  const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+      {
+        const struct static_data *static_data_x = reinterpret_cast<struct static_data *>(static_data);
+        const std::vector<fused_step> &steps = static_data_x->steps;
+        intptr_t nleaf = static_data_x->nleaf;
+
+        intptr_t root_ckb_offset = ckb_offset;
+        fused_kernel *self = make(ckb, kernreq, ckb_offset, *static_data_x, dst_tp);
+
+        // The steps always run on whole blocks
+        kernreq = (kernreq & kernel_request_memory) | kernel_request_strided;
+
+        std::vector<ndt::type> arg_tp;
+        std::vector<const char *> arg_arrmeta;
+        for (size_t k = 0; k < steps.size(); ++k) {
+          const fused_step &step = steps[k];
+          arg_tp.clear();
+          arg_arrmeta.clear();
+          for (intptr_t slot : step.args) {
+            if (slot < nleaf) {
+              arg_tp.push_back(src_tp[slot]);
+              arg_arrmeta.push_back(src_arrmeta[slot]);
+            }
+            else {
+              arg_tp.push_back(steps[slot - nleaf].dst_tp);
+              arg_arrmeta.push_back(self->m_bufs[slot - nleaf].get_arrmeta());
+            }
+          }
+
+          const buffer_storage &buf = self->m_bufs[k];
+          const ndt::type &step_dst_tp = buf.is_null() ? dst_tp : step.dst_tp;
+          const char *step_dst_arrmeta = buf.is_null() ? dst_arrmeta : buf.get_arrmeta();
+
+          // The children have no keyword parameters, and each instantiate takes the data of a new data_init
+          self->m_child_offsets[k] = ckb_offset - root_ckb_offset;
+          base_callable *child = const_cast<base_callable *>(step.child.get());
+          char *child_data = child->data_init(child->static_data(), step_dst_tp, arg_tp.size(), arg_tp.data(), 0,
+                                              NULL, step.tp_vars);
+          ckb_offset = child->instantiate(child->static_data(), child_data, ckb, ckb_offset, step_dst_tp,
+                                          step_dst_arrmeta, arg_tp.size(), arg_tp.data(), arg_arrmeta.data(), kernreq,
+                                          ectx, 0, NULL, step.tp_vars);
+          self = get_self(reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+        }
+
+        if (!self->m_bufs.back().is_null()) {
+          self->m_assign_offset = ckb_offset - root_ckb_offset;
+          ckb_offset = make_assignment_kernel(ckb, ckb_offset, dst_tp, dst_arrmeta, steps.back().dst_tp,
+                                              self->m_bufs.back().get_arrmeta(), kernreq, ectx);
+        }
+
+        return ckb_offset;
+      }
+    };
+
+  } // namespace dynd::nd::functional
+} // namespace dynd::nd
+} // namespace dynd
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 
 namespace dynd {
 namespace nd {
@@ -17,6 +18,11 @@ namespace nd {
 
     static const std::size_t data_size = 0;
 
+    // Reduces contiguous values into a single destination
+    detail::simd_reduce_t contiguous;
+
+    max_kernel() : contiguous(detail::get_simd_reduce(detail::simd_reduce_max, Src0TypeID)) {}
+
     void single(char *dst, char *const *src)
     {
       if (*reinterpret_cast<src0_type *>(src[0]) > *reinterpret_cast<dst_type *>(dst)) {
@@ -26,9 +32,13 @@ namespace nd {
 
     void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
     {
-
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (contiguous != NULL && dst_stride == 0 && src0_stride == sizeof(src0_type)) {
+        contiguous(dst, src0, count);
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         if (*reinterpret_cast<src0_type *>(src0) > *reinterpret_cast<dst_type *>(dst)) {
           *reinterpret_cast<dst_type *>(dst) = *reinterpret_cast<src0_type *>(src0);
@@ -38,7 +38,7 @@ namespace nd {
     }
 
     static char *data_init(char *static_data, const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
-                           intptr_t nkwd, const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                           intptr_t nkwd, const nd::array *kwds, const ndt::typevar_map &tp_vars)
     {
       char *data = reinterpret_cast<char *>(new data_type());
       reinterpret_cast<data_type *>(data)->sum_data = nd::sum::get().get()->data_init(
@@ -52,7 +52,7 @@ namespace nd {
 
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars)
+                                 const ndt::typevar_map &tp_vars)
     {
       nd::sum::get().get()->resolve_dst_type(nd::sum::get().get()->static_data(),
                                              reinterpret_cast<data_type *>(data)->sum_data, dst_tp, nsrc, src_tp, nkwd,
@@ -63,7 +63,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars)
+                                const ndt::typevar_map &tp_vars)
     {
       intptr_t mean_offset = ckb_offset;
       make(ckb, kernreq, ckb_offset, src_tp[0].get_size(src_arrmeta[0]));
@@ -32,7 +32,7 @@ namespace nd {
      *
      */
     inline bool can_implicitly_convert(const ndt::type &src, const ndt::type &dst,
-                                       std::map<std::string, ndt::type> &typevars)
+                                       ndt::typevar_map &typevars)
     {
       if (src == dst) {
         return true;
@@ -68,13 +68,13 @@ namespace nd {
     struct DYND_API old_multidispatch_ck : base_virtual_kernel<old_multidispatch_ck> {
       static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars);
+                                   const ndt::typevar_map &tp_vars);
 
       static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset,
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars);
+                                  const ndt::typevar_map &tp_vars);
     };
 
     template <typename DispatcherType>
@@ -84,7 +84,7 @@ namespace nd {
 /*
       static char *data_init(char *static_data, const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                              intptr_t DYND_UNUSED(nkwd), const array *DYND_UNUSED(kwds),
-                             const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                             const ndt::typevar_map &DYND_UNUSED(tp_vars))
       {
         DispatcherType &dispatcher = *reinterpret_cast<static_data_type *>(static_data);
         callable &child = dispatcher(dst_tp, nsrc, src_tp);
@@ -97,7 +97,7 @@ namespace nd {
 
       static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars)
+                                   const ndt::typevar_map &tp_vars)
       {
         DispatcherType &dispatcher = *reinterpret_cast<static_data_type *>(static_data);
 
@@ -115,7 +115,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         DispatcherType &dispatcher = *reinterpret_cast<static_data_type *>(static_data);
 
@@ -19,7 +19,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta,
                                   dynd::kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                  const dynd::nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                  const dynd::nd::array *kwds, const ndt::typevar_map &tp_vars)
       {
         intptr_t ndim = 0;
         for (intptr_t i = 0; i < nsrc; ++i) {
@@ -80,7 +80,7 @@ namespace nd {
 
       static void resolve_dst_type(char *static_data, char *DYND_UNUSED(data), ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const dynd::nd::array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars)
+                                   const ndt::typevar_map &tp_vars)
       {
         base_callable *child = reinterpret_cast<callable *>(static_data)->get();
         const ndt::callable_type *child_tp = reinterpret_cast<callable *>(static_data)->get_type();
@@ -0,0 +1,440 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/math.hpp>
+#include <dynd/philox.hpp>
+#include <dynd/eval/thread_pool.hpp>
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/base_virtual_kernel.hpp>
+#include <dynd/kernels/elwise.hpp>
+#include <dynd/types/substitute_typevars.hpp>
+
+namespace dynd {
+namespace nd {
+  namespace random {
+
+    /**
+     * Returns the seed used when none is given, which is drawn from
+     * ``std::random_device`` once per process.
+     */
+    DYND_API uint64_t get_default_seed();
+
+    /**
+     * Returns a stream of the default seed that no other call has returned,
+     * so unseeded generators never repeat each other's values.
+     */
+    DYND_API uint32_t get_next_default_stream();
+
+    namespace detail {
+
+      /**
+       * The random words for the element at one index of a stream. The first
+       * four come from the block at round 0, and any more from later rounds.
+       */
+      class philox_words {
+        const philox4x32 &m_gen;
+        uint64_t m_index;
+        uint32_t m_stream;
+        uint32_t m_round;
+        int m_pos;
+        philox4x32::block_type m_block;
+
+      public:
+        philox_words(const philox4x32 &gen, uint64_t index, uint32_t stream)
+            : m_gen(gen), m_index(index), m_stream(stream), m_round(0), m_pos(0), m_block(gen(index, stream))
+        {
+        }
+
+        uint32_t next32()
+        {
+          if (m_pos == 4) {
+            m_block = m_gen(m_index, m_stream, ++m_round);
+            m_pos = 0;
+          }
+          return m_block[m_pos++];
+        }
+
+        uint64_t next64()
+        {
+          uint32_t lo = next32();
+          return join_words(lo, next32());
+        }
+      };
+
+      /**
+       * Returns a uniform integer in [0, range] without bias, with Lemire's
+       * multiply and reject method.
+       */
+      inline uint64_t bounded_uint64(philox_words &words, uint64_t range)
+      {
+        if (range == std::numeric_limits<uint64_t>::max()) {
+          return words.next64();
+        }
+
+        // The high and low halves of the 128-bit product x * n
+        const uint64_t n = range + 1;
+        uint64_t x = words.next64(), hi, lo;
+        for (;;) {
+          uint64_t x_lo = x & 0xFFFFFFFFu, x_hi = x >> 32, n_lo = n & 0xFFFFFFFFu, n_hi = n >> 32;
+          uint64_t lo_lo = x_lo * n_lo, hi_lo = x_hi * n_lo, lo_hi = x_lo * n_hi, hi_hi = x_hi * n_hi;
+          uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+          hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+          lo = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+          // Only the low part of the product can reveal a biased value
+          if (lo >= n || lo >= (0 - n) % n) {
+            return hi;
+          }
+          x = words.next64();
+        }
+      }
+
+      template <typename R>
+      R unit_real(philox_words &words);
+
+      template <>
+      inline float unit_real<float>(philox_words &words)
+      {
+        return unit_float(words.next32());
+      }
+
+      template <>
+      inline double unit_real<double>(philox_words &words)
+      {
+        return unit_double(words.next64());
+      }
+
+      template <type_id_t DstTypeID, type_kind_t DstTypeKind>
+      struct uniform_distribution;
+
+      template <type_id_t DstTypeID>
+      struct uniform_distribution<DstTypeID, sint_kind> {
+        typedef typename type_of<DstTypeID>::type value_type;
+        typedef typename std::make_unsigned<value_type>::type unsigned_type;
+
+        static const intptr_t nkwd = 2;
+
+        value_type a;
+        uint64_t range;
+
+        uniform_distribution(const nd::array *kwds)
+        {
+          a = kwds[0].is_missing() ? 0 : kwds[0].as<value_type>();
+          value_type b = kwds[1].is_missing() ? std::numeric_limits<value_type>::max() : kwds[1].as<value_type>();
+          if (b < a) {
+            throw std::invalid_argument("uniform requires a <= b");
+          }
+          range = static_cast<unsigned_type>(static_cast<unsigned_type>(b) - static_cast<unsigned_type>(a));
+        }
+
+        value_type operator()(philox_words &words) const
+        {
+          return static_cast<value_type>(static_cast<unsigned_type>(a) +
+                                         static_cast<unsigned_type>(bounded_uint64(words, range)));
+        }
+
+        static const char *signature() { return "(a: ?R, b: ?R, seed: ?Int, stream: ?Int) -> Dims... * R"; }
+      };
+
+      template <type_id_t DstTypeID>
+      struct uniform_distribution<DstTypeID, uint_kind> : uniform_distribution<DstTypeID, sint_kind> {
+        using uniform_distribution<DstTypeID, sint_kind>::uniform_distribution;
+      };
+
+      template <type_id_t DstTypeID>
+      struct uniform_distribution<DstTypeID, real_kind> {
+        typedef typename type_of<DstTypeID>::type value_type;
+
+        static const intptr_t nkwd = 2;
+
+        value_type a, b;
+
+        uniform_distribution(const nd::array *kwds)
+        {
+          a = kwds[0].is_missing() ? 0 : kwds[0].as<value_type>();
+          b = kwds[1].is_missing() ? 1 : kwds[1].as<value_type>();
+        }
+
+        value_type operator()(philox_words &words) const { return a + (b - a) * unit_real<value_type>(words); }
+
+        static const char *signature() { return "(a: ?R, b: ?R, seed: ?Int, stream: ?Int) -> Dims... * R"; }
+      };
+
+      template <type_id_t DstTypeID>
+      struct uniform_distribution<DstTypeID, complex_kind> {
+        typedef typename type_of<DstTypeID>::type value_type;
+        typedef typename value_type::value_type real_type;
+
+        static const intptr_t nkwd = 2;
+
+        value_type a, b;
+
+        uniform_distribution(const nd::array *kwds)
+        {
+          a = kwds[0].is_missing() ? value_type(0, 0) : kwds[0].as<value_type>();
+          b = kwds[1].is_missing() ? value_type(1, 1) : kwds[1].as<value_type>();
+        }
+
+        value_type operator()(philox_words &words) const
+        {
+          real_type real = a.real() + (b.real() - a.real()) * unit_real<real_type>(words);
+          return value_type(real, a.imag() + (b.imag() - a.imag()) * unit_real<real_type>(words));
+        }
+
+        static const char *signature() { return "(a: ?R, b: ?R, seed: ?Int, stream: ?Int) -> Dims... * R"; }
+      };
+
+      /**
+       * The normal distribution, with the Box-Muller transform of two uniform
+       * doubles.
+       */
+      template <type_id_t DstTypeID>
+      struct normal_distribution {
+        typedef typename type_of<DstTypeID>::type value_type;
+
+        static const intptr_t nkwd = 2;
+
+        double mean, stddev;
+
+        normal_distribution(const nd::array *kwds)
+        {
+          mean = kwds[0].is_missing() ? 0.0 : kwds[0].as<double>();
+          stddev = kwds[1].is_missing() ? 1.0 : kwds[1].as<double>();
+          if (!(stddev >= 0)) {
+            throw std::invalid_argument("normal requires stddev >= 0");
+          }
+        }
+
+        value_type operator()(philox_words &words) const
+        {
+          // The first uniform is in (0, 1], so its logarithm is finite
+          double u0 = 1.0 - unit_double(words.next64()), u1 = unit_double(words.next64());
+          return static_cast<value_type>(mean + stddev * std::sqrt(-2.0 * std::log(u0)) * std::cos(_2_pi<double>() * u1));
+        }
+
+        static const char *signature() { return "(mean: ?R, stddev: ?R, seed: ?Int, stream: ?Int) -> Dims... * R"; }
+      };
+
+      /**
+       * The exponential distribution, by inverting its distribution function.
+       */
+      template <type_id_t DstTypeID>
+      struct exponential_distribution {
+        typedef typename type_of<DstTypeID>::type value_type;
+
+        static const intptr_t nkwd = 1;
+
+        double lambda;
+
+        exponential_distribution(const nd::array *kwds)
+        {
+          lambda = kwds[0].is_missing() ? 1.0 : kwds[0].as<double>();
+          if (!(lambda > 0)) {
+            throw std::invalid_argument("exponential requires lambda > 0");
+          }
+        }
+
+        value_type operator()(philox_words &words) const
+        {
+          return static_cast<value_type>(-std::log1p(-unit_double(words.next64())) / lambda);
+        }
+
+        static const char *signature() { return "(lambda: ?R, seed: ?Int, stream: ?Int) -> Dims... * R"; }
+      };
+
+      /**
+       * Fills a strided array with values of a distribution. The element at
+       * position i in C order is made from the words of index i in the stream,
+       * so the values depend on the seed, stream and shape alone. This is what
+       * lets the array be split into chunks filled concurrently, with the same
+       * result for any number of threads. Each call continues the stream where
+       * the previous one stopped, so a kernel lifted by elwise over dimensions
+       * that are not strided still fills every element with distinct values.
+       */
+      template <typename DistributionType>
+      struct random_fill_kernel : base_kernel<random_fill_kernel<DistributionType>, 0> {
+        typedef typename DistributionType::value_type R;
+
+        static const size_t data_size = 0;
+
+        const DistributionType dist;
+        const philox4x32 gen;
+        const uint32_t stream;
+        const std::vector<intptr_t> shape;
+        const std::vector<intptr_t> strides;
+        intptr_t size;
+        // The stream index of the first element of the next call
+        uint64_t base;
+        // When num_workers > 1, the fill runs on the thread pool
+        int num_workers;
+        eval::thread_pool *pool;
+
+        random_fill_kernel(const DistributionType &dist, uint64_t seed, uint32_t stream,
+                           const std::vector<intptr_t> &shape, const std::vector<intptr_t> &strides)
+            : dist(dist), gen(seed), stream(stream), shape(shape), strides(strides), size(1), base(0), num_workers(1),
+              pool(NULL)
+        {
+          for (intptr_t dim_size : shape) {
+            size *= dim_size;
+          }
+        }
+
+        /**
+         * Fills the elements from ``begin`` to ``end`` in C order, running
+         * along the innermost dimension.
+         */
+        void fill(char *dst, intptr_t begin, intptr_t end) const
+        {
+          // Nothing to do for an empty range, including any array with a zero-size dimension
+          if (begin >= end) {
+            return;
+          }
+
+          if (shape.empty()) {
+            philox_words words(gen, base, stream);
+            *reinterpret_cast<R *>(dst) = dist(words);
+            return;
+          }
+
+          intptr_t inner = shape.size() - 1;
+          std::vector<intptr_t> index(shape.size());
+          for (intptr_t i = inner, rem = begin; i >= 0; --i) {
+            index[i] = rem % shape[i];
+            rem /= shape[i];
+            dst += index[i] * strides[i];
+          }
+
+          while (begin < end) {
+            intptr_t count = std::min(end - begin, shape[inner] - index[inner]);
+            for (intptr_t j = 0; j < count; ++j, dst += strides[inner]) {
+              philox_words words(gen, base + begin + j, stream);
+              *reinterpret_cast<R *>(dst) = dist(words);
+            }
+            begin += count;
+
+            // Carry into the outer dimensions
+            index[inner] += count;
+            for (intptr_t i = inner; i > 0 && index[i] == shape[i]; --i) {
+              dst += strides[i - 1] - shape[i] * strides[i];
+              index[i] = 0;
+              ++index[i - 1];
+            }
+          }
+        }
+
+        void single(char *dst, char *const *DYND_UNUSED(src))
+        {
+          if (num_workers > 1) {
+            intptr_t num_chunks = 4 * num_workers;
+            intptr_t chunk_size = (size + num_chunks - 1) / num_chunks;
+            pool->parallel_for(num_workers, num_chunks, 1, [&](int DYND_UNUSED(worker), intptr_t begin, intptr_t end) {
+              for (intptr_t i = begin; i < end; ++i) {
+                fill(dst, std::min(size, i * chunk_size), std::min(size, (i + 1) * chunk_size));
+              }
+            });
+          }
+          else {
+            fill(dst, 0, size);
+          }
+          base += size;
+        }
+      };
+
+      /**
+       * The callable for one distribution and destination type. Its keyword
+       * arguments are the ones of the distribution, then the seed and stream.
+       * Without a seed, the default seed is used with a new stream, and with a
+       * seed, the stream is 0 unless it is given.
+       */
+      template <typename DistributionType>
+      struct random_kernel : base_virtual_kernel<random_kernel<DistributionType>> {
+        static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                    intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+                                    intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
+                                    const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+                                    const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
+                                    const ndt::typevar_map &tp_vars)
+        {
+          std::vector<intptr_t> shape, strides;
+          ndt::type tp = dst_tp;
+          const char *arrmeta = dst_arrmeta;
+          while (tp.get_ndim() > 0) {
+            intptr_t dim_size, stride;
+            ndt::type el_tp;
+            const char *el_arrmeta;
+            if (!tp.get_as_strided(arrmeta, &dim_size, &stride, &el_tp, &el_arrmeta)) {
+              // Dimensions like var are lifted by elwise down to a scalar fill kernel
+              static callable self = callable::make<random_kernel>();
+              return functional::elwise_virtual_ck<0>::instantiate(reinterpret_cast<char *>(&self), NULL, ckb,
+                                                                   ckb_offset, dst_tp, dst_arrmeta, 0, NULL, NULL,
+                                                                   kernreq, ectx, nkwd, kwds, tp_vars);
+            }
+            shape.push_back(dim_size);
+            strides.push_back(stride);
+            tp = el_tp;
+            arrmeta = el_arrmeta;
+          }
+
+          DistributionType dist(kwds);
+
+          const nd::array &seed_kwd = kwds[DistributionType::nkwd], &stream_kwd = kwds[DistributionType::nkwd + 1];
+          uint64_t seed = seed_kwd.is_missing() ? get_default_seed() : seed_kwd.as<uint64_t>();
+          uint32_t stream;
+          if (!stream_kwd.is_missing()) {
+            stream = stream_kwd.as<uint32_t>();
+          }
+          else {
+            stream = seed_kwd.is_missing() ? get_next_default_stream() : 0;
+          }
+
+          intptr_t root_ckb_offset = ckb_offset;
+          random_fill_kernel<DistributionType>::make(ckb, kernreq, ckb_offset, dist, seed, stream, shape, strides);
+
+          random_fill_kernel<DistributionType> *self = random_fill_kernel<DistributionType>::get_self(
+              reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+
+          // Large arrays are split across the thread pool if the evaluation context allows it
+          self->num_workers = eval::plan_workers(ectx, self->size, &self->pool);
+
+          return ckb_offset;
+        }
+      };
+
+    } // namespace dynd::nd::random::detail
+
+    template <type_id_t DstTypeID>
+    using uniform_kernel =
+        detail::random_kernel<detail::uniform_distribution<DstTypeID, type_kind_of<DstTypeID>::value>>;
+
+    template <type_id_t DstTypeID>
+    using normal_kernel = detail::random_kernel<detail::normal_distribution<DstTypeID>>;
+
+    template <type_id_t DstTypeID>
+    using exponential_kernel = detail::random_kernel<detail::exponential_distribution<DstTypeID>>;
+
+  } // namespace dynd::nd::random
+} // namespace dynd::nd
+
+namespace ndt {
+
+  template <typename DistributionType>
+  struct type::equivalent<nd::random::detail::random_kernel<DistributionType>> {
+    static type make()
+    {
+      ndt::typevar_map tp_vars;
+      tp_vars["R"] = ndt::type::make<typename DistributionType::value_type>();
+
+      return ndt::substitute(ndt::type(DistributionType::signature()), tp_vars, false);
+    }
+  };
+
+} // namespace dynd::ndt
+} // namespace dynd
@@ -5,11 +5,15 @@
 
 #pragma once
 
+#include <cstring>
+#include <vector>
+
 #include <dynd/func/callable.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/func/assignment.hpp>
 #include <dynd/func/constant.hpp>
 #include <dynd/kernels/constant_kernel.hpp>
+#include <dynd/eval/thread_pool.hpp>
 
 namespace dynd {
 namespace nd {
@@ -75,7 +79,7 @@ namespace nd {
       };
 
       static char *data_init(char *static_data, const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
-                             intptr_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                             intptr_t nkwd, const array *kwds, const ndt::typevar_map &tp_vars)
       {
         char *data = reinterpret_cast<char *>(new data_type());
 
@@ -119,7 +123,7 @@ namespace nd {
 
       static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars)
+                                   const ndt::typevar_map &tp_vars)
       {
         ndt::type child_dst_tp = reinterpret_cast<static_data_type *>(static_data)->child.get_type()->get_return_type();
         if (child_dst_tp.is_symbolic()) {
@@ -157,7 +161,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars);
+                                  const ndt::typevar_map &tp_vars);
     };
 
     template <typename SelfType>
@@ -311,7 +315,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -364,6 +368,13 @@ namespace nd {
       intptr_t size;
       intptr_t src_stride;
       size_t init_offset;
+      // When num_workers > 1, the dimension is reduced on several threads
+      int num_workers;
+      intptr_t num_chunks;
+      size_t dst_data_size;
+      eval::thread_pool *pool;
+
+      reduction_kernel() : num_workers(1), num_chunks(1), dst_data_size(0), pool(NULL) {}
 
       ~reduction_kernel()
       {
@@ -371,8 +382,60 @@ namespace nd {
         get_child(init_offset)->destroy();
       }
 
+      /**
+       * Reduces the dimension as a tree on the thread pool. The dimension is
+       * split into a fixed number of chunks, each chunk is reduced into its
+       * own accumulator, and the accumulators are then combined in order with
+       * the reduction itself, so the result does not depend on the schedule.
+       * If ``first`` is true, ``dst`` is initialized, otherwise the chunks
+       * are accumulated into it.
+       *
+       * The child ckernels are shared by the threads, which is only done for
+       * builtin element types, whose kernels keep no state while they run.
+       */
+      void parallel_reduce(char *dst, char *src0, bool first)
+      {
+        ckernel_prefix *init_child = get_child(init_offset);
+        ckernel_prefix *reduction_child = get_child();
+
+        // Builtin accumulators, each kept on its own cache line
+        intptr_t partial_stride = 64;
+        std::vector<char> partials(num_chunks * partial_stride + partial_stride);
+        char *partials_begin =
+            partials.data() + (partial_stride - reinterpret_cast<uintptr_t>(partials.data()) % partial_stride);
+        // One source element initializes the accumulator, unless there is an identity
+        intptr_t skip = size - size_first;
+
+        pool->parallel_for(num_workers, num_chunks, 1, [&](int DYND_UNUSED(worker), intptr_t begin, intptr_t end) {
+          for (intptr_t i = begin; i < end; ++i) {
+            intptr_t chunk_begin = size * i / num_chunks;
+            intptr_t chunk_end = size * (i + 1) / num_chunks;
+            char *partial = partials_begin + i * partial_stride;
+            char *chunk_src = src0 + chunk_begin * src_stride;
+            init_child->single(partial, &chunk_src);
+            chunk_src += src_stride_first;
+            reduction_child->strided(partial, 0, &chunk_src, &src_stride, chunk_end - chunk_begin - skip);
+          }
+        });
+
+        char *partial = partials_begin;
+        if (first) {
+          memcpy(dst, partial, dst_data_size);
+          partial += partial_stride;
+          reduction_child->strided(dst, 0, &partial, &partial_stride, num_chunks - 1);
+        }
+        else {
+          reduction_child->strided(dst, 0, &partial, &partial_stride, num_chunks);
+        }
+      }
+
       void single_first(char *dst, char *const *src)
       {
+        if (num_workers > 1) {
+          parallel_reduce(dst, src[0], true);
+          return;
+        }
+
         char *src0 = src[0];
 
         // Initialize the dst values
@@ -389,6 +452,15 @@ namespace nd {
         ckernel_prefix *reduction_child = get_child();
 
         char *src0 = src[0];
+        if (num_workers > 1) {
+          for (size_t i = 0; i != count; ++i) {
+            parallel_reduce(dst, src0, i == 0 || dst_stride != 0);
+            dst += dst_stride;
+            src0 += src_stride[0];
+          }
+          return;
+        }
+
         if (dst_stride == 0) {
           // With a zero stride, we initialize "dst" once, then do many
           // accumulations
@@ -421,6 +493,16 @@ namespace nd {
       {
         ckernel_prefix *reduce_child = get_child();
 
+        if (num_workers > 1) {
+          char *src0 = src[0];
+          for (size_t i = 0; i != count; ++i) {
+            parallel_reduce(dst, src0, false);
+            dst += dst_stride;
+            src0 += src_stride[0];
+          }
+          return;
+        }
+
         // No initialization, all reduction
         char *src0 = src[0];
         for (size_t i = 0; i != count; ++i) {
@@ -439,7 +521,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -486,6 +568,23 @@ namespace nd {
         e = reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb)->get_at<reduction_kernel>(root_ckb_offset);
         e->init_offset = reinterpret_cast<data_type *>(data)->init_offset - root_ckb_offset;
 
+        // Reduce on several threads if the evaluation context allows it. The
+        // partial results are combined with the reduction itself, so this
+        // needs an accumulator of the same builtin type as the elements.
+        const ndt::type &dst_element_tp = reinterpret_cast<data_type *>(data)->keepdims
+                                              ? dst_tp.extended<ndt::fixed_dim_type>()->get_element_type()
+                                              : dst_tp;
+        if (ectx->num_threads != 1 && src0_element_tp.is_builtin() && dst_element_tp == src0_element_tp) {
+          intptr_t grain = std::max<intptr_t>(ectx->min_grain_size, 1);
+          int num_workers = eval::plan_workers(ectx, src_size, &e->pool, grain);
+          if (num_workers > 1) {
+            e->num_workers = num_workers;
+            // A few chunks per worker, to even out the load
+            e->num_chunks = std::min<intptr_t>(src_size / grain, 4 * num_workers);
+            e->dst_data_size = dst_element_tp.get_data_size();
+          }
+        }
+
         delete reinterpret_cast<data_type *>(data);
         return ckb_offset;
       }
@@ -569,7 +668,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::var_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(var_dim_type_arrmeta);
@@ -681,7 +780,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         intptr_t src_size = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size();
         intptr_t src_stride = src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_stride(src_arrmeta[0]);
@@ -809,7 +908,7 @@ namespace nd {
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
       {
         const ndt::type &src0_element_tp = src_tp[0].extended<ndt::base_dim_type>()->get_element_type();
         const char *src0_element_arrmeta = src_arrmeta[0] + sizeof(size_stride_t);
@@ -859,7 +958,7 @@ namespace nd {
                                                    const ndt::type *src_tp, const char *const *src_arrmeta,
                                                    kernel_request_t kernreq, const eval::eval_context *ectx,
                                                    intptr_t nkwd, const array *kwds,
-                                                   const std::map<std::string, ndt::type> &tp_vars)
+                                                   const ndt::typevar_map &tp_vars)
     {
       static const callable_instantiate_t table[2][2][2] = {
           {{reduction_kernel<fixed_dim_type_id, false, false>::instantiate,
@@ -56,7 +56,7 @@ namespace nd {
       };
 
       static char *data_init(char *_static_data, const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
-                             intptr_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                             intptr_t nkwd, const array *kwds, const ndt::typevar_map &tp_vars)
       {
         static_data_type *static_data = *reinterpret_cast<static_data_type **>(_static_data);
 
@@ -66,13 +66,13 @@ namespace nd {
 
       static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                    const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                   const std::map<std::string, ndt::type> &tp_vars);
+                                   const ndt::typevar_map &tp_vars);
 
       static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset,
                                   const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars);
+                                  const ndt::typevar_map &tp_vars);
     };
 
     typedef rolling_ck::static_data_type rolling_callable_data;
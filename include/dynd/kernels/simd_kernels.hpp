@@ -0,0 +1,112 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/kernels/base_kernel.hpp>
+
+namespace dynd {
+
+/**
+ * The instruction set extensions available to the vectorized kernels,
+ * in increasing order.
+ */
+enum simd_level_t { simd_level_none, simd_level_sse2, simd_level_avx2 };
+
+/**
+ * Returns the instruction set extensions the vectorized kernels currently use.
+ * This is the best level supported by the CPU, unless it has been lowered
+ * with ``set_simd_level``.
+ */
+DYND_API simd_level_t get_simd_level();
+
+/**
+ * Returns the best instruction set extensions supported by the CPU.
+ */
+DYND_API simd_level_t get_max_simd_level();
+
+/**
+ * Sets the instruction set extensions used by vectorized kernels instantiated
+ * from now on, clamped to what the CPU supports. Kernels that have already been
+ * instantiated (including any in the ckernel cache) are not affected.
+ */
+DYND_API void set_simd_level(simd_level_t level);
+
+namespace nd {
+  namespace detail {
+
+    enum simd_binary_op_t {
+      simd_add,
+      simd_subtract,
+      simd_multiply,
+      simd_divide,
+      simd_less,
+      simd_less_equal,
+      simd_equal,
+      simd_not_equal,
+      simd_greater_equal,
+      simd_greater,
+      simd_binary_op_count
+    };
+
+    /**
+     * A vectorized loop over contiguous operands of a builtin type. The
+     * destination type is the one of the corresponding scalar operation in
+     * C++, so for example adding two int8 produces int32, and comparisons
+     * produce bool1.
+     */
+    typedef void (*simd_binary_t)(char *dst, const char *src0, const char *src1, size_t count);
+
+    /**
+     * Returns the vectorized loop for the operation on two operands of the
+     * given builtin type at the current simd level, or NULL if there is none.
+     */
+    DYND_API simd_binary_t get_simd_binary(simd_binary_op_t op, type_id_t src_type_id);
+
+    enum simd_reduce_op_t { simd_reduce_sum, simd_reduce_min, simd_reduce_max, simd_reduce_op_count };
+
+    /**
+     * A loop reducing ``count`` contiguous values of a builtin type into the
+     * value at ``dst``, which has the same type. It keeps several independent
+     * accumulators so that the additions or comparisons can be vectorized and
+     * pipelined, and floating point sums are done pairwise over blocks.
+     */
+    typedef void (*simd_reduce_t)(char *dst, const char *src, size_t count);
+
+    /**
+     * Returns the reduction loop for the operation over values of the given
+     * builtin type at the current simd level, or NULL if there is none.
+     */
+    DYND_API simd_reduce_t get_simd_reduce(simd_reduce_op_t op, type_id_t src_type_id);
+
+    /**
+     * A base for binary kernels whose operands have the same type. The
+     * strided function uses the vectorized loop when the destination and both
+     * sources are contiguous, and otherwise calls ``single`` of the derived
+     * kernel for each element.
+     */
+    template <typename SelfType, type_id_t Src0TypeID, typename DstType, simd_binary_op_t Op>
+    struct contiguous_binary_kernel : base_kernel<SelfType, 2> {
+      typedef typename type_of<Src0TypeID>::type src0_type;
+
+      simd_binary_t contiguous;
+
+      contiguous_binary_kernel() : contiguous(get_simd_binary(Op, Src0TypeID)) {}
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        if (contiguous != NULL && dst_stride == sizeof(DstType) && src_stride[0] == sizeof(src0_type) &&
+            src_stride[1] == sizeof(src0_type)) {
+          contiguous(dst, src[0], src[1], count);
+        }
+        else {
+          base_kernel<SelfType, 2>::strided(dst, dst_stride, src, src_stride, count);
+        }
+      }
+    };
+
+  } // namespace dynd::nd::detail
+} // namespace dynd::nd
+} // namespace dynd
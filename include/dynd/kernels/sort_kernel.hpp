@@ -5,12 +5,408 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
 #include <dynd/bytes.hpp>
+#include <dynd/eval/thread_pool.hpp>
 #include <dynd/func/comparison.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/types/categorical_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /**
+     * Maps values of a builtin numeric type to unsigned integers with the same
+     * order, for radix sorting, along with the matching comparison. Floating
+     * point NaNs order after every other value, and -0.0 equals +0.0.
+     */
+    template <typename T, typename Enable = void>
+    struct sort_key;
+
+    template <typename T>
+    struct sort_key<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+      typedef typename std::make_unsigned<T>::type type;
+
+      static type get(T value)
+      {
+        // Flipping the sign bit puts negative values first
+        return std::is_signed<T>::value ? static_cast<type>(static_cast<type>(value) ^ (type(1) << (8 * sizeof(T) - 1)))
+                                        : static_cast<type>(value);
+      }
+
+      static bool less(T lhs, T rhs) { return lhs < rhs; }
+    };
+
+    template <typename T>
+    struct sort_key<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+      typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type type;
+
+      static type get(T value)
+      {
+        if (value != value) {
+          return ~type(0);
+        }
+        // -0.0 compares equal to +0.0, so it gets the same key
+        if (value == 0) {
+          value = 0;
+        }
+
+        type bits;
+        memcpy(&bits, &value, sizeof(T));
+        // Negative values are reversed, and positive ones go after them
+        const type sign = type(1) << (8 * sizeof(T) - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+      }
+
+      static bool less(T lhs, T rhs) { return lhs < rhs || (rhs != rhs && lhs == lhs); }
+    };
+
+    /**
+     * Sorts ``data`` with a least significant digit radix sort on bytes,
+     * moving the matching entries of ``payload`` along if it is not NULL.
+     * This is stable, takes ``sizeof(T)`` passes at most, and skips the
+     * passes over bytes which are the same in every value. The buffers must
+     * hold ``size`` entries.
+     */
+    template <typename T, typename P>
+    void radix_sort(T *data, T *data_buffer, P *payload, P *payload_buffer, size_t size)
+    {
+      typedef typename sort_key<T>::type key_type;
+      const size_t num_digits = sizeof(key_type);
+
+      size_t counts[num_digits * 256] = {};
+      for (size_t i = 0; i < size; ++i) {
+        key_type key = sort_key<T>::get(data[i]);
+        for (size_t d = 0; d < num_digits; ++d) {
+          ++counts[d * 256 + ((key >> (8 * d)) & 0xff)];
+        }
+      }
+
+      T *src = data, *dst = data_buffer;
+      P *payload_src = payload, *payload_dst = payload_buffer;
+      for (size_t d = 0; d < num_digits; ++d) {
+        size_t *digit_counts = &counts[d * 256];
+        if (digit_counts[(sort_key<T>::get(src[0]) >> (8 * d)) & 0xff] == size) {
+          continue;
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b) {
+          size_t count = digit_counts[b];
+          digit_counts[b] = offset;
+          offset += count;
+        }
+        for (size_t i = 0; i < size; ++i) {
+          size_t j = digit_counts[(sort_key<T>::get(src[i]) >> (8 * d)) & 0xff]++;
+          dst[j] = src[i];
+          if (payload != NULL) {
+            payload_dst[j] = payload_src[i];
+          }
+        }
+        std::swap(src, dst);
+        std::swap(payload_src, payload_dst);
+      }
+
+      if (src != data) {
+        memcpy(data, src, size * sizeof(T));
+        if (payload != NULL) {
+          memcpy(payload, payload_src, size * sizeof(P));
+        }
+      }
+    }
+
+    // Below this size, a comparison sort is faster than the radix passes
+    static const size_t radix_sort_min_size = 1024;
+
+    /**
+     * Stably sorts contiguous values of a builtin numeric type, using
+     * ``buffer``, which holds ``size`` values, as scratch space.
+     */
+    template <typename T>
+    void sort_values(T *data, T *buffer, size_t size)
+    {
+      if (size >= radix_sort_min_size) {
+        radix_sort<T, char>(data, buffer, NULL, NULL, size);
+      }
+      else {
+        std::stable_sort(data, data + size, &sort_key<T>::less);
+      }
+    }
+
+    /**
+     * Sorts contiguous values on several threads. The values are split into
+     * one run per worker, the runs are sorted concurrently, and then merged in
+     * pairs, concurrently within each round. ``buffer`` holds ``size`` values
+     * of scratch space.
+     */
+    template <typename T>
+    void parallel_sort_values(T *data, T *buffer, size_t size, eval::thread_pool &pool, int num_workers)
+    {
+      std::vector<size_t> bounds(num_workers + 1);
+      for (int i = 0; i <= num_workers; ++i) {
+        bounds[i] = size * i / num_workers;
+      }
+
+      pool.parallel_for(num_workers, num_workers, 1, [&](int DYND_UNUSED(worker), intptr_t begin, intptr_t end) {
+        for (intptr_t i = begin; i < end; ++i) {
+          sort_values(data + bounds[i], buffer + bounds[i], bounds[i + 1] - bounds[i]);
+        }
+      });
+
+      T *src = data, *dst = buffer;
+      for (int width = 1; width < num_workers; width *= 2) {
+        intptr_t num_pairs = (num_workers + 2 * width - 1) / (2 * width);
+        pool.parallel_for(num_workers, num_pairs, 1, [&](int DYND_UNUSED(worker), intptr_t begin, intptr_t end) {
+          for (intptr_t i = begin; i < end; ++i) {
+            size_t first = bounds[2 * i * width];
+            size_t middle = bounds[std::min<intptr_t>((2 * i + 1) * width, num_workers)];
+            size_t last = bounds[std::min<intptr_t>((2 * i + 2) * width, num_workers)];
+            std::merge(src + first, src + middle, src + middle, src + last, dst + first, &sort_key<T>::less);
+          }
+        });
+        std::swap(src, dst);
+      }
+
+      if (src != data) {
+        memcpy(data, src, size * sizeof(T));
+      }
+    }
+
+    /**
+     * Writes the indices which stably sort the values to ``indices``. The
+     * ``values`` scratch space holds ``size`` values, and when ``size`` is at
+     * least radix_sort_min_size, so do ``values_buffer`` and ``indices_buffer``.
+     */
+    template <typename T>
+    void argsort_values(const char *src, intptr_t src_stride, size_t size, int64_t *indices, T *values,
+                        T *values_buffer, int64_t *indices_buffer)
+    {
+      for (size_t i = 0; i < size; ++i) {
+        values[i] = *reinterpret_cast<const T *>(src + i * src_stride);
+        indices[i] = i;
+      }
+
+      if (size >= radix_sort_min_size) {
+        radix_sort(values, values_buffer, indices, indices_buffer, size);
+      }
+      else {
+        std::stable_sort(indices, indices + size,
+                         [values](int64_t lhs, int64_t rhs) { return sort_key<T>::less(values[lhs], values[rhs]); });
+      }
+    }
+
+    /**
+     * Sorts a fixed dimension of a builtin numeric type in place, working
+     * directly on the values instead of calling a comparison kernel. The
+     * scratch space is allocated once, with the kernel.
+     */
+    template <typename T>
+    struct typed_sort_kernel : base_kernel<typed_sort_kernel<T>, 1> {
+      static const size_t data_size = 0;
+
+      const intptr_t src0_size;
+      const intptr_t src0_stride;
+      // When num_workers > 1, the sort runs on the thread pool
+      int num_workers;
+      eval::thread_pool *pool;
+      std::vector<T> buffer;
+      // The gathered values of a strided dimension
+      std::vector<T> values;
+
+      typed_sort_kernel(intptr_t src0_size, intptr_t src0_stride)
+          : src0_size(src0_size), src0_stride(src0_stride), num_workers(1), pool(NULL), buffer(src0_size),
+            values(src0_stride == sizeof(T) ? 0 : src0_size)
+      {
+      }
+
+      void sort(T *data)
+      {
+        if (num_workers > 1) {
+          parallel_sort_values(data, buffer.data(), src0_size, *pool, num_workers);
+        }
+        else {
+          sort_values(data, buffer.data(), src0_size);
+        }
+      }
+
+      void single(char *DYND_UNUSED(dst), char *const *src)
+      {
+        if (src0_stride == sizeof(T)) {
+          sort(reinterpret_cast<T *>(src[0]));
+          return;
+        }
+
+        // Gather strided values, sort them, and scatter them back
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          values[i] = *reinterpret_cast<const T *>(src[0] + i * src0_stride);
+        }
+        sort(values.data());
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          *reinterpret_cast<T *>(src[0] + i * src0_stride) = values[i];
+        }
+      }
+    };
+
+    /**
+     * Writes the indices which stably sort a fixed dimension of a builtin
+     * numeric type.
+     */
+    template <typename T>
+    struct typed_argsort_kernel : base_kernel<typed_argsort_kernel<T>, 1> {
+      static const size_t data_size = 0;
+
+      const intptr_t dst_stride;
+      const intptr_t src0_size;
+      const intptr_t src0_stride;
+      // Scratch space, allocated once with the kernel
+      std::vector<T> values;
+      std::vector<T> values_buffer;
+      std::vector<int64_t> indices_buffer;
+      // The indices of a strided destination
+      std::vector<int64_t> indices;
+
+      typed_argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride)
+          : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), values(src0_size),
+            values_buffer(static_cast<size_t>(src0_size) >= radix_sort_min_size ? src0_size : 0),
+            indices_buffer(values_buffer.size()), indices(dst_stride == sizeof(int64_t) ? 0 : src0_size)
+      {
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        if (dst_stride == sizeof(int64_t)) {
+          argsort_values<T>(src[0], src0_stride, src0_size, reinterpret_cast<int64_t *>(dst), values.data(),
+                            values_buffer.data(), indices_buffer.data());
+          return;
+        }
+
+        argsort_values<T>(src[0], src0_stride, src0_size, indices.data(), values.data(), values_buffer.data(),
+                          indices_buffer.data());
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          *reinterpret_cast<int64_t *>(dst + i * dst_stride) = indices[i];
+        }
+      }
+    };
+
+    /**
+     * Holds the rank of each code of a categorical type, which is the
+     * position of its category in sorted order, so categorical values can be
+     * counting sorted on their codes without comparing the categories. Codes
+     * outside the categories rank last.
+     */
+    template <typename UIntType>
+    struct categorical_ranks {
+      std::vector<UIntType> rank_to_code;
+      std::vector<uint32_t> code_to_rank;
+
+      categorical_ranks(const ndt::type &tp)
+      {
+        const ndt::categorical_type *cat_tp = tp.extended<ndt::categorical_type>();
+        size_t count = cat_tp->get_category_count();
+        rank_to_code.resize(count);
+        code_to_rank.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+          uint32_t code = cat_tp->get_value_from_category_index(i);
+          rank_to_code[i] = static_cast<UIntType>(code);
+          code_to_rank[code] = static_cast<uint32_t>(i);
+        }
+      }
+
+      size_t size() const { return rank_to_code.size(); }
+
+      size_t get(UIntType code) const { return code < code_to_rank.size() ? code_to_rank[code] : size(); }
+    };
+
+    /**
+     * Sorts a fixed dimension of a categorical type in place by counting the
+     * codes, so the sort is linear in the dimension size.
+     */
+    template <typename UIntType>
+    struct categorical_sort_kernel : base_kernel<categorical_sort_kernel<UIntType>, 1> {
+      static const size_t data_size = 0;
+
+      const intptr_t src0_size;
+      const intptr_t src0_stride;
+      const categorical_ranks<UIntType> ranks;
+
+      categorical_sort_kernel(intptr_t src0_size, intptr_t src0_stride, const ndt::type &src0_element_tp)
+          : src0_size(src0_size), src0_stride(src0_stride), ranks(src0_element_tp)
+      {
+      }
+
+      void single(char *DYND_UNUSED(dst), char *const *src)
+      {
+        std::vector<size_t> counts(ranks.size());
+        std::vector<UIntType> invalid_codes;
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          UIntType code = *reinterpret_cast<const UIntType *>(src[0] + i * src0_stride);
+          size_t rank = ranks.get(code);
+          if (rank < ranks.size()) {
+            ++counts[rank];
+          }
+          else {
+            invalid_codes.push_back(code);
+          }
+        }
+
+        char *dst = src[0];
+        for (size_t rank = 0; rank < ranks.size(); ++rank) {
+          for (size_t j = 0; j < counts[rank]; ++j, dst += src0_stride) {
+            *reinterpret_cast<UIntType *>(dst) = ranks.rank_to_code[rank];
+          }
+        }
+        for (size_t j = 0; j < invalid_codes.size(); ++j, dst += src0_stride) {
+          *reinterpret_cast<UIntType *>(dst) = invalid_codes[j];
+        }
+      }
+    };
+
+    /**
+     * Writes the indices which stably sort a fixed dimension of a categorical
+     * type, with a counting sort on the codes.
+     */
+    template <typename UIntType>
+    struct categorical_argsort_kernel : base_kernel<categorical_argsort_kernel<UIntType>, 1> {
+      static const size_t data_size = 0;
+
+      const intptr_t dst_stride;
+      const intptr_t src0_size;
+      const intptr_t src0_stride;
+      const categorical_ranks<UIntType> ranks;
+
+      categorical_argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride,
+                                 const ndt::type &src0_element_tp)
+          : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride), ranks(src0_element_tp)
+      {
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        // One bucket per category, and a last one for invalid codes
+        std::vector<size_t> offsets(ranks.size() + 1);
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          ++offsets[ranks.get(*reinterpret_cast<const UIntType *>(src[0] + i * src0_stride))];
+        }
+        size_t offset = 0;
+        for (size_t rank = 0; rank < offsets.size(); ++rank) {
+          size_t count = offsets[rank];
+          offsets[rank] = offset;
+          offset += count;
+        }
+
+        for (intptr_t i = 0; i < src0_size; ++i) {
+          size_t j = offsets[ranks.get(*reinterpret_cast<const UIntType *>(src[0] + i * src0_stride))]++;
+          *reinterpret_cast<int64_t *>(dst + j * dst_stride) = i;
+        }
+      }
+    };
+
+  } // namespace dynd::nd::detail
 
   struct sort_kernel : base_kernel<sort_kernel, 1> {
     static const size_t data_size = 0;
@@ -42,16 +438,188 @@ namespace nd {
       });
     }
 
+    template <typename T>
+    static intptr_t instantiate_typed(void *ckb, kernel_request_t kernreq, intptr_t ckb_offset, intptr_t src0_size,
+                                      intptr_t src0_stride, const eval::eval_context *ectx)
+    {
+      intptr_t root_ckb_offset = ckb_offset;
+      detail::typed_sort_kernel<T>::make(ckb, kernreq, ckb_offset, src0_size, src0_stride);
+
+      // Large sorts are split across the thread pool if the evaluation context allows it
+      detail::typed_sort_kernel<T> *self = detail::typed_sort_kernel<T>::get_self(
+          reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb), root_ckb_offset);
+      self->num_workers = eval::plan_workers(ectx, src0_size, &self->pool);
+
+      return ckb_offset;
+    }
+
     static intptr_t instantiate(char *DYND_UNUSED(static_data), char *data, void *ckb, intptr_t ckb_offset,
                                 const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const ndt::typevar_map &tp_vars)
     {
       const ndt::type &src0_element_tp = src_tp[0].template extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t src0_size = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size;
+      intptr_t src0_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride;
+
+      switch (src0_element_tp.get_type_id()) {
+      case int8_type_id:
+        return instantiate_typed<int8_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case int16_type_id:
+        return instantiate_typed<int16_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case int32_type_id:
+        return instantiate_typed<int32_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case int64_type_id:
+        return instantiate_typed<int64_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case uint8_type_id:
+        return instantiate_typed<uint8_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case uint16_type_id:
+        return instantiate_typed<uint16_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case uint32_type_id:
+        return instantiate_typed<uint32_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case uint64_type_id:
+        return instantiate_typed<uint64_t>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case float32_type_id:
+        return instantiate_typed<float>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case float64_type_id:
+        return instantiate_typed<double>(ckb, kernreq, ckb_offset, src0_size, src0_stride, ectx);
+      case categorical_type_id:
+        switch (src0_element_tp.extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+        case uint8_type_id:
+          detail::categorical_sort_kernel<uint8_t>::make(ckb, kernreq, ckb_offset, src0_size, src0_stride,
+                                                         src0_element_tp);
+          return ckb_offset;
+        case uint16_type_id:
+          detail::categorical_sort_kernel<uint16_t>::make(ckb, kernreq, ckb_offset, src0_size, src0_stride,
+                                                          src0_element_tp);
+          return ckb_offset;
+        default:
+          detail::categorical_sort_kernel<uint32_t>::make(ckb, kernreq, ckb_offset, src0_size, src0_stride,
+                                                          src0_element_tp);
+          return ckb_offset;
+        }
+      default:
+        break;
+      }
+
+      make(ckb, kernreq, ckb_offset, src0_size, src0_stride, src0_element_tp.get_data_size());
+
+      const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
+      const callable &less = nd::less;
+      return less.get()->instantiate(less.get()->static_data(), data, ckb, ckb_offset, ndt::type::make<bool1>(), NULL, 2,
+                                     child_src_tp, NULL, kernel_request_single, ectx, nkwd, kwds, tp_vars);
+    }
+  };
+
+  /**
+   * Writes the indices which stably sort a fixed dimension, using the ``less``
+   * comparison for types other than builtin numeric ones.
+   */
+  struct argsort_kernel : base_kernel<argsort_kernel, 1> {
+    static const size_t data_size = 0;
+
+    const intptr_t dst_stride;
+    const intptr_t src0_size;
+    const intptr_t src0_stride;
+
+    argsort_kernel(intptr_t dst_stride, intptr_t src0_size, intptr_t src0_stride)
+        : dst_stride(dst_stride), src0_size(src0_size), src0_stride(src0_stride)
+    {
+    }
 
-      make(ckb, kernreq, ckb_offset, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-           reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, src0_element_tp.get_data_size());
+    ~argsort_kernel() { get_child()->destroy(); }
+
+    void single(char *dst, char *const *src)
+    {
+      ckernel_prefix *child = get_child();
+      char *src0 = src[0];
+      intptr_t stride = src0_stride;
+
+      std::vector<int64_t> indices(src0_size);
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        indices[i] = i;
+      }
+      std::stable_sort(indices.begin(), indices.end(), [child, src0, stride](int64_t lhs, int64_t rhs) {
+        bool1 dst;
+        char *src[2] = {src0 + lhs * stride, src0 + rhs * stride};
+        child->single(reinterpret_cast<char *>(&dst), src);
+        return dst;
+      });
+
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        *reinterpret_cast<int64_t *>(dst + i * dst_stride) = indices[i];
+      }
+    }
+
+    static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
+                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
+                                 const array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+    {
+      dst_tp = ndt::make_fixed_dim(src_tp[0].extended<ndt::fixed_dim_type>()->get_fixed_dim_size(),
+                                   ndt::type::make<int64_t>());
+    }
+
+    template <typename T>
+    static intptr_t instantiate_typed(void *ckb, kernel_request_t kernreq, intptr_t ckb_offset, intptr_t dst_stride,
+                                      intptr_t src0_size, intptr_t src0_stride)
+    {
+      detail::typed_argsort_kernel<T>::make(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      return ckb_offset;
+    }
+
+    static intptr_t instantiate(char *DYND_UNUSED(static_data), char *data, void *ckb, intptr_t ckb_offset,
+                                const ndt::type &DYND_UNUSED(dst_tp), const char *dst_arrmeta,
+                                intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
+                                kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
+                                const nd::array *kwds, const ndt::typevar_map &tp_vars)
+    {
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      intptr_t dst_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta)->stride;
+      intptr_t src0_size = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size;
+      intptr_t src0_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride;
+
+      switch (src0_element_tp.get_type_id()) {
+      case int8_type_id:
+        return instantiate_typed<int8_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case int16_type_id:
+        return instantiate_typed<int16_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case int32_type_id:
+        return instantiate_typed<int32_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case int64_type_id:
+        return instantiate_typed<int64_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case uint8_type_id:
+        return instantiate_typed<uint8_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case uint16_type_id:
+        return instantiate_typed<uint16_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case uint32_type_id:
+        return instantiate_typed<uint32_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case uint64_type_id:
+        return instantiate_typed<uint64_t>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case float32_type_id:
+        return instantiate_typed<float>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case float64_type_id:
+        return instantiate_typed<double>(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
+      case categorical_type_id:
+        switch (src0_element_tp.extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+        case uint8_type_id:
+          detail::categorical_argsort_kernel<uint8_t>::make(ckb, kernreq, ckb_offset, dst_stride, src0_size,
+                                                            src0_stride, src0_element_tp);
+          return ckb_offset;
+        case uint16_type_id:
+          detail::categorical_argsort_kernel<uint16_t>::make(ckb, kernreq, ckb_offset, dst_stride, src0_size,
+                                                             src0_stride, src0_element_tp);
+          return ckb_offset;
+        default:
+          detail::categorical_argsort_kernel<uint32_t>::make(ckb, kernreq, ckb_offset, dst_stride, src0_size,
+                                                             src0_stride, src0_element_tp);
+          return ckb_offset;
+        }
+      default:
+        break;
+      }
+
+      make(ckb, kernreq, ckb_offset, dst_stride, src0_size, src0_stride);
 
       const ndt::type child_src_tp[2] = {src0_element_tp, src0_element_tp};
       const callable &less = nd::less;
@@ -72,5 +640,10 @@ namespace ndt {
     }
   };
 
+  template <>
+  struct type::equivalent<nd::argsort_kernel> {
+    static type make() { return callable_type::make(type("Fixed * int64"), {type("Fixed * Scalar")}); }
+  };
+
 } // namespace dynd::ndt
 } // namespace dynd
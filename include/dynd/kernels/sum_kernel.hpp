@@ -5,10 +5,39 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    /**
+     * Sums ``count >= 1`` strided values by pairwise summation, splitting the
+     * range in halves down to blocks which are summed directly. The rounding
+     * error grows with the logarithm of ``count`` instead of linearly, at
+     * about the cost of the plain loop.
+     */
+    template <typename T>
+    T pairwise_sum(const char *src, intptr_t src_stride, size_t count)
+    {
+      if (count <= 128) {
+        T res = *reinterpret_cast<const T *>(src);
+        for (size_t i = 1; i < count; ++i) {
+          src += src_stride;
+          res = res + *reinterpret_cast<const T *>(src);
+        }
+        return res;
+      }
+
+      size_t half = count / 2;
+      return pairwise_sum<T>(src, src_stride, half) +
+             pairwise_sum<T>(src + half * src_stride, src_stride, count - half);
+    }
+
+  } // namespace dynd::nd::detail
 
   template <type_id_t Src0TypeID>
   struct DYND_API sum_kernel : base_kernel<sum_kernel<Src0TypeID>, 1> {
@@ -19,6 +48,11 @@ namespace nd {
 
     static const std::size_t data_size = 0;
 
+    // Reduces contiguous values into a single destination
+    detail::simd_reduce_t contiguous;
+
+    sum_kernel() : contiguous(detail::get_simd_reduce(detail::simd_reduce_sum, Src0TypeID)) {}
+
     void single(char *dst, char *const *src)
     {
       *reinterpret_cast<dst_type *>(dst) =
@@ -31,6 +65,20 @@ namespace nd {
     {
       char *src0 = src[0];
       intptr_t src0_stride = src_stride[0];
+      if (contiguous != NULL && dst_stride == 0 && src0_stride == sizeof(src0_type)) {
+        contiguous(dst, src0, count);
+        return;
+      }
+
+      if (std::is_floating_point<src0_type>::value && dst_stride == 0) {
+        // Reducing into one value, use pairwise summation for accuracy
+        if (count != 0) {
+          *reinterpret_cast<dst_type *>(dst) =
+              *reinterpret_cast<dst_type *>(dst) + detail::pairwise_sum<src0_type>(src0, src0_stride, count);
+        }
+        return;
+      }
+
       for (size_t i = 0; i < count; ++i) {
         *reinterpret_cast<dst_type *>(dst) =
             *reinterpret_cast<dst_type *>(dst) +
@@ -27,7 +27,7 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars);
+                                const ndt::typevar_map &tp_vars);
   };
 
   /**
@@ -49,19 +49,19 @@ namespace nd {
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars);
+                                const ndt::typevar_map &tp_vars);
   };
 
   struct DYND_API take_ck : base_virtual_kernel<take_ck> {
     static void resolve_dst_type(char *static_data, char *data, ndt::type &dst_tp, intptr_t nsrc,
                                  const ndt::type *src_tp, intptr_t nkwd, const array *kwds,
-                                 const std::map<std::string, ndt::type> &tp_vars);
+                                 const ndt::typevar_map &tp_vars);
 
     static intptr_t instantiate(char *static_data, char *data, void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
                                 const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
                                 const char *const *src_arrmeta, kernel_request_t kernreq,
                                 const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                const std::map<std::string, ndt::type> &tp_vars);
+                                const ndt::typevar_map &tp_vars);
   };
 
 } // namespace dynd::nd
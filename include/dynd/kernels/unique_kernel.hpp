@@ -5,12 +5,504 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
 #include <dynd/bytes.hpp>
+#include <dynd/string.hpp>
+#include <dynd/eval/thread_pool.hpp>
+#include <dynd/func/comparison.hpp>
 #include <dynd/kernels/base_kernel.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/struct_type.hpp>
 
 namespace dynd {
 namespace nd {
+  namespace detail {
+
+    inline size_t hash_mix(uint64_t value)
+    {
+      // The finalizer of splitmix64
+      value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+      return static_cast<size_t>(value ^ (value >> 31));
+    }
+
+    /**
+     * Hashing, equality and copying of the elements of a builtin numeric
+     * type, or of ``string``. Floating point values which compare equal
+     * hash the same, and all NaNs count as one value.
+     */
+    template <typename T>
+    struct hash_key {
+      static size_t hash(const char *data)
+      {
+        T value = *reinterpret_cast<const T *>(data);
+        if (value != value) {
+          return 0;
+        }
+        if (value == 0) {
+          // Make -0.0 hash the same as 0.0
+          value = 0;
+        }
+
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(T));
+        return hash_mix(bits);
+      }
+
+      static bool equal(const char *lhs, const char *rhs)
+      {
+        T lhs_value = *reinterpret_cast<const T *>(lhs), rhs_value = *reinterpret_cast<const T *>(rhs);
+        return lhs_value == rhs_value || (lhs_value != lhs_value && rhs_value != rhs_value);
+      }
+
+      static void copy(char *dst, const char *src) { *reinterpret_cast<T *>(dst) = *reinterpret_cast<const T *>(src); }
+    };
+
+    template <>
+    struct hash_key<string> {
+      static size_t hash(const char *data)
+      {
+        const string &value = *reinterpret_cast<const string *>(data);
+        const char *begin = value.data();
+        size_t size = value.size();
+
+        uint64_t res = size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+          uint64_t word;
+          memcpy(&word, begin + i, 8);
+          res = hash_mix(res ^ word);
+        }
+        if (i < size) {
+          uint64_t word = 0;
+          memcpy(&word, begin + i, size - i);
+          res = hash_mix(res ^ word);
+        }
+        return static_cast<size_t>(res);
+      }
+
+      static bool equal(const char *lhs, const char *rhs)
+      {
+        return *reinterpret_cast<const string *>(lhs) == *reinterpret_cast<const string *>(rhs);
+      }
+
+      static void copy(char *dst, const char *src)
+      {
+        *reinterpret_cast<string *>(dst) = *reinterpret_cast<const string *>(src);
+      }
+    };
+
+    /**
+     * The number of times a value occurs, and the index where it first does.
+     */
+    struct value_count {
+      intptr_t first_index;
+      int64_t count;
+    };
+
+    /**
+     * An open addressing hash table from the elements of a strided dimension
+     * to their counts, with linear probing. The table stores indices into the
+     * dimension rather than the values themselves.
+     */
+    template <typename T>
+    class value_count_table {
+      struct slot {
+        size_t hash;
+        value_count value;
+      };
+
+      const char *m_data;
+      intptr_t m_stride;
+      std::vector<slot> m_slots;
+      size_t m_mask;
+      size_t m_size;
+
+      void grow()
+      {
+        std::vector<slot> old_slots(2 * m_slots.size());
+        old_slots.swap(m_slots);
+        m_mask = m_slots.size() - 1;
+        for (slot &s : m_slots) {
+          s.value.first_index = -1;
+        }
+        for (const slot &s : old_slots) {
+          if (s.value.first_index >= 0) {
+            size_t j = s.hash & m_mask;
+            while (m_slots[j].value.first_index >= 0) {
+              j = (j + 1) & m_mask;
+            }
+            m_slots[j] = s;
+          }
+        }
+      }
+
+    public:
+      value_count_table(const char *data, intptr_t stride)
+          : m_data(data), m_stride(stride), m_slots(16), m_mask(15), m_size(0)
+      {
+        for (slot &s : m_slots) {
+          s.value.first_index = -1;
+        }
+      }
+
+      /** Adds ``count`` occurrences of the element at ``index``. */
+      void add(intptr_t index, int64_t count = 1)
+      {
+        const char *value = m_data + index * m_stride;
+        size_t hash = hash_key<T>::hash(value);
+        size_t j = hash & m_mask;
+        for (;;) {
+          slot &s = m_slots[j];
+          if (s.value.first_index < 0) {
+            break;
+          }
+          if (s.hash == hash && hash_key<T>::equal(m_data + s.value.first_index * m_stride, value)) {
+            s.value.first_index = std::min(s.value.first_index, index);
+            s.value.count += count;
+            return;
+          }
+          j = (j + 1) & m_mask;
+        }
+
+        m_slots[j].hash = hash;
+        m_slots[j].value.first_index = index;
+        m_slots[j].value.count = count;
+        // Keep the load factor at most one half
+        if (2 * ++m_size > m_slots.size()) {
+          grow();
+        }
+      }
+
+      /** Adds the counts of another table over the same dimension. */
+      void merge(const value_count_table &other)
+      {
+        for (const slot &s : other.m_slots) {
+          if (s.value.first_index >= 0) {
+            add(s.value.first_index, s.value.count);
+          }
+        }
+      }
+
+      /** Appends the counts to ``res``, in no particular order. */
+      void get_counts(std::vector<value_count> &res) const
+      {
+        for (const slot &s : m_slots) {
+          if (s.value.first_index >= 0) {
+            res.push_back(s.value);
+          }
+        }
+      }
+    };
+
+    /**
+     * Counts the distinct values of a strided dimension, in expected linear
+     * time, and returns them in the order in which they first occur. With
+     * several workers, each thread counts into its own table, and the tables
+     * are merged at the end.
+     */
+    template <typename T>
+    std::vector<value_count> count_values(const char *data, intptr_t stride, intptr_t size, eval::thread_pool *pool,
+                                          int num_workers)
+    {
+      std::vector<value_count_table<T>> tables(num_workers, value_count_table<T>(data, stride));
+      if (num_workers > 1) {
+        pool->parallel_for(num_workers, size, size / num_workers / 4 + 1, [&](int worker, intptr_t begin, intptr_t end) {
+          for (intptr_t i = begin; i < end; ++i) {
+            tables[worker].add(i);
+          }
+        });
+        for (int i = 1; i < num_workers; ++i) {
+          tables[0].merge(tables[i]);
+        }
+      }
+      else {
+        for (intptr_t i = 0; i < size; ++i) {
+          tables[0].add(i);
+        }
+      }
+
+      std::vector<value_count> res;
+      tables[0].get_counts(res);
+      std::sort(res.begin(), res.end(),
+                [](const value_count &lhs, const value_count &rhs) { return lhs.first_index < rhs.first_index; });
+      return res;
+    }
+
+    /**
+     * Counts the values of a strided dimension of unsigned integers with at
+     * most 16 bits, such as the codes of a categorical type, in a table
+     * indexed directly by value rather than a hash table. The result matches
+     * ``count_values``.
+     */
+    template <typename UIntType>
+    std::vector<value_count> count_codes(const char *data, intptr_t stride, intptr_t size, eval::thread_pool *pool,
+                                         int num_workers)
+    {
+      const size_t table_size = static_cast<size_t>(1) << (8 * sizeof(UIntType));
+      std::vector<std::vector<value_count>> tables(num_workers,
+                                                   std::vector<value_count>(table_size, value_count{-1, 0}));
+      auto count = [&](int worker, intptr_t begin, intptr_t end) {
+        value_count *table = tables[worker].data();
+        for (intptr_t i = begin; i < end; ++i) {
+          value_count &c = table[*reinterpret_cast<const UIntType *>(data + i * stride)];
+          // A worker may be given its ranges in any order
+          if (c.count++ == 0 || i < c.first_index) {
+            c.first_index = i;
+          }
+        }
+      };
+      if (num_workers > 1) {
+        pool->parallel_for(num_workers, size, size / num_workers / 4 + 1, count);
+        for (int i = 1; i < num_workers; ++i) {
+          for (size_t j = 0; j < table_size; ++j) {
+            const value_count &c = tables[i][j];
+            value_count &res = tables[0][j];
+            if (c.count != 0 && (res.count == 0 || c.first_index < res.first_index)) {
+              res.first_index = c.first_index;
+            }
+            res.count += c.count;
+          }
+        }
+      }
+      else {
+        count(0, 0, size);
+      }
+
+      std::vector<value_count> res;
+      for (const value_count &c : tables[0]) {
+        if (c.count != 0) {
+          res.push_back(c);
+        }
+      }
+      std::sort(res.begin(), res.end(),
+                [](const value_count &lhs, const value_count &rhs) { return lhs.first_index < rhs.first_index; });
+      return res;
+    }
+
+    /**
+     * Assigns each element of a strided dimension a code, which is the
+     * position of its value among the distinct values in order of first
+     * occurrence, using an open addressing hash table with linear probing.
+     * The index of the first occurrence of each distinct value is appended
+     * to ``first_indices``.
+     */
+    template <typename T>
+    void encode_values(const char *data, intptr_t stride, intptr_t size, uint32_t *codes,
+                       std::vector<intptr_t> &first_indices)
+    {
+      struct slot {
+        size_t hash;
+        intptr_t code;
+      };
+
+      std::vector<slot> slots(16, slot{0, -1});
+      size_t mask = slots.size() - 1;
+      for (intptr_t i = 0; i < size; ++i) {
+        const char *value = data + i * stride;
+        size_t hash = hash_key<T>::hash(value);
+        size_t j = hash & mask;
+        for (;;) {
+          const slot &s = slots[j];
+          if (s.code < 0 || (s.hash == hash && hash_key<T>::equal(data + first_indices[s.code] * stride, value))) {
+            break;
+          }
+          j = (j + 1) & mask;
+        }
+        if (slots[j].code >= 0) {
+          codes[i] = static_cast<uint32_t>(slots[j].code);
+          continue;
+        }
+
+        if (first_indices.size() > std::numeric_limits<uint32_t>::max()) {
+          throw std::overflow_error("too many distinct values to encode as uint32 codes");
+        }
+        slots[j].hash = hash;
+        slots[j].code = first_indices.size();
+        codes[i] = static_cast<uint32_t>(first_indices.size());
+        first_indices.push_back(i);
+        // Keep the load factor at most one half
+        if (2 * first_indices.size() > slots.size()) {
+          std::vector<slot> old_slots(2 * slots.size(), slot{0, -1});
+          old_slots.swap(slots);
+          mask = slots.size() - 1;
+          for (const slot &s : old_slots) {
+            if (s.code >= 0) {
+              size_t k = s.hash & mask;
+              while (slots[k].code >= 0) {
+                k = (k + 1) & mask;
+              }
+              slots[k] = s;
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * The state shared by the hash based kernels: the dimension being
+     * counted, and the threads to count it on.
+     */
+    struct hash_kernel_params {
+      intptr_t src0_size;
+      intptr_t src0_stride;
+      int num_workers;
+      eval::thread_pool *pool;
+
+      hash_kernel_params(intptr_t src0_size, intptr_t src0_stride, const eval::eval_context *ectx)
+          : src0_size(src0_size), src0_stride(src0_stride), num_workers(1), pool(NULL)
+      {
+        num_workers = eval::plan_workers(ectx, src0_size, &pool);
+      }
+    };
+
+    /**
+     * The hash based operations on the values of one type.
+     */
+    struct hash_functions {
+      std::vector<value_count> (*count_values)(const char *data, intptr_t stride, intptr_t size,
+                                               eval::thread_pool *pool, int num_workers);
+      void (*copy)(char *dst, const char *src);
+      void (*encode)(const char *data, intptr_t stride, intptr_t size, uint32_t *codes,
+                     std::vector<intptr_t> &first_indices);
+
+      template <typename T>
+      static hash_functions make()
+      {
+        return hash_functions{&detail::count_values<T>, &hash_key<T>::copy, &detail::encode_values<T>};
+      }
+    };
+
+    /**
+     * Gets the hash based operations for a type, returning false if the
+     * values of the type cannot be hashed.
+     */
+    inline bool get_hash_functions(type_id_t tp_id, hash_functions &res)
+    {
+      switch (tp_id) {
+      case bool_type_id:
+        // A bool1 is a byte holding 0 or 1
+        res = hash_functions::make<uint8_t>();
+        return true;
+      case int8_type_id:
+        res = hash_functions::make<int8_t>();
+        return true;
+      case int16_type_id:
+        res = hash_functions::make<int16_t>();
+        return true;
+      case int32_type_id:
+        res = hash_functions::make<int32_t>();
+        return true;
+      case int64_type_id:
+        res = hash_functions::make<int64_t>();
+        return true;
+      case uint8_type_id:
+        res = hash_functions::make<uint8_t>();
+        return true;
+      case uint16_type_id:
+        res = hash_functions::make<uint16_t>();
+        return true;
+      case uint32_type_id:
+        res = hash_functions::make<uint32_t>();
+        return true;
+      case uint64_type_id:
+        res = hash_functions::make<uint64_t>();
+        return true;
+      case float32_type_id:
+        res = hash_functions::make<float>();
+        return true;
+      case float64_type_id:
+        res = hash_functions::make<double>();
+        return true;
+      case string_type_id:
+        res = hash_functions::make<string>();
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    /**
+     * Gets the hash based operations for the values of a type. Categorical
+     * values are handled through their integer codes, which are counted
+     * with a direct lookup table when they have at most 16 bits.
+     */
+    inline bool get_hash_functions(const ndt::type &tp, hash_functions &res)
+    {
+      if (tp.get_type_id() != categorical_type_id) {
+        return get_hash_functions(tp.get_type_id(), res);
+      }
+
+      switch (tp.extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+      case uint8_type_id:
+        res = hash_functions::make<uint8_t>();
+        res.count_values = &count_codes<uint8_t>;
+        return true;
+      case uint16_type_id:
+        res = hash_functions::make<uint16_t>();
+        res.count_values = &count_codes<uint16_t>;
+        return true;
+      case uint32_type_id:
+        res = hash_functions::make<uint32_t>();
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    /**
+     * Removes the repeated values of a fixed dimension in place with a hash
+     * table, keeping the first occurrence of each in order.
+     */
+    struct hash_unique_kernel : base_kernel<hash_unique_kernel> {
+      static const size_t data_size = 0;
+
+      hash_kernel_params params;
+      hash_functions functions;
+
+      hash_unique_kernel(const hash_kernel_params &params, const hash_functions &functions)
+          : params(params), functions(functions)
+      {
+      }
+
+      void single(array *DYND_UNUSED(dst), array *const *src)
+      {
+        char *data = src[0]->data();
+        std::vector<value_count> counts =
+            functions.count_values(data, params.src0_stride, params.src0_size, params.pool, params.num_workers);
+
+        // Every first index is at least its position in the result, so this
+        // only overwrites values which have already been moved or dropped
+        intptr_t new_size = counts.size();
+        for (intptr_t i = 0; i < new_size; ++i) {
+          if (counts[i].first_index != i) {
+            functions.copy(data + i * params.src0_stride, data + counts[i].first_index * params.src0_stride);
+          }
+        }
 
+        src[0]->get()->tp =
+            ndt::make_fixed_dim(new_size, src[0]->get()->tp.extended<ndt::fixed_dim_type>()->get_element_type());
+        reinterpret_cast<size_stride_t *>(src[0]->get()->metadata())->dim_size = new_size;
+      }
+    };
+
+  } // namespace dynd::nd::detail
+
+  /**
+   * Removes the repeated values of a fixed dimension in place. Builtin
+   * numeric, string and categorical values are found with a hash table, so
+   * the input need not be sorted, and the first occurrence of each value is
+   * kept in order.
+   * Other types compare each value with the distinct values kept so far
+   * using ``nd::equal``, which gives the same result in time quadratic in
+   * the number of distinct values.
+   */
   struct unique_kernel : base_kernel<unique_kernel> {
     static const size_t data_size = 0;
 
@@ -28,17 +520,24 @@ namespace nd {
     void single(array *DYND_UNUSED(dst), array *const *src)
     {
       ckernel_prefix *child = get_child();
-      size_t new_size =
-          (std::unique(strided_iterator(src[0]->data(), src0_element_data_size, src0_stride),
-                       strided_iterator(src[0]->data() + src0_size * src0_stride, src0_element_data_size, src0_stride),
-                       [child](char *lhs, char *rhs) {
-                         bool1 dst;
-                         char *src[2] = {lhs, rhs};
-                         child->single(reinterpret_cast<char *>(&dst), src);
-                         return dst;
-                       }) -
-           src[0]->data()) /
-          src0_stride;
+      char *data = src[0]->data();
+      intptr_t new_size = 0;
+      for (intptr_t i = 0; i < src0_size; ++i) {
+        char *value = data + i * src0_stride;
+        bool repeated = false;
+        for (intptr_t j = 0; j < new_size && !repeated; ++j) {
+          bool1 equal;
+          char *equal_src[2] = {data + j * src0_stride, value};
+          child->single(reinterpret_cast<char *>(&equal), equal_src);
+          repeated = equal;
+        }
+        if (!repeated) {
+          if (new_size != i) {
+            memcpy(data + new_size * src0_stride, value, src0_element_data_size);
+          }
+          ++new_size;
+        }
+      }
 
       src[0]->get()->tp =
           ndt::make_fixed_dim(new_size, src[0]->get()->tp.extended<ndt::fixed_dim_type>()->get_element_type());
@@ -49,11 +548,20 @@ namespace nd {
                                 const ndt::type &DYND_UNUSED(dst_tp), const char *DYND_UNUSED(dst_arrmeta),
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                 kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd,
-                                const nd::array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                const nd::array *kwds, const ndt::typevar_map &tp_vars)
     {
       const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
-      make(ckb, kernreq, ckb_offset, reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
-           reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, src0_element_tp.get_data_size());
+      intptr_t src0_size = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size;
+      intptr_t src0_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride;
+
+      detail::hash_functions functions;
+      if (detail::get_hash_functions(src0_element_tp, functions)) {
+        detail::hash_unique_kernel::make(ckb, kernreq, ckb_offset,
+                                         detail::hash_kernel_params(src0_size, src0_stride, ectx), functions);
+        return ckb_offset;
+      }
+
+      make(ckb, kernreq, ckb_offset, src0_size, src0_stride, src0_element_tp.get_data_size());
 
       const callable &equal = nd::equal;
       const ndt::type equal_src_tp[2] = {src0_element_tp, src0_element_tp};
@@ -62,6 +570,130 @@ namespace nd {
     }
   };
 
+  /**
+   * Makes a ``N * {value: T, count: int64}`` array of the distinct values of
+   * a fixed dimension and the number of times each occurs, in order of first
+   * occurrence. The values must be builtin numeric, string or categorical.
+   */
+  struct value_counts_kernel : base_kernel<value_counts_kernel> {
+    static const size_t data_size = 0;
+
+    detail::hash_kernel_params params;
+    detail::hash_functions functions;
+    ndt::type value_tp;
+
+    value_counts_kernel(const detail::hash_kernel_params &params, const detail::hash_functions &functions,
+                        const ndt::type &value_tp)
+        : params(params), functions(functions), value_tp(value_tp)
+    {
+    }
+
+    void single(array *dst, array *const *src)
+    {
+      const char *data = src[0]->cdata();
+      std::vector<detail::value_count> counts =
+          functions.count_values(data, params.src0_stride, params.src0_size, params.pool, params.num_workers);
+
+      array res = empty(ndt::make_fixed_dim(counts.size(), make_row_type(value_tp)));
+      const char *row_arrmeta = res.get()->metadata() + sizeof(fixed_dim_type_arrmeta);
+      intptr_t row_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res.get()->metadata())->stride;
+      const uintptr_t *offsets = res.get_type()
+                                     .extended<ndt::fixed_dim_type>()
+                                     ->get_element_type()
+                                     .extended<ndt::struct_type>()
+                                     ->get_data_offsets(row_arrmeta);
+
+      char *row = res.data();
+      for (const detail::value_count &c : counts) {
+        functions.copy(row + offsets[0], data + c.first_index * params.src0_stride);
+        *reinterpret_cast<int64_t *>(row + offsets[1]) = c.count;
+        row += row_stride;
+      }
+
+      *dst = res;
+    }
+
+    static ndt::type make_row_type(const ndt::type &value_tp)
+    {
+      return ndt::struct_type::make({"value", "count"}, {value_tp, ndt::type::make<int64_t>()});
+    }
+
+    static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
+                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
+                                 const array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+    {
+      // The number of distinct values is only known once they have been
+      // counted, so the kernel replaces this with the result
+      dst_tp = ndt::make_fixed_dim(0, make_row_type(src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type()));
+    }
+
+    static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
+                                const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
+                                const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
+                                const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+    {
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      detail::hash_functions functions;
+      if (!detail::get_hash_functions(src0_element_tp, functions)) {
+        std::stringstream ss;
+        ss << "nd::value_counts: values of type " << src0_element_tp << " cannot be hashed";
+        throw std::invalid_argument(ss.str());
+      }
+
+      make(ckb, kernreq, ckb_offset,
+           detail::hash_kernel_params(reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+                                      reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, ectx),
+           functions, src0_element_tp);
+      return ckb_offset;
+    }
+  };
+
+  /**
+   * Counts the distinct values of a fixed dimension, which must be builtin
+   * numeric, string or categorical.
+   */
+  struct count_distinct_kernel : base_kernel<count_distinct_kernel, 1> {
+    static const size_t data_size = 0;
+
+    detail::hash_kernel_params params;
+    detail::hash_functions functions;
+
+    count_distinct_kernel(const detail::hash_kernel_params &params, const detail::hash_functions &functions)
+        : params(params), functions(functions)
+    {
+    }
+
+    void single(char *dst, char *const *src)
+    {
+      *reinterpret_cast<int64_t *>(dst) =
+          functions.count_values(src[0], params.src0_stride, params.src0_size, params.pool, params.num_workers).size();
+    }
+
+    static intptr_t instantiate(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb,
+                                intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
+                                const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
+                                const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+                                const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
+                                const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
+    {
+      const ndt::type &src0_element_tp = src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type();
+      detail::hash_functions functions;
+      if (!detail::get_hash_functions(src0_element_tp, functions)) {
+        std::stringstream ss;
+        ss << "nd::count_distinct: values of type " << src0_element_tp << " cannot be hashed";
+        throw std::invalid_argument(ss.str());
+      }
+
+      make(ckb, kernreq, ckb_offset,
+           detail::hash_kernel_params(reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->dim_size,
+                                      reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta[0])->stride, ectx),
+           functions);
+      return ckb_offset;
+    }
+  };
+
 } // namespace dynd::nd
 
 namespace ndt {
@@ -71,5 +703,15 @@ namespace ndt {
     static type make() { return callable_type::make(type::make<void>(), {type("Fixed * Scalar")}); }
   };
 
+  template <>
+  struct type::equivalent<nd::value_counts_kernel> {
+    static type make() { return callable_type::make(type("Fixed * Any"), {type("Fixed * Scalar")}); }
+  };
+
+  template <>
+  struct type::equivalent<nd::count_distinct_kernel> {
+    static type make() { return callable_type::make(type::make<int64_t>(), {type("Fixed * Scalar")}); }
+  };
+
 } // namespace dynd::ndt
 } // namespace dynd
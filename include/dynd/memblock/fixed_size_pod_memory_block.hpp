@@ -9,16 +9,26 @@
 #include <string>
 
 #include <dynd/memblock/memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 
 namespace dynd {
 
 /**
  * Creates a memory block of a pre-determined fixed size. A pointer to the
- * memory allocated for data is placed in the output parameter.
+ * memory allocated for data, aligned to ``alignment`` in memory, is placed
+ * in the output parameter.
  */
 DYND_API intrusive_ptr<memory_block_data> make_fixed_size_pod_memory_block(intptr_t size_bytes, intptr_t alignment,
                                                                            char **out_datapointer);
 
+/**
+ * Creates a memory block of a pre-determined fixed size, allocated with the
+ * given allocator.
+ */
+DYND_API intrusive_ptr<memory_block_data> make_fixed_size_pod_memory_block(intptr_t size_bytes, intptr_t alignment,
+                                                                           char **out_datapointer,
+                                                                           memory_allocator *allocator);
+
 DYND_API void fixed_size_pod_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                                       const std::string &indent);
 
@@ -29,11 +29,37 @@ namespace dynd {
  *             (default end of the file). This value may be
  *             negative, in which case it is interpreted as an offset from the
  *             end of the file.
+ * \param private_mapping  If true, the file is opened for reading only, and
+ *                         writes to the mapped memory go to private copies
+ *                         of the pages they touch, never to the file.
  */
 DYND_API intrusive_ptr<memory_block_data> make_memmap_memory_block(const std::string &filename, uint32_t access,
                                                                    char **out_pointer, intptr_t *out_size,
                                                                    intptr_t begin = 0,
-                                                                   intptr_t end = std::numeric_limits<intptr_t>::max());
+                                                                   intptr_t end = std::numeric_limits<intptr_t>::max(),
+                                                                   bool private_mapping = false);
+
+/**
+ * How mapped memory is going to be accessed, passed on to the operating
+ * system so it can read ahead or not.
+ */
+enum memmap_advice_t {
+  /** No particular pattern */
+  memmap_advice_normal,
+  /** From the start to the end, so pages can be read well ahead */
+  memmap_advice_sequential,
+  /** In no order, so reading ahead is wasted */
+  memmap_advice_random,
+  /** Soon, so the pages should be read in now */
+  memmap_advice_willneed
+};
+
+/**
+ * Advises the operating system how the mapped memory in ``[ptr, ptr + size)``
+ * is going to be accessed. This is only a hint, and does nothing on
+ * platforms without ``madvise``.
+ */
+DYND_API void memmap_advise(char *ptr, intptr_t size, memmap_advice_t advice);
 
 DYND_API void memmap_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                               const std::string &indent);
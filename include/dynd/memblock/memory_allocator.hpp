@@ -0,0 +1,116 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * Counters of the memory allocated for memory blocks by the calling thread.
+ * Blocks are counted by the thread which frees them, which may not be the
+ * one which allocated them.
+ */
+struct DYND_API memory_allocator_stats {
+  /** The number of blocks allocated */
+  size_t allocations;
+  /** The number of blocks freed */
+  size_t deallocations;
+  /** The number of allocations served from a free list of the pool */
+  size_t pool_allocations;
+  /** The number of calls to the system allocator to allocate, and free, memory */
+  size_t system_allocations;
+  size_t system_deallocations;
+  /** The number of bytes held in the free lists of the pool */
+  size_t cached_bytes;
+};
+
+/**
+ * This is a struct of function pointers for allocating the memory of the
+ * memory blocks which hold their own data, like the arrmeta and embedded data
+ * of an nd::array, or a fixed-size POD memory block. Its functions must be
+ * safe to call from any thread.
+ *
+ * The allocator which allocated a block is recorded with the block, so
+ * changing the allocator doesn't affect the blocks which are already
+ * allocated.
+ */
+struct DYND_API memory_allocator {
+  /**
+   * Allocates ``size`` bytes, aligned at least like the system allocator.
+   * Throws std::bad_alloc on failure.
+   */
+  void *(*allocate)(size_t size);
+
+  /**
+   * Frees the memory at ``ptr``, which was allocated with ``size`` bytes.
+   */
+  void (*deallocate)(void *ptr, size_t size);
+};
+
+/**
+ * The allocator which calls malloc and free directly.
+ */
+DYND_API memory_allocator *get_system_memory_allocator();
+
+/**
+ * The default allocator, which keeps freed blocks of up to 4096 bytes in
+ * thread-local free lists, one per size class, so that short-lived scalars
+ * and small arrays reuse memory without going to the system allocator. Larger
+ * blocks go to the system allocator.
+ */
+DYND_API memory_allocator *get_pool_memory_allocator();
+
+/**
+ * An allocator for large blocks, which maps them directly from the system
+ * backed by huge pages, to cut down on TLB misses when going through
+ * gigabytes of data. It asks for explicit huge pages with ``MAP_HUGETLB``
+ * first, and if none are reserved, maps normal pages and advises the kernel
+ * with ``MADV_HUGEPAGE`` to back them with transparent huge pages. Sizes are
+ * rounded up to a multiple of the huge page size. On platforms without huge
+ * page support, this is the system allocator.
+ */
+DYND_API memory_allocator *get_huge_page_memory_allocator();
+
+/**
+ * The allocator used for new memory blocks.
+ */
+DYND_API memory_allocator *get_memory_allocator();
+
+/**
+ * Sets the allocator used for new memory blocks. Passing NULL restores the
+ * default pool allocator.
+ */
+DYND_API void set_memory_allocator(memory_allocator *allocator);
+
+/**
+ * Returns the allocation counters of the calling thread.
+ */
+DYND_API memory_allocator_stats get_memory_allocator_stats();
+
+namespace detail {
+  /**
+   * Allocates the memory for a memory block of ``size`` bytes with the
+   * current allocator. The memory must be freed with memory_block_deallocate.
+   */
+  DYND_API void *memory_block_allocate(size_t size);
+
+  /**
+   * Allocates the memory for a memory block of ``size`` bytes with the given
+   * allocator.
+   */
+  DYND_API void *memory_block_allocate(size_t size, memory_allocator *allocator);
+
+  /**
+   * Frees memory allocated by memory_block_allocate, with the allocator which
+   * allocated it.
+   */
+  DYND_API void memory_block_deallocate(void *ptr);
+} // namespace detail
+
+} // namespace dynd
@@ -30,6 +30,37 @@ DYND_API intrusive_ptr<memory_block_data> make_objectarray_memory_block(const nd
                                                                         intptr_t stride, intptr_t initial_count = 64,
                                                                         size_t arrmeta_size = 0);
 
+/**
+ * Returns a POD memory block, owned by the objectarray memory block, from
+ * which its objects can allocate their variable-sized data, for example with
+ * the arena overload of ``bytes::assign``. The arena is freed in bulk after
+ * all the objects have been destroyed.
+ */
+DYND_API memory_block_data *get_objectarray_memory_block_arena(memory_block_data *memblock);
+
+/**
+ * Returns the arena which string and bytes assignment kernels instantiated
+ * with the ``use_string_arena`` option allocate from, or NULL. It is set on
+ * the calling thread by a ``string_arena_scope`` while a var dimension
+ * kernel runs its child kernels over newly allocated elements.
+ */
+DYND_API memory_block_data *get_string_arena();
+
+/**
+ * Makes ``arena`` the one returned by ``get_string_arena`` on this thread,
+ * restoring the previous one when it goes out of scope.
+ */
+class DYND_API string_arena_scope {
+  memory_block_data *m_previous;
+
+public:
+  explicit string_arena_scope(memory_block_data *arena);
+
+  string_arena_scope(const string_arena_scope &) = delete;
+
+  ~string_arena_scope();
+};
+
 DYND_API void objectarray_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                                    const std::string &indent);
 
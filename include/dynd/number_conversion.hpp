@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <dynd/config.hpp>
+#include <dynd/typed_data_assign.hpp>
+#include <dynd/types/type_id.hpp>
+
+namespace dynd {
+
+/**
+ * The number of characters which is always enough for the output of
+ * ``format_float64``, ``format_float32``, ``format_int64`` and
+ * ``format_uint64``.
+ */
+const int number_format_max_size = 32;
+
+/**
+ * Parses a decimal floating point number of the form
+ * ``[+-]digits[.digits][(e|E)[+-]digits]``, where either the integer or the
+ * fractional digits may be empty but not both, into the nearest float64.
+ *
+ * This follows the Eisel-Lemire algorithm, which finds the correctly rounded
+ * result from a 128-bit approximation of the power of ten, without allocating
+ * or depending on the locale. The few inputs it can't decide, which are
+ * ones very close to halfway between two floats, fall back to ``strtod``.
+ *
+ * Returns false, leaving ``out`` unchanged, if the whole range is not a
+ * number of that form.
+ */
+DYND_API bool parse_float64(const char *begin, const char *end, double &out);
+
+/**
+ * Writes the shortest decimal representation of ``value`` which parses back
+ * to the same float64, returning one past the last character written. This
+ * uses the Grisu2 algorithm, and the layout of JavaScript's Number.toString,
+ * so integers up to 21 digits are written without an exponent, and other
+ * numbers switch to an exponent outside ``[1e-7, 1e21)``. NaN and infinity
+ * are written as ``nan``, ``inf`` and ``-inf``.
+ *
+ * ``out`` must have room for ``number_format_max_size`` characters.
+ */
+DYND_API char *format_float64(char *out, double value);
+
+/**
+ * Like ``format_float64``, but with the shortest representation which parses
+ * back to the same float32.
+ */
+DYND_API char *format_float32(char *out, float value);
+
+/**
+ * Writes ``value`` in decimal, two digits at a time, returning one past the
+ * last character written.
+ */
+DYND_API char *format_int64(char *out, int64_t value);
+
+DYND_API char *format_uint64(char *out, uint64_t value);
+
+/**
+ * Formats a value of the builtin integer or float32/float64 type ``type_id``
+ * with the functions above, returning one past the last character written,
+ * or NULL for any other type.
+ */
+DYND_API char *format_builtin_number(char *out, type_id_t type_id, const char *data);
+
+/**
+ * Parses ``count`` strings, with type ``string`` at ``src`` spaced by
+ * ``src_stride``, into float64 values at ``dst`` spaced by ``dst_stride``.
+ * Surrounding whitespace is ignored, and the same spellings of NaN and
+ * infinity as ``parse::checked_string_to_float64`` are accepted.
+ */
+DYND_API void parse_float64_strided(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride, size_t count,
+                                    assign_error_mode errmode);
+
+/**
+ * Formats ``count`` float64 values at ``src`` spaced by ``src_stride`` into
+ * strings, with type ``string`` at ``dst`` spaced by ``dst_stride``, using
+ * ``format_float64``.
+ */
+DYND_API void format_float64_strided(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride,
+                                     size_t count);
+
+} // namespace dynd
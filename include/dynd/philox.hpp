@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <dynd/config.hpp>
+
+namespace dynd {
+
+/**
+ * The Philox4x32-10 counter-based random number generator, from
+ * "Parallel Random Numbers: As Easy as 1, 2, 3" by Salmon et al.
+ *
+ * The generator has no state besides its key, which comes from the seed.
+ * Each 128-bit counter is mapped to a block of four random 32-bit words, so
+ * any block can be generated directly, in any order and on any thread. The
+ * counter is made from a 64-bit index, a 32-bit stream and a 32-bit round,
+ * so each stream is an independent sequence of 2^64 blocks, and a consumer
+ * which needs more than one block per index can take them from later rounds.
+ */
+class philox4x32 {
+  uint32_t m_key[2];
+
+  static uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t &hi)
+  {
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    return static_cast<uint32_t>(product);
+  }
+
+public:
+  typedef std::array<uint32_t, 4> block_type;
+
+  explicit philox4x32(uint64_t seed)
+  {
+    m_key[0] = static_cast<uint32_t>(seed);
+    m_key[1] = static_cast<uint32_t>(seed >> 32);
+  }
+
+  /** Returns the block for the raw 128-bit counter ``ctr`` */
+  block_type operator()(block_type ctr) const
+  {
+    uint32_t key0 = m_key[0], key1 = m_key[1];
+    for (int i = 0; i < 10; ++i) {
+      uint32_t hi0, hi1;
+      uint32_t lo0 = mulhilo(0xD2511F53u, ctr[0], hi0);
+      uint32_t lo1 = mulhilo(0xCD9E8D57u, ctr[2], hi1);
+      ctr = block_type{{hi1 ^ ctr[1] ^ key0, lo1, hi0 ^ ctr[3] ^ key1, lo0}};
+      key0 += 0x9E3779B9u;
+      key1 += 0xBB67AE85u;
+    }
+    return ctr;
+  }
+
+  /** Returns the block for ``index`` in ``stream``, at ``round`` */
+  block_type operator()(uint64_t index, uint32_t stream, uint32_t round = 0) const
+  {
+    return (*this)(block_type{{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), stream, round}});
+  }
+};
+
+/** Returns a uniform double in [0, 1) from the 53 high bits of a 64-bit word */
+inline double unit_double(uint64_t bits) { return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0); }
+
+/** Returns a uniform float in [0, 1) from the 24 high bits of a 32-bit word */
+inline float unit_float(uint32_t bits) { return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f); }
+
+/** Joins two 32-bit words of a block into a 64-bit word */
+inline uint64_t join_words(uint32_t lo, uint32_t hi) { return (static_cast<uint64_t>(hi) << 32) | lo; }
+
+} // namespace dynd
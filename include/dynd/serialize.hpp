@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <string>
+
+#include <dynd/array.hpp>
+
+namespace dynd {
+
+/**
+ * The header at the start of a buffer written by ``nd::serialize``. It is
+ * followed by the datashape of the array, and then, at ``data_offset``, the
+ * data of the array in C order. The variable-sized data that the array
+ * points to, the elements of ``var`` dimensions and the characters of
+ * ``string`` and ``bytes`` values, follows that, each part aligned for its
+ * type.
+ *
+ * Every pointer in the data holds ``base`` plus the offset of what it points
+ * to in the buffer. When written, ``base`` is zero, so the pointers are plain
+ * offsets. Reading the buffer adds the difference to its address to every
+ * pointer and sets ``base`` to it, so a buffer which stays in place is only
+ * relocated once.
+ *
+ * Like the binary file format, a buffer is tied to the byte order and
+ * pointer size of the machine which wrote it.
+ */
+struct serialize_header {
+  /** "DYNDSER" followed by a zero */
+  char magic[8];
+  uint32_t version;
+  /** 0x01020304 as written, to check the byte order */
+  uint32_t byte_order;
+  uint32_t pointer_size;
+  uint32_t reserved;
+  uint64_t datashape_size;
+  uint64_t data_offset;
+  /** The size of the whole buffer */
+  uint64_t size;
+  /** The address the pointers in the buffer are relative to */
+  uint64_t base;
+};
+
+namespace nd {
+
+  /**
+   * How ``nd::deserialize`` reads a buffer.
+   */
+  enum deserialize_mode_t {
+    /**
+     * The buffer is copied, and the array refers to the copy. The buffer is
+     * not modified.
+     */
+    deserialize_copy,
+    /**
+     * The pointers in the buffer are relocated where they are, and the array
+     * refers to the buffer, with its strings viewing the characters in it.
+     * The buffer must be writable and aligned to 16 bytes. A corrupt buffer
+     * is rejected before anything in it is modified.
+     */
+    deserialize_in_place
+  };
+
+  /**
+   * Writes an array into one contiguous, relocatable buffer (see
+   * serialize_header), returned as a ``N * uint8`` array. Along with fixed
+   * dimensions, structs, tuples, options and other POD types, the array may
+   * contain ``var`` dimensions, ``string`` and ``bytes`` values.
+   */
+  DYND_API array serialize(const array &a);
+
+  /**
+   * Reads an array from a buffer written by ``nd::serialize``, a C-contiguous
+   * one-dimensional array of one-byte elements. The result keeps the memory
+   * it refers to alive. Read from a copy, it is immutable, since its strings
+   * and ``var`` dimensions view memory which can't be reallocated. Read in
+   * place, it is read-only for the same reason, but not immutable, since the
+   * buffer may still be written through other references.
+   */
+  DYND_API array deserialize(const array &buffer, deserialize_mode_t mode = deserialize_copy);
+
+  /**
+   * Memory-maps a file holding a buffer written by ``nd::serialize`` and
+   * reads it in place. The mapping is private, so relocating the pointers
+   * copies only the pages which hold them, and the characters of strings
+   * are read from the file as they are used. The file is not modified, and
+   * the result is immutable.
+   */
+  DYND_API array deserialize_mmap(const std::string &filename);
+
+} // namespace dynd::nd
+} // namespace dynd
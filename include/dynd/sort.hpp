@@ -10,13 +10,51 @@
 namespace dynd {
 namespace nd {
 
+  /**
+   * Sorts a fixed dimension in place. Builtin integer and floating point
+   * types are sorted directly, with a radix sort for large sizes and on the
+   * thread pool if the evaluation context allows it, and NaNs order after
+   * every other value. Categorical values are ordered by category with a
+   * counting sort of their codes. Other types are sorted with ``nd::less``.
+   */
   extern DYND_API struct sort : declfunc<sort> {
     static DYND_API callable make();
   } sort;
 
+  /**
+   * Returns the int64 indices which stably sort a fixed dimension, ordering
+   * values the same way as ``nd::sort``.
+   */
+  extern DYND_API struct argsort : declfunc<argsort> {
+    static DYND_API callable make();
+  } argsort;
+
+  /**
+   * Removes repeated values from a fixed dimension in place, keeping the
+   * first occurrence of each. Builtin numeric, string and categorical values
+   * are found with a hash table in expected linear time, other types need
+   * the repeats to be adjacent, as in sorted input.
+   */
   extern DYND_API struct unique : declfunc<unique> {
     static DYND_API callable make();
   } unique;
 
+  /**
+   * Returns a ``N * {value: T, count: int64}`` array of the distinct values
+   * of a fixed dimension of builtin numeric, string or categorical values,
+   * with the number of times each occurs, in order of first occurrence.
+   */
+  extern DYND_API struct value_counts : declfunc<value_counts> {
+    static DYND_API callable make();
+  } value_counts;
+
+  /**
+   * Returns the number of distinct values in a fixed dimension of builtin
+   * numeric, string or categorical values, as an int64.
+   */
+  extern DYND_API struct count_distinct : declfunc<count_distinct> {
+    static DYND_API callable make();
+  } count_distinct;
+
 } // namespace dynd::nd
 } // namespace dynd
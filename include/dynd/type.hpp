@@ -291,11 +291,11 @@ namespace ndt {
      * \param tp_vars     A map of names to matched type vars.
      */
     bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, ndt::type> &tp_vars) const;
+               ndt::typevar_map &tp_vars) const;
 
     bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta) const;
 
-    bool match(const ndt::type &candidate_tp, std::map<std::string, ndt::type> &tp_vars) const;
+    bool match(const ndt::type &candidate_tp, ndt::typevar_map &tp_vars) const;
 
     bool match(const ndt::type &candidate_tp) const;
 
@@ -134,7 +134,7 @@ namespace ndt {
 
     virtual bool match(const char *arrmeta, const type &candidate_tp,
                        const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       typevar_map &tp_vars) const;
 
     virtual type with_element_type(const type &element_tp) const = 0;
   };
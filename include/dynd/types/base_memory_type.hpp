@@ -111,7 +111,7 @@ namespace ndt {
 
     virtual bool match(const char *arrmeta, const type &candidate_tp,
                        const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       typevar_map &tp_vars) const;
 
     virtual void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
   };
@@ -23,6 +23,7 @@ namespace ndt {
   class base_type;
   class callable_type;
   class type;
+  class typevar_map;
 } // namespace dynd::ndt
 
 // Forward definition from dynd/array.hpp
@@ -506,7 +507,7 @@ namespace ndt {
                                           comparison_type_t comptype, const eval::eval_context *ectx) const;
 
     virtual bool match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, ndt::type> &tp_vars) const;
+                       ndt::typevar_map &tp_vars) const;
 
     /**
      * Call the callback on each element of the array with given data/arrmeta
@@ -186,7 +186,7 @@ namespace ndt {
                                     const eval::eval_context *ectx) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
     void get_dynamic_array_functions(std::map<std::string, nd::callable> &functions) const;
@@ -71,6 +71,15 @@ namespace ndt {
              unchecked_fixed_dim_get<intptr_t>(m_value_to_category_index, value) *
                  reinterpret_cast<const fixed_dim_type_arrmeta *>(m_categories.get()->metadata())->stride;
     }
+    /**
+     * Returns the value stored for the category at ``index`` in the sorted
+     * list of categories.
+     */
+    uint32_t get_value_from_category_index(intptr_t index) const
+    {
+      return static_cast<uint32_t>(unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, index));
+    }
+
     /** Returns the arrmeta corresponding to data from
      * get_category_data_from_value */
     const char *get_category_arrmeta() const;
@@ -101,4 +110,19 @@ namespace ndt {
   DYND_API type factor_categorical(const nd::array &values);
 
 } // namespace dynd::ndt
+
+namespace nd {
+
+  /**
+   * Dictionary encodes a one-dimensional array, returning a categorical
+   * array with the same values. The distinct values are found with a hash
+   * table in one pass, and each element's code is the position of its value
+   * in order of first occurrence, so no value needs to be looked up again.
+   *
+   * Builtin numeric and string values are hashed. Other value types fall
+   * back to ``factor_categorical`` and a binary search for each element.
+   */
+  DYND_API array dictionary_encode(const array &values);
+
+} // namespace dynd::nd
 } // namespace dynd
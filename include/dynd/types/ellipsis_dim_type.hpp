@@ -10,6 +10,7 @@
 
 #include <dynd/array.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/typevar_map.hpp>
 #include <dynd/types/base_dim_type.hpp>
 
 namespace dynd {
@@ -20,6 +21,7 @@ namespace ndt {
   class DYND_API ellipsis_dim_type : public base_dim_type {
     // m_name is either NULL or an immutable array of type "string"
     std::string m_name;
+    typevar_symbol m_symbol;
 
   public:
     ellipsis_dim_type(const std::string &name, const type &element_type);
@@ -28,6 +30,8 @@ namespace ndt {
 
     const std::string &get_name() const { return m_name; }
 
+    const typevar_symbol &get_symbol() const { return m_symbol; }
+
     void get_vars(std::unordered_set<std::string> &vars) const;
 
     void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
@@ -50,7 +54,7 @@ namespace ndt {
     void arrmeta_destruct(char *arrmeta) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
 
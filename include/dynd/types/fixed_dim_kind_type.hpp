@@ -66,7 +66,7 @@ namespace ndt {
     void data_destruct_strided(const char *arrmeta, char *data, intptr_t stride, size_t count) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
     void get_dynamic_array_properties(std::map<std::string, nd::callable> &properties) const;
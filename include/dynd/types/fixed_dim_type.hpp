@@ -209,7 +209,7 @@ namespace ndt {
     void reorder_default_constructed_strides(char *dst_arrmeta, const type &src_tp, const char *src_arrmeta) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
     void get_dynamic_array_properties(std::map<std::string, nd::callable> &properties) const;
@@ -10,6 +10,7 @@
 
 #include <dynd/array.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/typevar_map.hpp>
 #include <dynd/types/base_dim_type.hpp>
 
 namespace dynd {
@@ -18,6 +19,7 @@ namespace ndt {
   class DYND_API pow_dimsym_type : public base_dim_type {
     type m_base_tp;
     std::string m_exponent;
+    typevar_symbol m_exponent_symbol;
 
   public:
     pow_dimsym_type(const type &base_tp, const std::string &exponent,
@@ -29,6 +31,8 @@ namespace ndt {
 
     const std::string &get_exponent() const { return m_exponent; }
 
+    const typevar_symbol &get_exponent_symbol() const { return m_exponent_symbol; }
+
     void print_data(std::ostream &o, const char *arrmeta,
                     const char *data) const;
 
@@ -61,7 +65,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     virtual type with_element_type(const type &element_tp) const;
   }; // class pow_dimsym_type
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -20,8 +22,24 @@ namespace ndt {
   class DYND_API struct_type : public tuple_type {
     nd::array m_field_names;
     std::map<std::string, nd::callable> m_array_properties;
+    // Open addressing hash table from field name to field index, with -1 in
+    // the empty slots. Its size is a power of two, at least twice the number
+    // of fields, so probe sequences stay short.
+    std::vector<intptr_t> m_field_index_table;
+    // Entry i + 1 is the field which followed field i in the last call to
+    // get_field_index_after, and entry 0 the field which came first. These
+    // are only hints, so concurrent updates need no ordering.
+    std::unique_ptr<std::atomic<intptr_t>[]> m_field_order_hints;
 
     void create_array_properties();
+    void create_field_index();
+
+    bool field_name_equals(intptr_t i, const char *field_name_begin, const char *field_name_end) const
+    {
+      const string &fn = get_field_name_raw(i);
+      size_t size = field_name_end - field_name_begin;
+      return fn.size() == size && memcmp(fn.begin(), field_name_begin, size) == 0;
+    }
 
     // Special constructor to break the property parameter cycle in
     // create_array_properties
@@ -59,6 +77,24 @@ namespace ndt {
     }
     intptr_t get_field_index(const char *field_name_begin, const char *field_name_end) const;
 
+    /**
+     * Gets the field index for the given name, for callers like parsers which
+     * see the fields of many records one after another. The field which
+     * followed ``prev_index`` last time is tried before the hash lookup, so
+     * records whose fields come in a consistent order are matched with one
+     * comparison per field.
+     *
+     * \param prev_index  The index of the previous field of the record, or
+     *                    -1 for the first field.
+     * \param field_name_begin  The beginning of the name of the field.
+     * \param field_name_end  The end of the name of the field.
+     *
+     * \returns  The field index, or -1 if there is not field
+     *           of the given name.
+     */
+    intptr_t get_field_index_after(intptr_t prev_index, const char *field_name_begin,
+                                   const char *field_name_end) const;
+
     inline const uintptr_t *get_data_offsets(const char *arrmeta) const
     {
       return reinterpret_cast<const uintptr_t *>(arrmeta);
@@ -93,7 +129,7 @@ namespace ndt {
     void get_dynamic_array_properties(std::map<std::string, nd::callable> &properties) const;
 
     virtual bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                       std::map<std::string, type> &tp_vars) const;
+                       typevar_map &tp_vars) const;
 
     size_t get_elwise_property_index(const std::string &property_name) const;
     type get_elwise_property_type(size_t elwise_property_index, bool &out_readable, bool &out_writable) const;
@@ -5,9 +5,7 @@
 
 #pragma once
 
-#include <map>
-
-#include <dynd/type.hpp>
+#include <dynd/types/typevar_map.hpp>
 #include <dynd/string.hpp>
 
 namespace dynd {
@@ -16,7 +14,7 @@ namespace ndt {
   namespace detail {
     DYND_API ndt::type
     internal_substitute(const ndt::type &pattern,
-                        const std::map<std::string, ndt::type> &typevars,
+                        const ndt::typevar_map &typevars,
                         bool concrete);
   }
 
@@ -28,7 +26,7 @@ namespace ndt {
    * \param concrete  If true, requires that the result be concrete.
    */
   inline ndt::type substitute(const ndt::type &pattern,
-                              const std::map<std::string, ndt::type> &typevars,
+                              const ndt::typevar_map &typevars,
                               bool concrete)
   {
     // This check for whether ``pattern`` is symbolic is put here in
@@ -10,12 +10,14 @@
 
 #include <dynd/array.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/typevar_map.hpp>
 
 namespace dynd {
 namespace ndt {
 
   class DYND_API typevar_constructed_type : public base_type {
     std::string m_name;
+    typevar_symbol m_symbol;
     type m_arg;
 
   public:
@@ -25,6 +27,8 @@ namespace ndt {
 
     std::string get_name() const { return m_name; }
 
+    const typevar_symbol &get_symbol() const { return m_symbol; }
+
     type get_arg() const { return m_arg; }
 
     void get_vars(std::unordered_set<std::string> &vars) const;
@@ -58,7 +62,7 @@ namespace ndt {
 
     bool match(const char *arrmeta, const type &candidate_tp,
                const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     /*
         void get_dynamic_type_properties(
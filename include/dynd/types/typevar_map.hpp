@@ -0,0 +1,192 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <dynd/type.hpp>
+
+namespace dynd {
+namespace ndt {
+
+  /**
+   * An interned type variable name. All symbols constructed from equal strings
+   * share one copy of the string, which lives for the rest of the process, so
+   * two symbols are compared by comparing pointers.
+   */
+  class DYND_API typevar_symbol {
+    const std::string *m_name;
+
+    static const std::string *intern(const std::string &name);
+
+  public:
+    typevar_symbol(const std::string &name) : m_name(intern(name)) {}
+
+    typevar_symbol(const char *name) : m_name(intern(name)) {}
+
+    const std::string &str() const { return *m_name; }
+
+    operator const std::string &() const { return *m_name; }
+
+    bool operator==(const typevar_symbol &rhs) const { return m_name == rhs.m_name; }
+
+    bool operator!=(const typevar_symbol &rhs) const { return m_name != rhs.m_name; }
+  };
+
+  /**
+   * The bindings of type variables to types that are built up while matching
+   * a pattern type against a concrete type, and then used to substitute into
+   * a pattern (usually a return type).
+   *
+   * The bindings are stored in a flat array, searched linearly. The first
+   * ``static_capacity`` bindings are stored inline, so matching a callable
+   * with a typical signature does not allocate.
+   */
+  class DYND_API typevar_map {
+  public:
+    typedef std::pair<typevar_symbol, type> value_type;
+    typedef value_type *iterator;
+    typedef const value_type *const_iterator;
+
+    static const size_t static_capacity = 8;
+
+  private:
+    value_type *m_data;
+    size_t m_size;
+    size_t m_capacity;
+    typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type m_static_data[static_capacity];
+
+    value_type *get_static_data() { return reinterpret_cast<value_type *>(m_static_data); }
+
+    bool is_static() const { return m_data == reinterpret_cast<const value_type *>(m_static_data); }
+
+    void reserve(size_t capacity);
+
+  public:
+    typevar_map() : m_data(get_static_data()), m_size(0), m_capacity(static_capacity) {}
+
+    typevar_map(const typevar_map &other);
+
+    typevar_map(typevar_map &&other);
+
+    ~typevar_map()
+    {
+      clear();
+      if (!is_static()) {
+        ::operator delete(m_data);
+      }
+    }
+
+    typevar_map &operator=(const typevar_map &rhs);
+
+    typevar_map &operator=(typevar_map &&rhs);
+
+    size_t size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    iterator begin() { return m_data; }
+
+    const_iterator begin() const { return m_data; }
+
+    iterator end() { return m_data + m_size; }
+
+    const_iterator end() const { return m_data + m_size; }
+
+    iterator find(const typevar_symbol &name)
+    {
+      for (iterator it = begin(), it_end = end(); it != it_end; ++it) {
+        if (it->first == name) {
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const_iterator find(const typevar_symbol &name) const { return const_cast<typevar_map *>(this)->find(name); }
+
+    /**
+     * Looks up a binding by name, without interning the name.
+     */
+    iterator find(const std::string &name)
+    {
+      for (iterator it = begin(), it_end = end(); it != it_end; ++it) {
+        if (it->first.str() == name) {
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const_iterator find(const std::string &name) const { return const_cast<typevar_map *>(this)->find(name); }
+
+    iterator find(const char *name)
+    {
+      for (iterator it = begin(), it_end = end(); it != it_end; ++it) {
+        if (strcmp(it->first.str().c_str(), name) == 0) {
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const_iterator find(const char *name) const { return const_cast<typevar_map *>(this)->find(name); }
+
+    template <typename T>
+    size_t count(const T &name) const
+    {
+      return find(name) != end();
+    }
+
+    template <typename T>
+    const type &at(const T &name) const
+    {
+      const_iterator it = find(name);
+      if (it == end()) {
+        throw std::out_of_range("no binding for typevar \"" + std::string(name) + "\"");
+      }
+      return it->second;
+    }
+
+    template <typename T>
+    type &at(const T &name)
+    {
+      return const_cast<type &>(const_cast<const typevar_map *>(this)->at(name));
+    }
+
+    /**
+     * Returns the type bound to the typevar, first adding a null binding if
+     * there is none.
+     */
+    type &operator[](const typevar_symbol &name)
+    {
+      iterator it = find(name);
+      if (it != end()) {
+        return it->second;
+      }
+
+      if (m_size == m_capacity) {
+        reserve(2 * m_capacity);
+      }
+      new (m_data + m_size) value_type(name, type());
+      return m_data[m_size++].second;
+    }
+
+    void clear()
+    {
+      for (size_t i = 0; i < m_size; ++i) {
+        m_data[i].~value_type();
+      }
+      m_size = 0;
+    }
+  };
+
+} // namespace dynd::ndt
+} // namespace dynd
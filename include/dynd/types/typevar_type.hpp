@@ -10,12 +10,14 @@
 
 #include <dynd/array.hpp>
 #include <dynd/string.hpp>
+#include <dynd/types/typevar_map.hpp>
 
 namespace dynd {
 namespace ndt {
 
   class DYND_API typevar_type : public base_type {
     std::string m_name;
+    typevar_symbol m_symbol;
 
   public:
     typevar_type(const std::string &name);
@@ -24,6 +26,8 @@ namespace ndt {
 
     const std::string &get_name() const { return m_name; }
 
+    const typevar_symbol &get_symbol() const { return m_symbol; }
+
     void get_vars(std::unordered_set<std::string> &vars) const;
 
     void print_data(std::ostream &o, const char *arrmeta, const char *data) const;
@@ -47,7 +51,7 @@ namespace ndt {
     void arrmeta_destruct(char *arrmeta) const;
 
     bool match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-               std::map<std::string, type> &tp_vars) const;
+               typevar_map &tp_vars) const;
 
     void get_dynamic_type_properties(std::map<std::string, nd::callable> &properties) const;
 
@@ -3,109 +3,186 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
-#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
-#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Constants.h>
-#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Module.h>
-#include <llvm/Support/Regex.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Passes/PassPlugin.h>
 #include <llvm/Support/raw_ostream.h>
-#include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Utils/Cloning.h>
-#include <llvm/Bitcode/ReaderWriter.h>
-#include <llvm/ADT/StringMap.h>
 
 using namespace std;
 using namespace llvm;
 
-class EmitLLVMFunctionPass : public FunctionPass {
-  static char ID;
-  StringMap<Module *> SM;
-
-public:
-  EmitLLVMFunctionPass() : FunctionPass(ID)
-  {
-  }
-
-  bool doInitialization(Module &M) override
+namespace {
+
+/**
+ * Stores the LLVM IR of the kernel functions annotated with DYND_EMIT_LLVM in
+ * the ``ir`` member of their kernel class, as a string the JIT can parse.
+ *
+ * Both annotated wrappers of a kernel, "single_wrapper" and "strided_wrapper",
+ * go in one module per kernel, along with the definitions of everything they
+ * call in this translation unit. Anything else is left as a declaration, to be
+ * resolved against the process when the IR is compiled.
+ */
+class EmitLLVMPass : public PassInfoMixin<EmitLLVMPass> {
+  /** The functions annotated with DYND_EMIT_LLVM, and the names they get in the IR */
+  static map<Function *, string> getAnnotated(Module &M)
   {
-    GlobalVariable *global_annos = M.getNamedGlobal("llvm.global.annotations");
-    if (global_annos) {
-      auto a = cast<ConstantArray>(global_annos->getOperand(0));
-      for (size_t i = 0; i < a->getNumOperands(); i++) {
-        auto e = cast<ConstantStruct>(a->getOperand(i));
-
-        if (Function *fn = dyn_cast<Function>(e->getOperand(0)->getOperand(0))) {
-          auto anno = cast<ConstantDataArray>(cast<GlobalVariable>(e->getOperand(1)->getOperand(0))->getOperand(0))
-                          ->getAsCString();
-          if (fn->hasFnAttribute("emit_llvm")) {
-            fn->addFnAttr("name", anno);
-          } else {
-            fn->addFnAttr(anno); // <-- add function annotation here
+    map<Function *, set<string>> annos;
+    if (GlobalVariable *GA = M.getNamedGlobal("llvm.global.annotations")) {
+      ConstantArray *A = dyn_cast<ConstantArray>(GA->getOperand(0));
+      for (unsigned i = 0; A != NULL && i < A->getNumOperands(); ++i) {
+        ConstantStruct *E = cast<ConstantStruct>(A->getOperand(i));
+        Function *F = dyn_cast<Function>(E->getOperand(0)->stripPointerCasts());
+        GlobalVariable *S = dyn_cast<GlobalVariable>(E->getOperand(1)->stripPointerCasts());
+        if (F != NULL && S != NULL && S->hasInitializer()) {
+          if (ConstantDataArray *CDA = dyn_cast<ConstantDataArray>(S->getInitializer())) {
+            annos[F].insert(CDA->getAsCString().str());
           }
         }
       }
     }
 
-    return true;
+    map<Function *, string> res;
+    for (auto &FA : annos) {
+      if (!FA.first->isDeclaration() && FA.second.erase("emit_llvm") && FA.second.size() == 1) {
+        res[FA.first] = *FA.second.begin();
+      }
+    }
+
+    return res;
   }
 
-  bool runOnFunction(Function &F) override
+  /**
+   * Adds the functions defined in this module which ``F`` calls or refers to,
+   * directly or not, and the internal globals they use, like string constants.
+   */
+  static void addReachable(Function *F, set<const GlobalValue *> &Reachable)
   {
-    if (F.hasFnAttribute("emit_llvm")) {
-      StringRef Name = F.getName();
-
-      Module *NewM = new Module("", getGlobalContext());
-      StringRef NewName = F.getFnAttribute("name").getValueAsString();
-      Function *NewF = reinterpret_cast<Function *>(NewM->getOrInsertFunction(NewName, F.getFunctionType()));
-
-      ValueToValueMapTy vmap;
-      Function::arg_iterator DestI = NewF->arg_begin();
-      for (const Argument &I : F.args()) {
-        if (vmap.count(&I) == 0) {
-          DestI->setName(I.getName());
-          vmap[&I] = &*DestI++;
+    if (!Reachable.insert(F).second) {
+      return;
+    }
+
+    for (Instruction &I : instructions(*F)) {
+      for (Value *Op : I.operands()) {
+        Value *V = Op->stripPointerCasts();
+        if (Function *G = dyn_cast<Function>(V)) {
+          if (!G->isDeclaration() && !G->isInterposable()) {
+            addReachable(G, Reachable);
+          }
+        }
+        else if (GlobalVariable *G = dyn_cast<GlobalVariable>(V)) {
+          if (G->hasLocalLinkage()) {
+            Reachable.insert(G);
+          }
         }
       }
-
-      SmallVector<ReturnInst *, 3> ret;
-      CloneFunctionInto(NewF, &F, vmap, false, ret);
-
-      StringRef Key = Name.slice(0, Name.find(NewName) - to_string(NewName.size()).size());
-      SM[Key] = NewM;
     }
-
-    return false;
   }
 
-  bool doFinalization(Module &M) override
+public:
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &)
   {
-    for (const StringMapEntry<Module *> &SME : SM) {
-      GlobalVariable *GV = M.getGlobalVariable(SME.getKey().str() + "2irE", true);
+    map<Function *, string> Annotated = getAnnotated(M);
+    if (Annotated.empty()) {
+      return PreservedAnalyses::all();
+    }
+
+    // The kernel class of each wrapper, from the prefix of its mangled name,
+    // e.g. "_ZN4dynd2nd11base_kernelI...E" for "..._ZN4dynd2nd11base_kernelI...E14single_wrapperE..."
+    map<string, vector<Function *>> Kernels;
+    for (auto &FN : Annotated) {
+      StringRef Name = FN.first->getName();
+      string Nested = to_string(FN.second.size()) + FN.second;
+      size_t Pos = Name.find(Nested);
+      if (Pos != StringRef::npos) {
+        Kernels[Name.substr(0, Pos).str()].push_back(FN.first);
+      }
+    }
 
-      if (GV != NULL) {
-        Module *NewM = SME.getValue();
+    bool Changed = false;
+    for (auto &KF : Kernels) {
+      GlobalVariable *GV = M.getGlobalVariable(KF.first + "2irE", true);
+      if (GV == NULL || !GV->hasInitializer()) {
+        continue;
+      }
 
-        string S;
-        raw_string_ostream SO(S);
-        NewM->print(SO, NULL);
+      set<const GlobalValue *> Reachable;
+      for (Function *F : KF.second) {
+        addReachable(F, Reachable);
+      }
 
-        Constant *CDA = ConstantDataArray::getString(M.getContext(), SO.str());
-        GV->setInitializer(ConstantExpr::getBitCast(new GlobalVariable(M, CDA->getType(), true, GV->getLinkage(), CDA),
-                                                    Type::getInt8PtrTy(M.getContext())));
+      ValueToValueMapTy VMap;
+      unique_ptr<Module> NewM =
+          CloneModule(M, VMap, [&Reachable](const GlobalValue *GV) { return Reachable.count(GV) != 0; });
+      for (Function *F : KF.second) {
+        Function *NewF = cast<Function>(VMap[F]);
+        NewF->setName(Annotated[F]);
+        NewF->setLinkage(GlobalValue::ExternalLinkage);
+      }
 
-        delete NewM;
+      // Drop the annotations and used lists, and the declarations the wrappers don't use
+      for (auto It = NewM->global_begin(); It != NewM->global_end();) {
+        GlobalVariable &G = *It++;
+        if (G.getName().startswith("llvm.")) {
+          G.eraseFromParent();
+        }
       }
+      bool Erased = true;
+      while (Erased) {
+        Erased = false;
+        for (auto It = NewM->global_begin(); It != NewM->global_end();) {
+          GlobalVariable &G = *It++;
+          if (G.use_empty() && (G.isDeclaration() || G.hasLocalLinkage())) {
+            G.eraseFromParent();
+            Erased = true;
+          }
+        }
+        for (auto It = NewM->begin(); It != NewM->end();) {
+          Function &F = *It++;
+          if (F.use_empty() && F.isDeclaration()) {
+            F.eraseFromParent();
+            Erased = true;
+          }
+        }
+      }
+
+      string S;
+      raw_string_ostream SO(S);
+      NewM->print(SO, NULL);
+
+      Constant *CDA = ConstantDataArray::getString(M.getContext(), SO.str());
+      GlobalVariable *Str = new GlobalVariable(M, CDA->getType(), true, GlobalValue::PrivateLinkage, CDA);
+      GV->setInitializer(ConstantExpr::getBitCast(Str, GV->getValueType()));
+      Changed = true;
     }
 
-    return true;
+    return Changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
   }
 };
 
-char EmitLLVMFunctionPass::ID = 0;
-
-static RegisterStandardPasses RegisterEmitLLVMFunctionPass(PassManagerBuilder::EP_OptimizerLast,
-                                                           [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
-  PM.add(new EmitLLVMFunctionPass());
-});
+} // anonymous namespace
+
+extern "C" LLVM_ATTRIBUTE_WEAK PassPluginLibraryInfo llvmGetPassPluginInfo()
+{
+  return {LLVM_PLUGIN_API_VERSION, "dynd_plugin", "v0.1", [](PassBuilder &PB) {
+            PB.registerOptimizerLastEPCallback(
+                [](ModulePassManager &MPM, OptimizationLevel) { MPM.addPass(EmitLLVMPass()); });
+            PB.registerPipelineParsingCallback(
+                [](StringRef Name, ModulePassManager &MPM, ArrayRef<PassBuilder::PipelineElement>) {
+                  if (Name == "dynd-emit-llvm") {
+                    MPM.addPass(EmitLLVMPass());
+                    return true;
+                  }
+                  return false;
+                });
+          }};
+}
@@ -29,6 +29,7 @@
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/builtin_type_properties.hpp>
 #include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/memblock/fixed_size_pod_memory_block.hpp>
 #include <dynd/view.hpp>
 
 using namespace std;
@@ -49,8 +50,37 @@ make_builtin_scalar_array(const T &value, uint64_t flags)
   return result;
 }
 
+/**
+ * Allocates the array memory block and the data of a new array of a type
+ * which isn't a memory type. Following the settings of ectx, small data goes
+ * in the array memory block after the arrmeta, while data of at least
+ * separate_data_threshold bytes goes in a block of its own, aligned to
+ * data_alignment so it starts on a cache line, and on huge pages from
+ * huge_page_threshold bytes. Data which must be constructed or destructed
+ * always stays in the array memory block.
+ */
+static intrusive_ptr<memory_block_data> make_array_memory_block_with_data(const ndt::type &tp, size_t arrmeta_size,
+                                                                          size_t data_size, char **out_data_ptr,
+                                                                          intrusive_ptr<memory_block_data> &out_owner,
+                                                                          const eval::eval_context *ectx)
+{
+  size_t data_alignment = tp.get_data_alignment();
+  if ((tp.get_flags() & (type_flag_construct | type_flag_destructor)) != 0 ||
+      static_cast<intptr_t>(data_size) < ectx->separate_data_threshold) {
+    return make_array_memory_block(arrmeta_size, data_size, data_alignment, out_data_ptr);
+  }
+
+  data_alignment = max(data_alignment, static_cast<size_t>(ectx->data_alignment));
+  intptr_t huge_page_threshold = ectx->huge_page_threshold;
+  memory_allocator *allocator = (huge_page_threshold > 0 && static_cast<intptr_t>(data_size) >= huge_page_threshold)
+                                    ? get_huge_page_memory_allocator()
+                                    : get_memory_allocator();
+  out_owner = make_fixed_size_pod_memory_block(data_size, data_alignment, out_data_ptr, allocator);
+  return make_array_memory_block(arrmeta_size);
+}
+
 nd::array nd::make_strided_array(const ndt::type &dtp, intptr_t ndim, const intptr_t *shape, int64_t access_flags,
-                                 const int *axis_perm)
+                                 const int *axis_perm, const eval::eval_context *ectx)
 {
   // Create the type of the result
   bool any_variable_dims = false;
@@ -65,15 +95,15 @@ nd::array nd::make_strided_array(const ndt::type &dtp, intptr_t ndim, const intp
     data_size = array_tp.extended()->get_default_data_size();
   }
 
-  intrusive_ptr<memory_block_data> result;
+  intrusive_ptr<memory_block_data> result, owner;
   char *data_ptr = NULL;
   if (array_tp.get_kind() == memory_kind) {
     result = make_array_memory_block(array_tp.get_arrmeta_size());
     array_tp.extended<ndt::base_memory_type>()->data_alloc(&data_ptr, data_size);
   }
   else {
-    // Allocate the array arrmeta and data in one memory block
-    result = make_array_memory_block(array_tp.get_arrmeta_size(), data_size, array_tp.get_data_alignment(), &data_ptr);
+    result =
+        make_array_memory_block_with_data(array_tp, array_tp.get_arrmeta_size(), data_size, &data_ptr, owner, ectx);
   }
 
   if (array_tp.get_flags() & type_flag_zeroinit) {
@@ -89,7 +119,7 @@ nd::array nd::make_strided_array(const ndt::type &dtp, intptr_t ndim, const intp
   array_preamble *ndo = reinterpret_cast<array_preamble *>(result.get());
   ndo->tp = array_tp;
   ndo->data = data_ptr;
-  ndo->owner = NULL;
+  ndo->owner = owner;
   ndo->flags = access_flags;
 
   if (!any_variable_dims) {
@@ -899,7 +929,7 @@ bool nd::array::equals_exact(const array &rhs) const
           const char *arrmeta[2] = {iter.arrmeta<0>(), iter.arrmeta<1>()};
           ndt::type dst_tp = ndt::type::make<bool1>();
           if ((*not_equal::get().get())(dst_tp, 2, tp, arrmeta, const_cast<char *const *>(src), 0, NULL,
-                                        std::map<std::string, ndt::type>())
+                                        ndt::typevar_map())
                   .as<bool>()) {
             return false;
           }
@@ -1514,10 +1544,11 @@ nd::array nd::empty_shell(const ndt::type &tp)
     char *data_ptr = NULL;
     size_t arrmeta_size = tp.extended()->get_arrmeta_size();
     size_t data_size = tp.extended()->get_default_data_size();
-    intrusive_ptr<memory_block_data> result;
+    intrusive_ptr<memory_block_data> result, owner;
     if (tp.get_kind() != memory_kind) {
       // Allocate memory the default way
-      result = make_array_memory_block(arrmeta_size, data_size, tp.get_data_alignment(), &data_ptr);
+      result = make_array_memory_block_with_data(tp, arrmeta_size, data_size, &data_ptr, owner,
+                                                 &eval::default_eval_context);
       if (tp.get_flags() & type_flag_zeroinit) {
         memset(data_ptr, 0, data_size);
       }
@@ -1536,7 +1567,7 @@ nd::array nd::empty_shell(const ndt::type &tp)
     array_preamble *preamble = reinterpret_cast<array_preamble *>(result.get());
     preamble->tp = tp;
     preamble->data = data_ptr;
-    preamble->owner = NULL;
+    preamble->owner = owner;
     preamble->flags = nd::read_access_flag | nd::write_access_flag;
     return nd::array(std::move(result));
   }
@@ -0,0 +1,164 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/binary_file.hpp>
+#include <dynd/arrmeta_holder.hpp>
+#include <dynd/exceptions.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const char binary_file_magic[8] = {'D', 'Y', 'N', 'D', 'B', 'I', 'N', '\0'};
+const uint32_t binary_file_version = 1;
+const uint32_t binary_file_byte_order = 0x01020304;
+const uint32_t binary_file_data_alignment = 64;
+
+size_t get_data_size(const ndt::type &tp)
+{
+  return tp.is_builtin() ? tp.get_data_size() : tp.extended()->get_default_data_size();
+}
+
+/** Checks that the type can be saved, with a message for the error otherwise */
+void check_binary_type(const ndt::type &tp, const char *funcname)
+{
+  if (!tp.is_builtin() && (tp.get_kind() == memory_kind || tp.is_expression() ||
+                           (tp.get_flags() & (type_flag_blockref | type_flag_destructor | type_flag_symbolic)) != 0)) {
+    stringstream ss;
+    ss << funcname << ": cannot use type " << tp << ", its data is not self-contained";
+    throw type_error(ss.str());
+  }
+}
+
+/**
+ * Whether the arrmeta is the one nd::empty gives the type, which describes
+ * data in C order.
+ */
+bool is_default_arrmeta(const ndt::type &tp, const char *arrmeta)
+{
+  if (tp.is_builtin() || tp.get_arrmeta_size() == 0) {
+    return true;
+  }
+
+  arrmeta_holder default_arrmeta(tp);
+  default_arrmeta.arrmeta_default_construct(true);
+  return memcmp(default_arrmeta.get(), arrmeta, tp.get_arrmeta_size()) == 0;
+}
+
+} // anonymous namespace
+
+void nd::save_binary(const std::string &filename, const array &a)
+{
+  array c = a.eval();
+  ndt::type tp = c.get_type();
+  check_binary_type(tp, "nd::save_binary");
+  if (!is_default_arrmeta(tp, c.get()->metadata())) {
+    c = c.eval_copy();
+  }
+
+  std::string datashape = tp.str();
+  size_t arrmeta_size = tp.get_arrmeta_size();
+
+  binary_file_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, binary_file_magic, sizeof(header.magic));
+  header.version = binary_file_version;
+  header.byte_order = binary_file_byte_order;
+  header.pointer_size = sizeof(intptr_t);
+  header.data_alignment = binary_file_data_alignment;
+  header.datashape_size = datashape.size();
+  header.arrmeta_size = arrmeta_size;
+  header.data_offset = inc_to_alignment(sizeof(header) + datashape.size() + arrmeta_size, binary_file_data_alignment);
+  header.data_size = get_data_size(tp);
+
+  ofstream f(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!f) {
+    stringstream ss;
+    ss << "nd::save_binary: failed to open file \"" << filename << "\" for writing";
+    throw runtime_error(ss.str());
+  }
+
+  char padding[binary_file_data_alignment] = {0};
+  f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  f.write(datashape.data(), datashape.size());
+  f.write(c.get()->metadata(), arrmeta_size);
+  f.write(padding, header.data_offset - (sizeof(header) + datashape.size() + arrmeta_size));
+  f.write(c.cdata(), header.data_size);
+  f.close();
+  if (!f) {
+    stringstream ss;
+    ss << "nd::save_binary: failed to write file \"" << filename << "\"";
+    throw runtime_error(ss.str());
+  }
+}
+
+nd::array nd::load_mmap(const std::string &filename, uint32_t access, memmap_advice_t advice)
+{
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  intrusive_ptr<memory_block_data> mm = make_memmap_memory_block(filename, access, &mm_ptr, &mm_size);
+
+  binary_file_header header;
+  if (mm_size < static_cast<intptr_t>(sizeof(header))) {
+    stringstream ss;
+    ss << "nd::load_mmap: file \"" << filename << "\" is too small to be a dynd binary file";
+    throw runtime_error(ss.str());
+  }
+  memcpy(&header, mm_ptr, sizeof(header));
+  if (memcmp(header.magic, binary_file_magic, sizeof(header.magic)) != 0 || header.version != binary_file_version) {
+    stringstream ss;
+    ss << "nd::load_mmap: file \"" << filename << "\" is not a dynd binary file";
+    throw runtime_error(ss.str());
+  }
+  if (header.byte_order != binary_file_byte_order || header.pointer_size != sizeof(intptr_t)) {
+    stringstream ss;
+    ss << "nd::load_mmap: file \"" << filename << "\" was written on a machine with a different byte order or "
+                                                  "pointer size";
+    throw runtime_error(ss.str());
+  }
+  if (header.datashape_size > static_cast<uint64_t>(mm_size) ||
+      header.arrmeta_size > static_cast<uint64_t>(mm_size) ||
+      sizeof(header) + header.datashape_size + header.arrmeta_size > header.data_offset ||
+      header.data_size > static_cast<uint64_t>(mm_size) ||
+      header.data_offset > static_cast<uint64_t>(mm_size) - header.data_size) {
+    stringstream ss;
+    ss << "nd::load_mmap: file \"" << filename << "\" is truncated or corrupt";
+    throw runtime_error(ss.str());
+  }
+
+  const char *datashape = mm_ptr + sizeof(header);
+  ndt::type tp(std::string(datashape, datashape + header.datashape_size));
+  check_binary_type(tp, "nd::load_mmap");
+  const char *arrmeta = datashape + header.datashape_size;
+  if (tp.get_arrmeta_size() != header.arrmeta_size || get_data_size(tp) != header.data_size ||
+      !is_default_arrmeta(tp, arrmeta)) {
+    stringstream ss;
+    ss << "nd::load_mmap: the arrmeta in file \"" << filename << "\" does not match its type " << tp;
+    throw runtime_error(ss.str());
+  }
+
+  char *data = mm_ptr + header.data_offset;
+  memmap_advise(data, static_cast<intptr_t>(header.data_size), advice);
+
+  // The arrmeta was checked to be the default arrmeta, so it is constructed
+  // rather than copied
+  array result(make_array_memory_block(tp.get_arrmeta_size()));
+  array_preamble *preamble = result.get();
+  if (!tp.is_builtin()) {
+    tp.extended()->arrmeta_default_construct(preamble->metadata(), true);
+  }
+  preamble->tp = tp;
+  preamble->data = data;
+  preamble->owner = mm;
+  preamble->flags = access;
+
+  return result;
+}
@@ -6,14 +6,33 @@
 #include <memory>
 
 #include <dynd/callables/base_callable.hpp>
+#include <dynd/callables/ckernel_cache.hpp>
 
 using namespace std;
 using namespace dynd;
 
 nd::array nd::base_callable::operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                                         const char *const *src_arrmeta, char *const *src_data, intptr_t nkwd,
-                                        const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                        const array *kwds, const ndt::typevar_map &tp_vars)
 {
+  // Reuse a previously built ckernel, if there is one for these types
+  ckernel_cache &cache = get_ckernel_cache();
+  std::unique_ptr<ckernel_cache::entry> e;
+  if (nkwd == 0 && cache.is_cacheable(dst_tp, nsrc, src_tp)) {
+    e = cache.acquire(this, kernel_request_single, dst_tp, NULL, nsrc, src_tp, src_arrmeta);
+    if (e) {
+      dst_tp = e->resolved_dst_tp;
+      array dst = empty(dst_tp);
+      expr_single_t fn = e->ckb.get()->get_function<expr_single_t>();
+      fn(e->ckb.get(), dst.data(), src_data);
+      cache.release(std::move(e));
+
+      return dst;
+    }
+
+    e = cache.make_entry(this, kernel_request_single, dst_tp, NULL, nsrc, src_tp, src_arrmeta);
+  }
+
   // Allocate, then initialize, the data
   char *data = data_init(static_data(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
@@ -30,6 +49,17 @@ nd::array nd::base_callable::operator()(ndt::type &dst_tp, intptr_t nsrc, const
   array dst = empty(dst_tp);
 
   // Generate and evaluate the ckernel
+  if (e && cache.is_cacheable(dst_tp, 0, NULL)) {
+    e->resolved_dst_tp = dst_tp;
+    instantiate(static_data(), data, &e->ckb, 0, dst_tp, dst.get()->metadata(), nsrc, src_tp, src_arrmeta,
+                kernel_request_single, &eval::default_eval_context, nkwd, kwds, tp_vars);
+    expr_single_t fn = e->ckb.get()->get_function<expr_single_t>();
+    fn(e->ckb.get(), dst.data(), src_data);
+    cache.release(std::move(e));
+
+    return dst;
+  }
+
   ckernel_builder<kernel_request_host> ckb;
   instantiate(static_data(), data, &ckb, 0, dst_tp, dst.get()->metadata(), nsrc, src_tp, src_arrmeta,
               kernel_request_single, &eval::default_eval_context, nkwd, kwds, tp_vars);
@@ -41,7 +71,7 @@ nd::array nd::base_callable::operator()(ndt::type &dst_tp, intptr_t nsrc, const
 
 nd::array nd::base_callable::operator()(ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp,
                                         const char *const *src_arrmeta, array *const *src_data, intptr_t nkwd,
-                                        const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                        const array *kwds, const ndt::typevar_map &tp_vars)
 {
   // Allocate, then initialize, the data
   char *data = data_init(static_data(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
@@ -70,8 +100,27 @@ nd::array nd::base_callable::operator()(ndt::type &dst_tp, intptr_t nsrc, const
 
 void nd::base_callable::operator()(const ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data, intptr_t nsrc,
                                    const ndt::type *src_tp, const char *const *src_arrmeta, char *const *src_data,
-                                   intptr_t nkwd, const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                   intptr_t nkwd, const array *kwds, const ndt::typevar_map &tp_vars)
 {
+  // Reuse a previously built ckernel, if there is one for these types and arrmeta
+  ckernel_cache &cache = get_ckernel_cache();
+  if (nkwd == 0 && cache.is_cacheable(dst_tp, nsrc, src_tp)) {
+    std::unique_ptr<ckernel_cache::entry> e =
+        cache.acquire(this, kernel_request_single, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta);
+    if (!e) {
+      e = cache.make_entry(this, kernel_request_single, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta);
+      e->resolved_dst_tp = dst_tp;
+      char *data = data_init(static_data(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
+      instantiate(static_data(), data, &e->ckb, 0, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta,
+                  kernel_request_single, &eval::default_eval_context, nkwd, kwds, tp_vars);
+    }
+
+    expr_single_t fn = e->ckb.get()->get_function<expr_single_t>();
+    fn(e->ckb.get(), dst_data, src_data);
+    cache.release(std::move(e));
+    return;
+  }
+
   char *data = data_init(static_data(), dst_tp, nsrc, src_tp, nkwd, kwds, tp_vars);
 
   // Generate and evaluate the ckernel
@@ -87,7 +136,7 @@ void nd::base_callable::operator()(const ndt::type &DYND_UNUSED(dst_tp), const c
                                    const ndt::type *DYND_UNUSED(src_tp), const char *const *DYND_UNUSED(src_arrmeta),
                                    array *const *DYND_UNUSED(src_data), intptr_t DYND_UNUSED(nkwd),
                                    const array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                   const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   throw std::runtime_error("view callables are not fully implemented yet");
 }
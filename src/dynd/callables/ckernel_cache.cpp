@@ -0,0 +1,266 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+
+#include <dynd/callables/ckernel_cache.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+inline void hash_combine(size_t &seed, size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+
+inline void hash_bytes(size_t &seed, const char *begin, size_t size)
+{
+  for (size_t i = 0; i < size; ++i) {
+    hash_combine(seed, static_cast<unsigned char>(begin[i]));
+  }
+}
+
+/**
+ * Returns true if the arrmeta of the type contains only plain values, so that
+ * a ckernel built against a copy of it is valid for any arrmeta that compares
+ * equal byte for byte.
+ */
+bool is_self_contained(const ndt::type &tp)
+{
+  ndt::type el_tp = tp;
+  while (el_tp.get_type_id() == fixed_dim_type_id) {
+    el_tp = el_tp.extended<ndt::base_dim_type>()->get_element_type();
+  }
+
+  return el_tp.is_builtin();
+}
+
+/**
+ * The settings of the default evaluation context, which ckernels may bake in
+ * when they are instantiated.
+ */
+struct ectx_fingerprint {
+  // All the same width, so that there is no padding to hash
+  intptr_t errmode;
+  intptr_t cuda_device_errmode;
+  intptr_t date_parse_order;
+  intptr_t century_window;
+  intptr_t num_threads;
+  intptr_t min_grain_size;
+
+  ectx_fingerprint()
+      : errmode(eval::default_eval_context.errmode),
+        cuda_device_errmode(eval::default_eval_context.cuda_device_errmode),
+        date_parse_order(eval::default_eval_context.date_parse_order),
+        century_window(eval::default_eval_context.century_window),
+        num_threads(eval::default_eval_context.num_threads),
+        min_grain_size(eval::default_eval_context.min_grain_size)
+  {
+  }
+};
+
+size_t hash_key(const nd::base_callable *self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
+                const ectx_fingerprint &ectx)
+{
+  size_t seed = reinterpret_cast<size_t>(self);
+  hash_combine(seed, kernreq);
+  hash_combine(seed, dst_tp.get_type_id());
+  if (dst_arrmeta != NULL) {
+    hash_bytes(seed, dst_arrmeta, dst_tp.get_arrmeta_size());
+  }
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    hash_combine(seed, src_tp[i].get_type_id());
+    hash_combine(seed, src_tp[i].get_dtype().get_type_id());
+    hash_bytes(seed, src_arrmeta[i], src_tp[i].get_arrmeta_size());
+  }
+  hash_bytes(seed, reinterpret_cast<const char *>(&ectx), sizeof(ectx));
+
+  return seed;
+}
+
+/**
+ * Writes the arrmeta fingerprint of a key, which is the evaluation context
+ * settings followed by the destination (if provided) and source arrmeta.
+ */
+void write_arrmeta(std::vector<char> &out, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                   const ndt::type *src_tp, const char *const *src_arrmeta, const ectx_fingerprint &ectx)
+{
+  out.insert(out.end(), reinterpret_cast<const char *>(&ectx), reinterpret_cast<const char *>(&ectx) + sizeof(ectx));
+  if (dst_arrmeta != NULL) {
+    out.insert(out.end(), dst_arrmeta, dst_arrmeta + dst_tp.get_arrmeta_size());
+  }
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    out.insert(out.end(), src_arrmeta[i], src_arrmeta[i] + src_tp[i].get_arrmeta_size());
+  }
+}
+
+} // anonymous namespace
+
+bool nd::ckernel_cache::entry::matches(size_t hash, const base_callable *self, kernel_request_t kernreq,
+                                        const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                        const ndt::type *src_tp, const char *const *src_arrmeta) const
+{
+  if (this->hash != hash || this->self.get() != self || this->kernreq != kernreq ||
+      static_cast<intptr_t>(this->src_tp.size()) != nsrc || this->dst_tp != dst_tp) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    if (this->src_tp[i] != src_tp[i]) {
+      return false;
+    }
+  }
+
+  ectx_fingerprint ectx;
+  const char *arrmeta = this->arrmeta.data();
+  if (memcmp(arrmeta, &ectx, sizeof(ectx)) != 0) {
+    return false;
+  }
+  arrmeta += sizeof(ectx);
+
+  if (dst_arrmeta != NULL) {
+    size_t size = dst_tp.get_arrmeta_size();
+    if (memcmp(arrmeta, dst_arrmeta, size) != 0) {
+      return false;
+    }
+    arrmeta += size;
+  }
+
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    size_t size = src_tp[i].get_arrmeta_size();
+    if (memcmp(arrmeta, src_arrmeta[i], size) != 0) {
+      return false;
+    }
+    arrmeta += size;
+  }
+
+  return arrmeta == this->arrmeta.data() + this->arrmeta.size();
+}
+
+bool nd::ckernel_cache::is_cacheable(const ndt::type &dst_tp, intptr_t nsrc, const ndt::type *src_tp) const
+{
+  if (m_capacity == 0) {
+    return false;
+  }
+
+  // A symbolic destination type is resolved from the source types
+  if (!dst_tp.is_symbolic() && !is_self_contained(dst_tp)) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    if (!is_self_contained(src_tp[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::unique_ptr<nd::ckernel_cache::entry> nd::ckernel_cache::acquire(base_callable *self, kernel_request_t kernreq,
+                                                                     const ndt::type &dst_tp, const char *dst_arrmeta,
+                                                                     intptr_t nsrc, const ndt::type *src_tp,
+                                                                     const char *const *src_arrmeta)
+{
+  size_t hash = hash_key(self, kernreq, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, ectx_fingerprint());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    entry_list::iterator e = it->second;
+    if ((*e)->matches(hash, self, kernreq, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta)) {
+      std::unique_ptr<entry> res = std::move(*e);
+      m_index.erase(it);
+      m_entries.erase(e);
+      ++m_hits;
+      return res;
+    }
+  }
+
+  ++m_misses;
+  return std::unique_ptr<entry>();
+}
+
+std::unique_ptr<nd::ckernel_cache::entry>
+nd::ckernel_cache::make_entry(base_callable *self, kernel_request_t kernreq, const ndt::type &dst_tp,
+                              const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp,
+                              const char *const *src_arrmeta) const
+{
+  ectx_fingerprint ectx;
+
+  std::unique_ptr<entry> e(new entry);
+  e->self = intrusive_ptr<base_callable>(self, true);
+  e->hash = hash_key(self, kernreq, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, ectx);
+  e->kernreq = kernreq;
+  e->dst_tp = dst_tp;
+  e->src_tp.assign(src_tp, src_tp + nsrc);
+  write_arrmeta(e->arrmeta, dst_tp, dst_arrmeta, nsrc, src_tp, src_arrmeta, ectx);
+
+  return e;
+}
+
+void nd::ckernel_cache::evict(entry_list &evicted)
+{
+  while (m_entries.size() > m_capacity) {
+    entry_list::iterator e = std::prev(m_entries.end());
+    auto range = m_index.equal_range((*e)->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == e) {
+        m_index.erase(it);
+        break;
+      }
+    }
+    evicted.splice(evicted.end(), m_entries, e);
+  }
+}
+
+void nd::ckernel_cache::release(std::unique_ptr<entry> &&e)
+{
+  // Evicted entries are destroyed after the lock is released, since
+  // destroying a ckernel may release the last reference to a callable
+  entry_list evicted;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t hash = e->hash;
+    m_entries.push_front(std::move(e));
+    m_index.emplace(hash, m_entries.begin());
+    evict(evicted);
+  }
+}
+
+void nd::ckernel_cache::clear()
+{
+  entry_list evicted;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    evicted.swap(m_entries);
+  }
+}
+
+size_t nd::ckernel_cache::size()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void nd::ckernel_cache::set_capacity(size_t capacity)
+{
+  entry_list evicted;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    evict(evicted);
+  }
+}
+
+nd::ckernel_cache &nd::get_ckernel_cache()
+{
+  static ckernel_cache cache;
+  return cache;
+}
@@ -0,0 +1,244 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include <dynd/eval/eval_context.hpp>
+#include <dynd/eval/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// Set while a thread runs chunks of a parallel_for
+thread_local bool in_parallel_for = false;
+
+} // anonymous namespace
+
+struct eval::thread_pool::job {
+  // The chunks [begin, end) a worker has left to run
+  struct run {
+    std::mutex mutex;
+    intptr_t begin;
+    intptr_t end;
+  };
+
+  const loop_function &func;
+  intptr_t size;
+  intptr_t chunk_size;
+  int num_workers;
+  unique_ptr<run[]> runs;
+  atomic<bool> cancelled;
+  std::mutex error_mutex;
+  exception_ptr error;
+
+  job(const loop_function &func, intptr_t size, intptr_t chunk_size, intptr_t num_chunks, int num_workers)
+      : func(func), size(size), chunk_size(chunk_size), num_workers(num_workers), runs(new run[num_workers]),
+        cancelled(false)
+  {
+    for (int i = 0; i < num_workers; ++i) {
+      runs[i].begin = num_chunks * i / num_workers;
+      runs[i].end = num_chunks * (i + 1) / num_workers;
+    }
+  }
+
+  bool next_chunk(int worker, intptr_t &chunk)
+  {
+    run &own = runs[worker];
+    {
+      lock_guard<std::mutex> lock(own.mutex);
+      if (own.begin < own.end) {
+        chunk = own.begin++;
+        return true;
+      }
+    }
+
+    // Steal the back half of another worker's run
+    for (int i = 1; i < num_workers; ++i) {
+      run &other = runs[(worker + i) % num_workers];
+      intptr_t begin, end;
+      {
+        lock_guard<std::mutex> lock(other.mutex);
+        intptr_t remaining = other.end - other.begin;
+        if (remaining <= 0) {
+          continue;
+        }
+        end = other.end;
+        begin = end - (remaining + 1) / 2;
+        other.end = begin;
+      }
+
+      chunk = begin;
+      lock_guard<std::mutex> lock(own.mutex);
+      own.begin = begin + 1;
+      own.end = end;
+      return true;
+    }
+
+    return false;
+  }
+
+  void run_chunks(int worker)
+  {
+    in_parallel_for = true;
+    intptr_t chunk;
+    while (!cancelled && next_chunk(worker, chunk)) {
+      intptr_t begin = chunk * chunk_size;
+      try {
+        func(worker, begin, min(begin + chunk_size, size));
+      }
+      catch (...) {
+        lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = current_exception();
+        }
+        cancelled = true;
+      }
+    }
+    in_parallel_for = false;
+  }
+};
+
+eval::thread_pool::thread_pool(int num_threads)
+    : m_num_threads(1), m_job(NULL), m_generation(0), m_active(0), m_stop(false)
+{
+  reserve(num_threads);
+}
+
+eval::thread_pool::~thread_pool()
+{
+  {
+    lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (std::thread &t : m_threads) {
+    t.join();
+  }
+}
+
+void eval::thread_pool::reserve(int num_threads)
+{
+  // Growing the pool waits for any running loop, which would never finish
+  // if this thread is one of its workers
+  if (num_threads <= m_num_threads || in_parallel_for) {
+    return;
+  }
+
+  lock_guard<std::mutex> run_lock(m_run_mutex);
+  while (static_cast<int>(m_threads.size()) + 1 < num_threads) {
+    // No loop is running, so the generation is stable until the lock is released
+    m_threads.emplace_back(&thread_pool::worker_main, this, static_cast<int>(m_threads.size()) + 1, m_generation);
+  }
+  m_num_threads = static_cast<int>(m_threads.size()) + 1;
+}
+
+void eval::thread_pool::worker_main(int worker, size_t generation)
+{
+  for (;;) {
+    job *j;
+    {
+      unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+      j = m_job;
+    }
+
+    if (worker < j->num_workers) {
+      j->run_chunks(worker);
+    }
+
+    lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0) {
+      m_done.notify_one();
+    }
+  }
+}
+
+void eval::thread_pool::parallel_for(int num_workers, intptr_t size, intptr_t grain, const loop_function &func)
+{
+  if (size <= 0) {
+    return;
+  }
+
+  grain = max<intptr_t>(grain, 1);
+  intptr_t num_chunks = size / grain;
+  if (num_workers <= 1 || num_chunks <= 1 || in_parallel_for) {
+    func(0, 0, size);
+    return;
+  }
+
+  lock_guard<std::mutex> run_lock(m_run_mutex);
+  num_workers = min(num_workers, get_num_threads());
+
+  // A few chunks per worker, so that stealing can even out the load
+  num_chunks = min(num_chunks, static_cast<intptr_t>(num_workers) * 8);
+  intptr_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  num_chunks = (size + chunk_size - 1) / chunk_size;
+  num_workers = static_cast<int>(min(static_cast<intptr_t>(num_workers), num_chunks));
+
+  job j(func, size, chunk_size, num_chunks, num_workers);
+  {
+    lock_guard<std::mutex> lock(m_mutex);
+    m_job = &j;
+    m_active = static_cast<int>(m_threads.size());
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  j.run_chunks(0);
+
+  {
+    unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&] { return m_active == 0; });
+    m_job = NULL;
+  }
+
+  if (j.error) {
+    rethrow_exception(j.error);
+  }
+}
+
+int eval::resolve_num_threads(int num_threads)
+{
+  if (num_threads > 0) {
+    return num_threads;
+  }
+
+  return max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+
+int eval::plan_workers(const eval_context *ectx, intptr_t size, thread_pool **pool, intptr_t grain)
+{
+  if (ectx->num_threads == 1 || size <= 0) {
+    return 1;
+  }
+
+  if (grain <= 0) {
+    grain = max<intptr_t>(ectx->min_grain_size, 1);
+  }
+  int num_workers = static_cast<int>(min<intptr_t>(resolve_num_threads(ectx->num_threads), size / grain));
+  if (num_workers <= 1) {
+    return 1;
+  }
+
+  *pool = &get_thread_pool(num_workers);
+  return num_workers;
+}
+
+eval::thread_pool &eval::get_thread_pool(int num_threads)
+{
+  // Never destroyed, so that its threads are not joined during static destruction
+  static thread_pool *pool = new thread_pool(1);
+  pool->reserve(resolve_num_threads(num_threads));
+  return *pool;
+}
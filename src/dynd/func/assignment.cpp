@@ -40,6 +40,11 @@ DYND_API nd::callable nd::assign::make()
   children[{{time_type_id, string_type_id}}] = callable::make<assignment_kernel<time_type_id, string_type_id>>();
   children[{{string_type_id, time_type_id}}] = callable::make<assignment_kernel<string_type_id, time_type_id>>();
   children[{{string_type_id, int32_type_id}}] = callable::make<assignment_kernel<string_type_id, int32_type_id>>();
+  // The number to string kernel formats according to the source type it is instantiated with
+  for (type_id_t tp_id : {int8_type_id, int16_type_id, int64_type_id, uint8_type_id, uint16_type_id, uint32_type_id,
+                          uint64_type_id, float32_type_id, float64_type_id}) {
+    children[{{string_type_id, tp_id}}] = callable::make<assignment_kernel<string_type_id, int32_type_id>>();
+  }
   children[{{datetime_type_id, string_type_id}}] =
       callable::make<assignment_kernel<datetime_type_id, string_type_id>>();
   children[{{string_type_id, datetime_type_id}}] =
@@ -202,6 +207,14 @@ DYND_API nd::callable nd::assign::make()
       callable::make<assignment_kernel<complex_float64_type_id, convert_type_id>>();
   children[{{time_type_id, convert_type_id}}] = callable::make<assignment_kernel<time_type_id, convert_type_id>>();
   children[{{date_type_id, convert_type_id}}] = callable::make<assignment_kernel<date_type_id, convert_type_id>>();
+  children[{{categorical_type_id, categorical_type_id}}] =
+      callable::make<assignment_kernel<categorical_type_id, categorical_type_id>>();
+  children[{{string_type_id, categorical_type_id}}] =
+      callable::make<assignment_kernel<string_type_id, categorical_type_id>>();
+  for (const auto &pair : callable::make_all<_bind<assign_error_mode, assignment_kernel>::type, numeric_type_ids,
+                                             type_id_sequence<categorical_type_id>>()) {
+    children[pair.first] = pair.second;
+  }
 
   return functional::multidispatch(
       ndt::type("(Any) -> Any"),
@@ -222,7 +235,7 @@ intptr_t dynd::make_assignment_kernel(void *ckb, intptr_t ckb_offset, const ndt:
 {
   return nd::assign::get()->instantiate(nd::assign::get()->static_data(), NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, 1,
                                         &src_tp, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                        std::map<std::string, ndt::type>());
+                                        ndt::typevar_map());
 }
 
 size_t dynd::make_pod_typed_data_assignment_kernel(void *ckb, intptr_t ckb_offset, size_t data_size,
@@ -27,7 +27,7 @@ struct unary_assignment_ck : nd::base_virtual_kernel<unary_assignment_ck> {
                               const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     assign_error_mode errmode = *reinterpret_cast<assign_error_mode *>(static_data);
     if (errmode == ectx->errmode) {
@@ -51,7 +51,7 @@ struct property_kernel : nd::base_virtual_kernel<property_kernel> {
                               const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     ndt::type prop_src_tp = *reinterpret_cast<ndt::type *>(static_data);
 
@@ -83,6 +83,99 @@ nd::callable dynd::make_callable_from_assignment(const ndt::type &dst_tp, const
   return nd::callable::make<unary_assignment_ck>(ndt::callable_type::make(dst_tp, src_tp), errmode);
 }
 
+nd::bound_kernel nd::callable::prepare(const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
+                                      const ndt::type *src_tp, const char *const *src_arrmeta,
+                                      kernel_request_t kernreq) const
+{
+  if (is_null()) {
+    throw std::invalid_argument("cannot prepare a null callable");
+  }
+  if (get()->kernreq != kernel_request_single) {
+    throw std::invalid_argument("only callables with single ckernels can be prepared");
+  }
+  if (kernreq != kernel_request_single && kernreq != kernel_request_strided) {
+    throw std::invalid_argument("a callable can only be prepared as a single or strided ckernel");
+  }
+
+  const ndt::callable_type *self_tp = get_type();
+  ndt::typevar_map tp_vars;
+
+  detail::check_narg(self_tp, nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    detail::check_arg(self_tp, i, src_tp[i], src_arrmeta[i], tp_vars);
+  }
+
+  ndt::type resolved_dst_tp;
+  if (dst_tp.is_null()) {
+    resolved_dst_tp = self_tp->get_return_type();
+  }
+  else {
+    if (!self_tp->get_return_type().match(NULL, dst_tp, dst_arrmeta, tp_vars)) {
+      std::stringstream ss;
+      ss << "provided \"dst\" type " << dst_tp << " does not match callable return type "
+         << self_tp->get_return_type();
+      throw std::invalid_argument(ss.str());
+    }
+    resolved_dst_tp = dst_tp;
+  }
+
+  // Optional keyword arguments are missing, all others are required
+  std::vector<array> kwds(self_tp->get_nkwd());
+  intptr_t nkwd = 0;
+  for (intptr_t j : self_tp->get_option_kwd_indices()) {
+    ndt::type actual_tp = ndt::substitute(self_tp->get_kwd_type(j), tp_vars, false);
+    if (actual_tp.is_symbolic()) {
+      actual_tp = ndt::option_type::make(ndt::type::make<void>());
+    }
+    kwds[j] = empty(actual_tp);
+    kwds[j].assign_na();
+    ++nkwd;
+  }
+  if (nkwd < self_tp->get_nkwd()) {
+    std::stringstream ss;
+    ss << "cannot prepare a callable with required keyword parameters. callable signature " << get()->tp;
+    throw std::invalid_argument(ss.str());
+  }
+
+  char *data = get()->data_init(get()->static_data(), resolved_dst_tp, nsrc, src_tp, nkwd, kwds.data(), tp_vars);
+
+  // Resolve the destination type
+  if (resolved_dst_tp.is_symbolic()) {
+    if (get()->resolve_dst_type == NULL) {
+      throw std::runtime_error("dst_tp is symbolic, but resolve_dst_type is NULL");
+    }
+
+    get()->resolve_dst_type(get()->static_data(), data, resolved_dst_tp, nsrc, src_tp, nkwd, kwds.data(), tp_vars);
+  }
+
+  std::unique_ptr<arrmeta_holder> dst_arrmeta_holder;
+  if (dst_arrmeta == NULL && resolved_dst_tp.get_arrmeta_size() > 0) {
+    dst_arrmeta_holder.reset(new arrmeta_holder(resolved_dst_tp));
+    dst_arrmeta_holder->arrmeta_default_construct(true);
+    dst_arrmeta = dst_arrmeta_holder->get();
+  }
+
+  std::unique_ptr<ckernel_builder<kernel_request_host>> ckb(new ckernel_builder<kernel_request_host>());
+  intptr_t ckb_size =
+      get()->instantiate(get()->static_data(), data, ckb.get(), 0, resolved_dst_tp, dst_arrmeta, nsrc, src_tp,
+                         src_arrmeta, kernreq, &eval::default_eval_context, nkwd, kwds.data(), tp_vars);
+
+  return bound_kernel(*this, kernreq, resolved_dst_tp, std::move(dst_arrmeta_holder), dst_arrmeta, std::move(ckb),
+                      ckb_size);
+}
+
+nd::bound_kernel nd::callable::prepare(intptr_t nsrc, const array *src, kernel_request_t kernreq) const
+{
+  std::vector<ndt::type> src_tp(nsrc);
+  std::vector<const char *> src_arrmeta(nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    src_tp[i] = src[i].get_type();
+    src_arrmeta[i] = src[i].get()->metadata();
+  }
+
+  return prepare(nsrc, src_tp.data(), src_arrmeta.data(), kernreq);
+}
+
 void nd::detail::check_narg(const ndt::callable_type *af_tp, intptr_t narg)
 {
   if (!af_tp->is_pos_variadic() && narg != af_tp->get_npos()) {
@@ -93,7 +186,7 @@ void nd::detail::check_narg(const ndt::callable_type *af_tp, intptr_t narg)
 }
 
 void nd::detail::check_arg(const ndt::callable_type *af_tp, intptr_t i, const ndt::type &actual_tp,
-                           const char *actual_arrmeta, std::map<std::string, ndt::type> &tp_vars)
+                           const char *actual_arrmeta, ndt::typevar_map &tp_vars)
 {
   if (af_tp->is_pos_variadic()) {
     return;
@@ -228,6 +228,8 @@ std::map<std::string, nd::callable> &func::get_regfunctions()
     registry["power"] = make_ufunc(&powf, static_cast<double (*)(double, double)>(&::pow));
 
     registry["uniform"] = nd::random::uniform;
+    registry["normal"] = nd::random::normal;
+    registry["exponential"] = nd::random::exponential;
     registry["take"] = nd::take;
     registry["sum"] = nd::sum;
     registry["is_avail"] = nd::is_avail;
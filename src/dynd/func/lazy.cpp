@@ -0,0 +1,268 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <unordered_map>
+
+#include <dynd/arrmeta_holder.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/func/elwise.hpp>
+#include <dynd/func/lazy.hpp>
+#include <dynd/kernels/fused_kernel.hpp>
+
+using namespace std;
+using namespace dynd;
+
+struct nd::functional::detail::lazy_node {
+  // The array of a leaf
+  array value;
+  // The callable and operands of an operation
+  callable f;
+  vector<lazy> args;
+  ndt::type dtype;
+  ndt::typevar_map tp_vars;
+
+  static const lazy_node *get(const lazy &expr);
+};
+
+namespace {
+
+typedef nd::functional::detail::lazy_node lazy_node;
+
+/**
+ * Numbers the nodes of an expression DAG. Leaves get the first slots, one per
+ * distinct array, and the operations follow in an order where every operation
+ * comes after its operands.
+ */
+struct lazy_numbering {
+  unordered_map<const lazy_node *, intptr_t> slots;
+  unordered_map<const void *, intptr_t> leaf_slots;
+  vector<nd::array> leaves;
+  vector<const lazy_node *> ops;
+
+  void add_leaves(const lazy_node *node)
+  {
+    if (slots.count(node)) {
+      return;
+    }
+
+    if (node->f.is_null()) {
+      // The same array reached through different nodes is one argument
+      auto it = leaf_slots.find(node->value.get());
+      if (it == leaf_slots.end()) {
+        it = leaf_slots.emplace(node->value.get(), leaves.size()).first;
+        leaves.push_back(node->value);
+      }
+      slots[node] = it->second;
+    }
+    else {
+      slots[node] = -1;
+      for (const nd::functional::lazy &arg : node->args) {
+        add_leaves(lazy_node::get(arg));
+      }
+    }
+  }
+
+  void add_ops(const lazy_node *node)
+  {
+    if (node->f.is_null() || slots[node] != -1) {
+      return;
+    }
+
+    for (const nd::functional::lazy &arg : node->args) {
+      add_ops(lazy_node::get(arg));
+    }
+    slots[node] = leaves.size() + ops.size();
+    ops.push_back(node);
+  }
+};
+
+/**
+ * Releases the data made by the data_init of ``self`` to resolve the type of a
+ * lazy operation. Only its instantiate knows how to free it, so this builds a
+ * kernel which takes the data, and destroys it right away.
+ */
+void release_data(nd::base_callable *self, char *data, const ndt::type &dst_tp, const vector<ndt::type> &src_tp,
+                  const ndt::typevar_map &tp_vars)
+{
+  intptr_t nsrc = src_tp.size();
+  arrmeta_holder dst_arrmeta(dst_tp);
+  dst_arrmeta.arrmeta_default_construct(true);
+  unique_ptr<arrmeta_holder[]> src_arrmeta_holders(new arrmeta_holder[nsrc]);
+  vector<const char *> src_arrmeta(nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    arrmeta_holder(src_tp[i]).swap(src_arrmeta_holders[i]);
+    src_arrmeta_holders[i].arrmeta_default_construct(true);
+    src_arrmeta[i] = src_arrmeta_holders[i].get();
+  }
+
+  ckernel_builder<kernel_request_host> ckb;
+  self->instantiate(self->static_data(), data, &ckb, 0, dst_tp, dst_arrmeta.get(), nsrc, src_tp.data(),
+                    src_arrmeta.data(), kernel_request_single, &eval::default_eval_context, 0, NULL, tp_vars);
+}
+
+/**
+ * Calls release_data when it goes out of scope, so the data of a lazy
+ * operation is released on every path, including the ones which throw. A type
+ * which stays symbolic can't be instantiated, so failing to release it is
+ * ignored.
+ */
+struct data_release_guard {
+  nd::base_callable *self;
+  char *data;
+  const ndt::type &dst_tp;
+  const vector<ndt::type> &src_tp;
+  const ndt::typevar_map &tp_vars;
+
+  ~data_release_guard()
+  {
+    if (data != NULL) {
+      try {
+        release_data(self, data, dst_tp, src_tp, tp_vars);
+      }
+      catch (...) {
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+const lazy_node *lazy_node::get(const lazy &expr) { return expr.m_node.get(); }
+
+nd::functional::lazy::lazy(const array &a)
+{
+  if (a.is_null()) {
+    throw invalid_argument("cannot make a lazy expression from a null array");
+  }
+
+  shared_ptr<detail::lazy_node> node = make_shared<detail::lazy_node>();
+  node->value = a;
+  node->dtype = a.get_dtype();
+  m_node = node;
+}
+
+nd::functional::lazy::lazy(const callable &f, const vector<lazy> &args)
+{
+  if (f.is_null()) {
+    throw invalid_argument("cannot make a lazy expression from a null callable");
+  }
+
+  const ndt::callable_type *f_tp = f.get_type();
+  if (f_tp->get_nkwd() != 0) {
+    stringstream ss;
+    ss << "cannot use callable " << f << " in a lazy expression, because it has keyword parameters";
+    throw invalid_argument(ss.str());
+  }
+
+  intptr_t nsrc = args.size();
+  shared_ptr<detail::lazy_node> node = make_shared<detail::lazy_node>();
+  vector<ndt::type> src_tp(nsrc);
+  nd::detail::check_narg(f_tp, nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    src_tp[i] = args[i].get_dtype();
+    nd::detail::check_arg(f_tp, i, src_tp[i], NULL, node->tp_vars);
+  }
+
+  ndt::type dtype = f_tp->get_return_type();
+  if (dtype.is_symbolic()) {
+    base_callable *self = const_cast<base_callable *>(f.get());
+    if (self->resolve_dst_type == NULL) {
+      throw runtime_error("dst_tp is symbolic, but resolve_dst_type is NULL");
+    }
+
+    char *data = self->data_init(self->static_data(), dtype, nsrc, src_tp.data(), 0, NULL, node->tp_vars);
+    data_release_guard guard{self, data, dtype, src_tp, node->tp_vars};
+    self->resolve_dst_type(self->static_data(), data, dtype, nsrc, src_tp.data(), 0, NULL, node->tp_vars);
+  }
+  if (dtype.is_symbolic() || dtype.get_ndim() != 0) {
+    stringstream ss;
+    ss << "cannot use callable " << f << " in a lazy expression, because its result " << dtype
+       << " is not a scalar";
+    throw type_error(ss.str());
+  }
+
+  node->f = f;
+  node->args = args;
+  node->dtype = dtype;
+  m_node = node;
+}
+
+const ndt::type &nd::functional::lazy::get_dtype() const { return m_node->dtype; }
+
+/**
+ * Fuses the expression at ``root`` into a callable returning ``dtype``. When
+ * it differs from the type of the expression, the result is converted in the
+ * last step of each block.
+ */
+static nd::callable make_fused(const lazy_node *root, const ndt::type &dtype, vector<nd::array> &args)
+{
+  lazy_numbering numbering;
+  numbering.add_leaves(root);
+  numbering.add_ops(root);
+
+  intptr_t nleaf = numbering.leaves.size();
+  vector<nd::functional::fused_step> steps(numbering.ops.size());
+  for (size_t k = 0; k < steps.size(); ++k) {
+    const lazy_node *node = numbering.ops[k];
+    nd::functional::fused_step &step = steps[k];
+    step.child = node->f;
+    for (const nd::functional::lazy &arg : node->args) {
+      const lazy_node *arg_node = lazy_node::get(arg);
+      step.args.push_back(numbering.slots[arg_node]);
+      step.src_tp.push_back(arg_node->dtype);
+    }
+    step.dst_tp = node->dtype;
+    step.tp_vars = node->tp_vars;
+  }
+
+  // An expression which is just an array copies it
+  if (steps.empty()) {
+    nd::functional::fused_step step;
+    step.child = make_callable_from_assignment(root->dtype, root->dtype, assign_error_nocheck);
+    step.args.push_back(0);
+    step.src_tp.push_back(root->dtype);
+    step.dst_tp = root->dtype;
+    steps.push_back(std::move(step));
+  }
+
+  nd::array pos_tp = nd::empty(nleaf, ndt::make_type<ndt::type_type>());
+  ndt::type *pos_tp_data = reinterpret_cast<ndt::type *>(pos_tp.data());
+  for (intptr_t i = 0; i < nleaf; ++i) {
+    pos_tp_data[i] = numbering.leaves[i].get_dtype();
+  }
+
+  args = std::move(numbering.leaves);
+  return nd::functional::elwise(nd::callable::make<nd::functional::fused_kernel>(
+      ndt::callable_type::make(dtype, pos_tp), nd::functional::fused_kernel::static_data(nleaf, std::move(steps))));
+}
+
+nd::callable nd::functional::lazy::fuse(vector<array> &args) const
+{
+  return make_fused(m_node.get(), m_node->dtype, args);
+}
+
+nd::array nd::functional::lazy::eval() const
+{
+  vector<array> args;
+  callable f = fuse(args);
+  return f(args.size(), args.data());
+}
+
+void nd::functional::lazy::eval(const array &dst) const
+{
+  vector<array> args;
+  callable f = make_fused(m_node.get(), dst.get_dtype(), args);
+  f(args.size(), args.data(), kwds("dst", dst));
+}
+
+nd::functional::lazy nd::functional::operator+(const lazy &a0, const lazy &a1) { return lazy(add, {a0, a1}); }
+
+nd::functional::lazy nd::functional::operator-(const lazy &a0, const lazy &a1) { return lazy(subtract, {a0, a1}); }
+
+nd::functional::lazy nd::functional::operator*(const lazy &a0, const lazy &a1) { return lazy(multiply, {a0, a1}); }
+
+nd::functional::lazy nd::functional::operator/(const lazy &a0, const lazy &a1) { return lazy(divide, {a0, a1}); }
+
+nd::functional::lazy nd::functional::operator-(const lazy &a0) { return lazy(minus, {a0}); }
@@ -61,7 +61,7 @@ DYND_API nd::callable nd::cos::make()
   */
 
   return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+      functional::dispatch(pattern_tp, children.begin(), children.end()));
 }
 
 DYND_API nd::callable nd::sin::make()
@@ -88,7 +88,7 @@ DYND_API nd::callable nd::sin::make()
   */
 
   return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+      functional::dispatch(pattern_tp, children.begin(), children.end()));
 }
 
 DYND_API nd::callable nd::tan::make()
@@ -115,7 +115,7 @@ DYND_API nd::callable nd::tan::make()
   */
 
   return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+      functional::dispatch(pattern_tp, children.begin(), children.end()));
 }
 
 DYND_API nd::callable nd::exp::make()
@@ -142,7 +142,7 @@ DYND_API nd::callable nd::exp::make()
   */
 
   return functional::elwise(
-      functional::multidispatch(pattern_tp, children.begin(), children.end()));
+      functional::dispatch(pattern_tp, children.begin(), children.end()));
 }
 
 DYND_API struct nd::cos nd::cos;
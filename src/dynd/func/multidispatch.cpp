@@ -31,7 +31,7 @@ static bool supercedes(const nd::callable &lhs, const nd::callable &rhs)
     for (intptr_t i = 0; i < npos; ++i) {
       const ndt::type &lpt = lhs.get_type()->get_pos_type(i);
       const ndt::type &rpt = rhs.get_type()->get_pos_type(i);
-      std::map<std::string, ndt::type> typevars;
+      ndt::typevar_map typevars;
       if (!nd::functional::can_implicitly_convert(lpt, rpt, typevars)) {
         return false;
       }
@@ -60,7 +60,7 @@ static bool toposort_edge(const nd::callable &lhs, const nd::callable &rhs)
     for (intptr_t i = 0; i < npos; ++i) {
       const ndt::type &lpt = lhs.get_type()->get_pos_type(i);
       const ndt::type &rpt = rhs.get_type()->get_pos_type(i);
-      std::map<std::string, ndt::type> typevars;
+      ndt::typevar_map typevars;
       if (lpt.get_kind() >= rpt.get_kind() &&
           !nd::functional::can_implicitly_convert(lpt, rpt, typevars)) {
         return false;
@@ -91,7 +91,7 @@ static bool ambiguous(const nd::callable &lhs, const nd::callable &rhs)
       const ndt::type &lpt = lhs.get_type()->get_pos_type(i);
       const ndt::type &rpt = rhs.get_type()->get_pos_type(i);
       bool either = false;
-      std::map<std::string, ndt::type> typevars;
+      ndt::typevar_map typevars;
       if (nd::functional::can_implicitly_convert(lpt, rpt, typevars)) {
         lsupercount++;
         either = true;
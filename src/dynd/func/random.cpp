@@ -1,18 +1,45 @@
-#include <chrono>
+#include <atomic>
+#include <random>
 
-#include <dynd/func/elwise.hpp>
 #include <dynd/func/random.hpp>
 #include <dynd/func/multidispatch.hpp>
-#include <dynd/kernels/uniform_kernel.hpp>
+#include <dynd/kernels/random_kernels.hpp>
 
 using namespace std;
 using namespace dynd;
 
-template <typename GeneratorType>
-struct uniform_kernel_alias {
-  template <type_id_t DstTypeID>
-  using type = nd::random::uniform_kernel<DstTypeID, GeneratorType>;
-};
+uint64_t nd::random::get_default_seed()
+{
+  static const uint64_t seed = [] {
+    random_device random_device;
+    return (static_cast<uint64_t>(random_device()) << 32) | random_device();
+  }();
+
+  return seed;
+}
+
+uint32_t nd::random::get_next_default_stream()
+{
+  static atomic<uint32_t> next_stream(0);
+
+  return next_stream++;
+}
+
+namespace {
+
+nd::callable make_random_dispatcher(const char *name, const char *signature,
+                                    const nd::callable (&children)[DYND_TYPE_ID_MAX + 1])
+{
+  return nd::functional::dispatch_dst(ndt::type(signature), children, [name](const ndt::type &dst_tp,
+                                                                             intptr_t DYND_UNUSED(nsrc),
+                                                                             const ndt::type *DYND_UNUSED(src_tp)) {
+    stringstream ss;
+    ss << name << ": cannot generate values of type " << dst_tp.get_dtype();
+    throw type_error(ss.str());
+  });
+}
+
+} // anonymous namespace
 
 DYND_API nd::callable nd::random::uniform::children[DYND_TYPE_ID_MAX + 1];
 
@@ -21,25 +48,42 @@ DYND_API nd::callable nd::random::uniform::make()
   typedef type_id_sequence<int32_type_id, int64_type_id, uint32_type_id, uint64_type_id, float32_type_id,
                            float64_type_id, complex_float32_type_id, complex_float64_type_id> numeric_type_ids;
 
-  std::random_device random_device;
+  for (const auto &pair : callable::make_all<uniform_kernel, numeric_type_ids>()) {
+    children[pair.first] = pair.second;
+  }
 
+  return make_random_dispatcher("uniform", "(a: ?R, b: ?R, seed: ?Int, stream: ?Int) -> Dims... * R", children);
+}
+
+DYND_API struct nd::random::uniform nd::random::uniform;
+
+DYND_API nd::callable nd::random::normal::children[DYND_TYPE_ID_MAX + 1];
+
+DYND_API nd::callable nd::random::normal::make()
+{
+  for (const auto &pair : callable::make_all<normal_kernel, type_id_sequence<float32_type_id, float64_type_id>>()) {
+    children[pair.first] = pair.second;
+  }
+
+  return make_random_dispatcher("normal", "(mean: ?R, stddev: ?R, seed: ?Int, stream: ?Int) -> Dims... * R",
+                                children);
+}
+
+DYND_API struct nd::random::normal nd::random::normal;
+
+DYND_API nd::callable nd::random::exponential::children[DYND_TYPE_ID_MAX + 1];
+
+DYND_API nd::callable nd::random::exponential::make()
+{
   for (const auto &pair :
-       callable::make_all<uniform_kernel_alias<std::default_random_engine>::type, numeric_type_ids>(0)) {
+       callable::make_all<exponential_kernel, type_id_sequence<float32_type_id, float64_type_id>>()) {
     children[pair.first] = pair.second;
   }
 
-  return functional::elwise(functional::multidispatch(
-      ndt::type("(a: ?R, b: ?R) -> R"),
-      [](const ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp)) -> callable & {
-        callable &child = children[dst_tp.get_type_id()];
-        if (child.is_null()) {
-          throw std::runtime_error("assignment error");
-        }
-        return child;
-      }));
+  return make_random_dispatcher("exponential", "(lambda: ?R, seed: ?Int, stream: ?Int) -> Dims... * R", children);
 }
 
-DYND_API struct nd::random::uniform nd::random::uniform;
+DYND_API struct nd::random::exponential nd::random::exponential;
 
 /*
 
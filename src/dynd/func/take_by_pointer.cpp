@@ -60,7 +60,7 @@ struct take_by_pointer_virtual_ck : nd::base_virtual_kernel<take_by_pointer_virt
                               const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                               const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     intptr_t ndim = src_tp[0].get_ndim();
 
@@ -102,7 +102,7 @@ struct take_by_pointer_virtual_ck : nd::base_virtual_kernel<take_by_pointer_virt
   static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
                                const nd::array *DYND_UNUSED(kwds),
-                               const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                               const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     /*
         if (nsrc != 2) {
@@ -0,0 +1,354 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/jit.hpp>
+
+using namespace std;
+using namespace dynd;
+
+#ifdef DYND_LLVM
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Transforms/InstCombine/InstCombine.h>
+#include <llvm/Transforms/Scalar/EarlyCSE.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+namespace {
+
+// The most rounds of inlining children whose function pointers were folded
+const int max_inline_rounds = 16;
+
+struct kernel_ir {
+  const char *ir;
+  const char *name;
+};
+
+/**
+ * The IR registered for each kernel function, and the functions compiled
+ * so far, keyed by the bytes of the ckernel tree they were compiled from.
+ */
+class jit_state {
+  mutex m_mutex;
+  unordered_map<const void *, kernel_ir> m_ir;
+  unordered_map<string, expr_strided_t> m_compiled;
+  unique_ptr<llvm::orc::LLJIT> m_jit;
+  atomic<int> m_count;
+
+public:
+  jit_state() : m_count(0) {}
+
+  void register_ir(void *single, void *strided, const char *ir)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_ir[single] = kernel_ir{ir, "single_wrapper"};
+    m_ir[strided] = kernel_ir{ir, "strided_wrapper"};
+  }
+
+  bool find_ir(const void *fn, kernel_ir &out)
+  {
+    auto it = m_ir.find(fn);
+    if (it == m_ir.end()) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+
+  expr_strided_t specialize(ckernel_prefix *self, intptr_t size);
+
+private:
+  llvm::orc::LLJIT &get_jit();
+
+  llvm::Function *load_kernel(llvm::Module &m, const void *fn, unordered_map<const void *, llvm::Function *> &loaded);
+};
+
+jit_state &get_jit_state()
+{
+  static jit_state state;
+  return state;
+}
+
+llvm::orc::LLJIT &jit_state::get_jit()
+{
+  if (m_jit == NULL) {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    m_jit = llvm::cantFail(llvm::orc::LLJITBuilder().create());
+    // The IR of the kernels calls into libdynd and the C++ runtime
+    m_jit->getMainJITDylib().addGenerator(llvm::cantFail(
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(m_jit->getDataLayout().getGlobalPrefix())));
+  }
+
+  return *m_jit;
+}
+
+/**
+ * Returns the function in ``m`` for the kernel function at address ``fn``,
+ * linking its IR into ``m`` the first time, or NULL if it has no IR.
+ */
+llvm::Function *jit_state::load_kernel(llvm::Module &m, const void *fn,
+                                       unordered_map<const void *, llvm::Function *> &loaded)
+{
+  auto it = loaded.find(fn);
+  if (it != loaded.end()) {
+    return it->second;
+  }
+
+  kernel_ir kir;
+  if (!find_ir(fn, kir)) {
+    return NULL;
+  }
+
+  llvm::SMDiagnostic err;
+  unique_ptr<llvm::Module> kernel_m =
+      llvm::parseIR(llvm::MemoryBufferRef(kir.ir, "dynd_kernel_ir"), err, m.getContext());
+  if (kernel_m == NULL) {
+    return NULL;
+  }
+
+  // Every kernel type defines the same two names, so give them unique ones
+  string name = "dynd_kernel_" + to_string(reinterpret_cast<uintptr_t>(fn));
+  llvm::Function *f = kernel_m->getFunction(kir.name);
+  if (f == NULL || f->isDeclaration()) {
+    return NULL;
+  }
+  f->setName(name);
+  for (llvm::Function &other : *kernel_m) {
+    if (&other != f && !other.isDeclaration()) {
+      other.setLinkage(llvm::GlobalValue::InternalLinkage);
+    }
+  }
+  kernel_m->setDataLayout(m.getDataLayout());
+  kernel_m->setTargetTriple(m.getTargetTriple());
+  if (llvm::Linker::linkModules(m, move(kernel_m))) {
+    return NULL;
+  }
+
+  f = m.getFunction(name);
+  f->setLinkage(llvm::GlobalValue::InternalLinkage);
+  loaded[fn] = f;
+  return f;
+}
+
+/** Returns the address of a call through a constant function pointer, or NULL */
+const void *get_constant_callee(llvm::CallBase &call)
+{
+  llvm::Value *callee = call.getCalledOperand()->stripPointerCasts();
+  if (llvm::ConstantExpr *ce = llvm::dyn_cast<llvm::ConstantExpr>(callee)) {
+    if (ce->getOpcode() == llvm::Instruction::IntToPtr) {
+      if (llvm::ConstantInt *ci = llvm::dyn_cast<llvm::ConstantInt>(ce->getOperand(0))) {
+        return reinterpret_cast<const void *>(static_cast<uintptr_t>(ci->getZExtValue()));
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Whether ``f`` may write to the folded ckernel data ``data``, either itself
+ * or, if ``calls`` is true, by passing a pointer into it to a function which
+ * was not inlined.
+ */
+bool writes_to(llvm::Function &f, llvm::GlobalVariable *data, bool calls)
+{
+  auto points_into = [data](llvm::Value *v) {
+    return v->getType()->isPointerTy() && llvm::getUnderlyingObject(v, 0) == data;
+  };
+
+  for (llvm::Instruction &inst : llvm::instructions(f)) {
+    if (llvm::StoreInst *store = llvm::dyn_cast<llvm::StoreInst>(&inst)) {
+      if (points_into(store->getPointerOperand())) {
+        return true;
+      }
+    }
+    else if (llvm::CallBase *call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+      if (!calls || llvm::isa<llvm::DbgInfoIntrinsic>(call) || call->onlyReadsMemory()) {
+        continue;
+      }
+      for (llvm::Value *arg : call->args()) {
+        if (points_into(arg)) {
+          return true;
+        }
+      }
+    }
+    else if (llvm::isa<llvm::AtomicRMWInst>(inst) || llvm::isa<llvm::AtomicCmpXchgInst>(inst)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+expr_strided_t jit_state::specialize(ckernel_prefix *self, intptr_t size)
+{
+  string key(reinterpret_cast<const char *>(self), size);
+
+  lock_guard<mutex> lock(m_mutex);
+  auto it = m_compiled.find(key);
+  if (it != m_compiled.end()) {
+    return it->second;
+  }
+
+  kernel_ir root_ir;
+  if (!find_ir(self->function, root_ir) || strcmp(root_ir.name, "strided_wrapper") != 0) {
+    return NULL;
+  }
+
+  llvm::orc::LLJIT &jit = get_jit();
+  unique_ptr<llvm::LLVMContext> ctx(new llvm::LLVMContext());
+  unique_ptr<llvm::Module> m(new llvm::Module("dynd_jit", *ctx));
+  m->setDataLayout(jit.getDataLayout());
+  m->setTargetTriple(jit.getTargetTriple().str());
+
+  unordered_map<const void *, llvm::Function *> loaded;
+  llvm::Function *root = load_kernel(*m, self->function, loaded);
+  if (root == NULL) {
+    m_compiled[key] = NULL;
+    return NULL;
+  }
+
+  // The ckernel tree, as constant data in place of self
+  llvm::GlobalVariable *data = new llvm::GlobalVariable(
+      *m, llvm::ArrayType::get(llvm::Type::getInt8Ty(*ctx), size), true, llvm::GlobalValue::PrivateLinkage,
+      llvm::ConstantDataArray::getRaw(llvm::StringRef(key), size, llvm::Type::getInt8Ty(*ctx)), "dynd_ckernel");
+  data->setAlignment(llvm::Align(alignof(max_align_t)));
+
+  string name = "dynd_jit_strided_" + to_string(m_count++);
+  llvm::Function *entry =
+      llvm::Function::Create(root->getFunctionType(), llvm::GlobalValue::ExternalLinkage, name, *m);
+  {
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(*ctx, "entry", entry));
+    vector<llvm::Value *> args;
+    auto arg = entry->arg_begin();
+    args.push_back(builder.CreatePointerCast(data, arg->getType()));
+    for (++arg; arg != entry->arg_end(); ++arg) {
+      args.push_back(&*arg);
+    }
+    builder.CreateCall(root, args);
+    builder.CreateRetVoid();
+  }
+
+  llvm::LoopAnalysisManager lam;
+  llvm::FunctionAnalysisManager fam;
+  llvm::CGSCCAnalysisManager cgam;
+  llvm::ModuleAnalysisManager mam;
+  llvm::PassBuilder pb;
+  pb.registerModuleAnalyses(mam);
+  pb.registerCGSCCAnalyses(cgam);
+  pb.registerFunctionAnalyses(fam);
+  pb.registerLoopAnalyses(lam);
+  pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+  llvm::FunctionPassManager fold;
+  fold.addPass(llvm::InstCombinePass());
+  fold.addPass(llvm::EarlyCSEPass());
+
+  // Inline the root and its children, folding the loads of each child's
+  // function pointer to find the next ones
+  for (int round = 0; round < max_inline_rounds; ++round) {
+    vector<llvm::CallBase *> calls;
+    for (llvm::Instruction &inst : llvm::instructions(*entry)) {
+      if (llvm::CallBase *call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+        calls.push_back(call);
+      }
+    }
+
+    bool changed = false;
+    for (llvm::CallBase *call : calls) {
+      llvm::Function *callee = call->getCalledFunction();
+      if (callee == NULL) {
+        const void *fn = get_constant_callee(*call);
+        if (fn == NULL || (callee = load_kernel(*m, fn, loaded)) == NULL) {
+          continue;
+        }
+        call->setCalledFunction(callee);
+      }
+      if (callee->isDeclaration() || callee->isVarArg()) {
+        continue;
+      }
+
+      llvm::InlineFunctionInfo ifi;
+      changed |= llvm::InlineFunction(*call, ifi).isSuccess();
+    }
+    if (!changed) {
+      break;
+    }
+
+    // Check the stores before folding, which drops those to constant memory.
+    // The calls are checked once the children have been inlined.
+    if (writes_to(*entry, data, false)) {
+      m_compiled[key] = NULL;
+      return NULL;
+    }
+
+    fold.run(*entry, fam);
+    fam.invalidate(*entry, llvm::PreservedAnalyses::none());
+  }
+
+  if (writes_to(*entry, data, true) || llvm::verifyModule(*m)) {
+    m_compiled[key] = NULL;
+    return NULL;
+  }
+
+  // The full pipeline, which vectorizes the element loop
+  for (llvm::Function &f : *m) {
+    if (&f != entry && !f.isDeclaration()) {
+      f.setLinkage(llvm::GlobalValue::InternalLinkage);
+    }
+  }
+  pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3).run(*m, mam);
+
+  llvm::cantFail(jit.addIRModule(llvm::orc::ThreadSafeModule(move(m), move(ctx))));
+  expr_strided_t fn = reinterpret_cast<expr_strided_t>(llvm::cantFail(jit.lookup(name)).getAddress());
+  m_compiled[key] = fn;
+  return fn;
+}
+
+} // anonymous namespace
+
+bool nd::jit::is_available() { return true; }
+
+void nd::jit::register_ir(void *single, void *strided, const char *ir)
+{
+  if (ir != NULL) {
+    get_jit_state().register_ir(single, strided, ir);
+  }
+}
+
+expr_strided_t nd::jit::specialize(ckernel_prefix *self, intptr_t size)
+{
+  return get_jit_state().specialize(self, size);
+}
+
+#else
+
+bool nd::jit::is_available() { return false; }
+
+void nd::jit::register_ir(void *DYND_UNUSED(single), void *DYND_UNUSED(strided), const char *DYND_UNUSED(ir)) {}
+
+expr_strided_t nd::jit::specialize(ckernel_prefix *DYND_UNUSED(self), intptr_t DYND_UNUSED(size)) { return NULL; }
+
+#endif
@@ -3,7 +3,18 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <dynd/json_formatter.hpp>
+#include <dynd/number_conversion.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/date_type.hpp>
@@ -20,11 +31,38 @@ struct output_data {
   dynd::string out_string;
   char *out_begin, *out_end, *out_capacity_end;
   bool struct_as_list;
+  // When not NULL, the buffer is passed to the sink when full instead of growing
+  json_sink *sink;
+
+  output_data() : out_begin(NULL), out_end(NULL), out_capacity_end(NULL), struct_as_list(false), sink(NULL) {}
+
+  void init(intptr_t capacity)
+  {
+    out_string.resize(capacity);
+    out_begin = out_string.begin();
+    out_capacity_end = out_string.end();
+    out_end = out_begin;
+  }
+
+  // Pass the buffered output to the sink
+  void flush()
+  {
+    if (out_end != out_begin) {
+      sink->write(out_begin, out_end);
+      out_end = out_begin;
+    }
+  }
 
   void ensure_capacity(intptr_t added_capacity)
   {
-    // If there's not enough space, double the capacity
     if (out_capacity_end - out_end < added_capacity) {
+      if (sink != NULL) {
+        flush();
+        if (out_capacity_end - out_begin >= added_capacity) {
+          return;
+        }
+      }
+      // If there's not enough space, double the capacity
       intptr_t current_size = out_end - out_begin;
       intptr_t new_capacity = 2 * (out_capacity_end - out_begin);
       // Make sure this adds the requested additional capacity
@@ -54,16 +92,24 @@ struct output_data {
   }
 
   // Write a std::string
-  inline void write(const std::string &s)
-  {
-    ensure_capacity(s.size());
-    memcpy(out_end, s.data(), s.size());
-    out_end += s.size();
-  }
+  inline void write(const std::string &s) { write(s.data(), s.data() + s.size()); }
 
   // Write a string-range
   inline void write(const char *begin, const char *end)
   {
+    if (sink != NULL && end - begin > out_capacity_end - out_begin) {
+      // Too big for the buffer, so it goes to the sink in buffer sized pieces
+      while (begin < end) {
+        intptr_t size = std::min(end - begin, out_capacity_end - out_end);
+        memcpy(out_end, begin, size);
+        out_end += size;
+        begin += size;
+        if (out_end == out_capacity_end) {
+          flush();
+        }
+      }
+      return;
+    }
     ensure_capacity(end - begin);
     memcpy(out_end, begin, end - begin);
     out_end += (end - begin);
@@ -89,6 +135,13 @@ static void format_json_bool(output_data &out, const ndt::type &dt, const char *
 
 static void format_json_number(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data)
 {
+  char buffer[number_format_max_size];
+  char *buffer_end = format_builtin_number(buffer, dt.get_type_id(), data);
+  if (buffer_end != NULL) {
+    out.write(buffer, buffer_end);
+    return;
+  }
+
   stringstream ss;
   dt.print_data(ss, arrmeta, data);
   out.write(ss.str());
@@ -255,9 +308,13 @@ static void format_json_struct(output_data &out, const ndt::type &dt, const char
   }
 }
 
-static void format_json_dim(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data)
+/**
+ * Calls ``f(element_tp, element_arrmeta, element_data, i, size)`` for each
+ * element of the fixed_dim or var_dim array.
+ */
+template <typename F>
+static void for_each_dim_element(const ndt::type &dt, const char *arrmeta, const char *data, F f)
 {
-  out.write('[');
   switch (dt.get_type_id()) {
   case fixed_dim_type_id: {
     const ndt::base_dim_type *sad = dt.extended<ndt::base_dim_type>();
@@ -266,10 +323,7 @@ static void format_json_dim(output_data &out, const ndt::type &dt, const char *a
     intptr_t size = md->dim_size, stride = md->stride;
     arrmeta += sizeof(fixed_dim_type_arrmeta);
     for (intptr_t i = 0; i < size; ++i) {
-      ::format_json(out, element_tp, arrmeta, data + i * stride);
-      if (i != size - 1) {
-        out.write(',');
-      }
+      f(element_tp, arrmeta, data + i * stride, i, size);
     }
     break;
   }
@@ -282,10 +336,7 @@ static void format_json_dim(output_data &out, const ndt::type &dt, const char *a
     const char *begin = d->begin + md->offset;
     arrmeta += sizeof(var_dim_type_arrmeta);
     for (intptr_t i = 0; i < size; ++i) {
-      ::format_json(out, element_tp, arrmeta, begin + i * stride);
-      if (i != size - 1) {
-        out.write(',');
-      }
+      f(element_tp, arrmeta, begin + i * stride, i, size);
     }
     break;
   }
@@ -295,6 +346,18 @@ static void format_json_dim(output_data &out, const ndt::type &dt, const char *a
     throw runtime_error(ss.str());
   }
   }
+}
+
+static void format_json_dim(output_data &out, const ndt::type &dt, const char *arrmeta, const char *data)
+{
+  out.write('[');
+  for_each_dim_element(dt, arrmeta, data, [&out](const ndt::type &element_tp, const char *element_arrmeta,
+                                                 const char *element_data, intptr_t i, intptr_t size) {
+    ::format_json(out, element_tp, element_arrmeta, element_data);
+    if (i != size - 1) {
+      out.write(',');
+    }
+  });
   out.write(']');
 }
 
@@ -343,10 +406,7 @@ nd::array dynd::format_json(const nd::array &n, bool struct_as_list)
 
   // Initialize the output with some memory
   output_data out;
-  out.out_string.resize(1024);
-  out.out_begin = out.out_string.begin();
-  out.out_capacity_end = out.out_string.end();
-  out.out_end = out.out_begin;
+  out.init(1024);
   out.struct_as_list = struct_as_list;
 
   if (!n.get_type().is_expression()) {
@@ -366,3 +426,91 @@ nd::array dynd::format_json(const nd::array &n, bool struct_as_list)
 
   return result;
 }
+
+static void init_sink_output(output_data &out, json_sink &sink, bool struct_as_list, intptr_t buffer_size)
+{
+  if (buffer_size <= 0) {
+    stringstream ss;
+    ss << "JSON output buffer size must be positive, got " << buffer_size;
+    throw invalid_argument(ss.str());
+  }
+  // Leave room for the longest escape sequence or number written in one piece
+  out.init(std::max<intptr_t>(buffer_size, 64));
+  out.struct_as_list = struct_as_list;
+  out.sink = &sink;
+}
+
+void dynd::format_json(const nd::array &n, json_sink &sink, bool struct_as_list, intptr_t buffer_size)
+{
+  output_data out;
+  init_sink_output(out, sink, struct_as_list, buffer_size);
+
+  if (!n.get_type().is_expression()) {
+    ::format_json(out, n.get_type(), n.get()->metadata(), n.cdata());
+  } else {
+    nd::array tmp = n.eval();
+    ::format_json(out, tmp.get_type(), tmp.get()->metadata(), tmp.cdata());
+  }
+
+  out.flush();
+  sink.flush();
+}
+
+void dynd::format_json_lines(const nd::array &n, json_sink &sink, bool struct_as_list, intptr_t buffer_size)
+{
+  nd::array tmp = n.get_type().is_expression() ? n.eval() : n;
+  if (tmp.get_ndim() == 0) {
+    stringstream ss;
+    ss << "Formatting JSON lines requires an array with a dimension, got type " << tmp.get_type();
+    throw invalid_argument(ss.str());
+  }
+
+  output_data out;
+  init_sink_output(out, sink, struct_as_list, buffer_size);
+
+  for_each_dim_element(tmp.get_type(), tmp.get()->metadata(), tmp.cdata(),
+                       [&out](const ndt::type &element_tp, const char *element_arrmeta, const char *element_data,
+                              intptr_t DYND_UNUSED(i), intptr_t DYND_UNUSED(size)) {
+    ::format_json(out, element_tp, element_arrmeta, element_data);
+    out.write('\n');
+  });
+
+  out.flush();
+  sink.flush();
+}
+
+json_sink::~json_sink() {}
+
+void json_sink::flush() {}
+
+void json_callback_sink::write(const char *begin, const char *end) { m_callback(begin, end); }
+
+void json_ostream_sink::write(const char *begin, const char *end)
+{
+  m_os.write(begin, end - begin);
+  if (!m_os) {
+    throw runtime_error("error writing JSON to an output stream");
+  }
+}
+
+void json_ostream_sink::flush() { m_os.flush(); }
+
+void json_fd_sink::write(const char *begin, const char *end)
+{
+  while (begin < end) {
+#ifdef _WIN32
+    int count = ::_write(m_fd, begin, static_cast<unsigned int>(std::min<intptr_t>(end - begin, INT_MAX)));
+#else
+    ssize_t count = ::write(m_fd, begin, end - begin);
+#endif
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      stringstream ss;
+      ss << "error writing JSON to file descriptor " << m_fd << ": " << strerror(errno);
+      throw runtime_error(ss.str());
+    }
+    begin += count;
+  }
+}
@@ -14,6 +14,7 @@
 #include <dynd/types/time_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/parser_util.hpp>
+#include <dynd/eval/thread_pool.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -103,9 +104,14 @@ nd::array dynd::parse_json(const ndt::type &tp, const nd::array &json, const eva
 static void parse_json(const ndt::type &tp, const char *arrmeta, char *out_data, const char *&json_begin,
                        const char *json_end, const eval::eval_context *ectx);
 
+static inline bool is_json_whitespace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
 static const char *skip_whitespace(const char *begin, const char *end)
 {
-  while (begin < end && isspace(*begin)) {
+  while (begin < end && is_json_whitespace(*begin)) {
     ++begin;
   }
 
@@ -124,7 +130,10 @@ static bool parse_token(const char *&begin, const char *end, const char (&token)
   }
 }
 
-static void skip_json_value(const char *&begin, const char *end)
+/**
+ * Skips over a JSON value, checking that it is valid.
+ */
+static void validate_json_value(const char *&begin, const char *end)
 {
   begin = skip_whitespace(begin, end);
   if (begin == end) {
@@ -146,7 +155,7 @@ static void skip_json_value(const char *&begin, const char *end)
         if (!parse_token(begin, end, ":")) {
           throw parse::parse_error(begin, "expected ':' separating name from value in object dict");
         }
-        skip_json_value(begin, end);
+        validate_json_value(begin, end);
         if (!parse_token(begin, end, ",")) {
           break;
         }
@@ -161,7 +170,7 @@ static void skip_json_value(const char *&begin, const char *end)
     ++begin;
     if (!parse_token(begin, end, "]")) {
       for (;;) {
-        skip_json_value(begin, end);
+        validate_json_value(begin, end);
         if (!parse_token(begin, end, ",")) {
           break;
         }
@@ -290,7 +299,10 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
   shortvector<bool> populated_fields(field_count);
   memset(populated_fields.get(), 0, sizeof(bool) * field_count);
 
-  // If it's not an empty object, start the loop parsing the elements
+  // If it's not an empty object, start the loop parsing the elements. The
+  // previous field is tracked so the next name can be predicted from the
+  // order of the fields in earlier records.
+  intptr_t prev_field = -1;
   if (!parse_token(begin, end, "}")) {
     for (;;) {
       const char *strbegin, *strend;
@@ -306,17 +318,19 @@ static bool parse_struct_json_from_object(const ndt::type &tp, const char *arrme
       if (escaped) {
         std::string name;
         parse::unescape_string(strbegin, strend, name);
-        i = fsd->get_field_index(name);
+        i = fsd->get_field_index_after(prev_field, name.data(), name.data() + name.size());
       } else {
-        i = fsd->get_field_index(strbegin, strend);
+        i = fsd->get_field_index_after(prev_field, strbegin, strend);
       }
       if (i == -1) {
         // TODO: Add an error policy to this parser of whether to throw an error
-        //       or not. For now, just throw away fields not in the destination.
-        skip_json_value(begin, end);
+        //       or not. For now, just throw away fields not in the destination,
+        //       after checking that they are valid JSON.
+        validate_json_value(begin, end);
       } else {
         parse_json(fsd->get_field_type(i), arrmeta + arrmeta_offsets[i], out_data + data_offsets[i], begin, end, ectx);
         populated_fields[i] = true;
+        prev_field = i;
       }
       if (!parse_token(begin, end, ",")) {
         break;
@@ -810,7 +824,7 @@ void dynd::validate_json(const char *json_begin, const char *json_end)
   try
   {
     const char *begin = json_begin, *end = json_end;
-    ::skip_json_value(begin, end);
+    validate_json_value(begin, end);
     begin = skip_whitespace(begin, end);
     if (begin != end) {
       throw parse::parse_error(begin, "unexpected trailing JSON text");
@@ -829,6 +843,26 @@ void dynd::validate_json(const char *json_begin, const char *json_end)
   }
 }
 
+/**
+ * Converts a parse error at some position inside ``[json_begin, json_end)``
+ * into an ``invalid_argument`` describing the line and column of the error.
+ */
+static void throw_json_parse_error(const char *json_begin, const char *json_end, const parse::parse_error &e)
+{
+  stringstream ss;
+  std::string line_prev, line_cur;
+  int line, column;
+  get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
+  ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
+  const json_parse_error *jpe = dynamic_cast<const json_parse_error *>(&e);
+  if (jpe != NULL) {
+    ss << "DyND Type: " << jpe->get_type() << "\n";
+  }
+  ss << "Message: " << e.what() << "\n";
+  print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
+  throw invalid_argument(ss.str());
+}
+
 void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_end, const eval::eval_context *ectx)
 {
   try
@@ -841,28 +875,9 @@ void dynd::parse_json(nd::array &out, const char *json_begin, const char *json_e
       throw json_parse_error(begin, "unexpected trailing JSON text", tp);
     }
   }
-  catch (const json_parse_error &e)
-  {
-    stringstream ss;
-    std::string line_prev, line_cur;
-    int line, column;
-    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-    ss << "DyND Type: " << e.get_type() << "\n";
-    ss << "Message: " << e.what() << "\n";
-    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-    throw invalid_argument(ss.str());
-  }
   catch (const parse::parse_error &e)
   {
-    stringstream ss;
-    std::string line_prev, line_cur;
-    int line, column;
-    get_error_line_column(json_begin, json_end, e.get_position(), line_prev, line_cur, line, column);
-    ss << "Error parsing JSON at line " << line << ", column " << column << "\n";
-    ss << "Message: " << e.what() << "\n";
-    print_json_parse_error_marker(ss, line_prev, line_cur, line, column);
-    throw invalid_argument(ss.str());
+    throw_json_parse_error(json_begin, json_end, e);
   }
 }
 
@@ -878,6 +893,121 @@ nd::array dynd::parse_json(const ndt::type &tp, const char *json_begin, const ch
   return result;
 }
 
+/**
+ * Returns the start of the line after the one containing ``pos``, or ``end``
+ * if it is the last line.
+ */
+static const char *next_line(const char *pos, const char *end)
+{
+  const char *line_end = reinterpret_cast<const char *>(memchr(pos, '\n', end - pos));
+  return line_end == NULL ? end : line_end + 1;
+}
+
+/** Counts the lines in ``[begin, end)`` which are not just whitespace. */
+static intptr_t count_json_lines(const char *begin, const char *end)
+{
+  intptr_t count = 0;
+  while (begin < end) {
+    const char *line_end = next_line(begin, end);
+    if (skip_whitespace(begin, line_end) != line_end) {
+      ++count;
+    }
+    begin = line_end;
+  }
+
+  return count;
+}
+
+/**
+ * Parses every non-blank line of ``[begin, end)`` as one ``tp`` value, writing
+ * them consecutively from ``out_data`` with stride ``stride``.
+ */
+static void parse_json_lines(const ndt::type &tp, const char *arrmeta, char *out_data, intptr_t stride,
+                             const char *begin, const char *end, const eval::eval_context *ectx)
+{
+  while (begin < end) {
+    const char *line_end = next_line(begin, end);
+    begin = skip_whitespace(begin, line_end);
+    if (begin != line_end) {
+      ::parse_json(tp, arrmeta, out_data, begin, line_end, ectx);
+      if (skip_whitespace(begin, line_end) != line_end) {
+        throw json_parse_error(begin, "unexpected trailing JSON text, expected one value per line", tp);
+      }
+      out_data += stride;
+    }
+    begin = line_end;
+  }
+}
+
+nd::array nd::json::parse_lines(const ndt::type &tp, const char *json_begin, const char *json_end, int nthreads)
+{
+  const eval::eval_context *ectx = &eval::default_eval_context;
+  nd::array result = nd::empty(ndt::var_dim_type::make(tp));
+  const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(result.get()->metadata());
+  const char *el_arrmeta = result.get()->metadata() + sizeof(var_dim_type_arrmeta);
+  var_dim_type_data *out = reinterpret_cast<var_dim_type_data *>(result.data());
+
+  // The buffer is split into one piece per worker, each ending at a line
+  // boundary. Types which allocate from a blockref, like nested var dims,
+  // share that memory block between all the records, so they are parsed
+  // on the calling thread.
+  intptr_t num_pieces = 1;
+  eval::thread_pool *pool = NULL;
+  if ((tp.get_flags() & type_flag_blockref) == 0) {
+    eval::eval_context pieces_ectx(*ectx);
+    pieces_ectx.num_threads = nthreads;
+    num_pieces = eval::plan_workers(&pieces_ectx, json_end - json_begin, &pool);
+  }
+  std::vector<const char *> bounds(num_pieces + 1);
+  bounds[0] = json_begin;
+  for (intptr_t i = 1; i < num_pieces; ++i) {
+    bounds[i] = next_line(std::max(json_begin + (json_end - json_begin) * i / num_pieces, bounds[i - 1]), json_end);
+  }
+  bounds[num_pieces] = json_end;
+
+  // Count the records of every piece, so each one can be parsed straight into
+  // its final position in the result
+  std::vector<intptr_t> offsets(num_pieces + 1);
+  auto count_pieces = [&](int, intptr_t begin, intptr_t end) {
+    for (intptr_t i = begin; i < end; ++i) {
+      offsets[i + 1] = count_json_lines(bounds[i], bounds[i + 1]);
+    }
+  };
+  auto parse_pieces = [&](int, intptr_t begin, intptr_t end) {
+    for (intptr_t i = begin; i < end; ++i) {
+      try
+      {
+        parse_json_lines(tp, el_arrmeta, out->begin + offsets[i] * md->stride, md->stride, bounds[i], bounds[i + 1],
+                         ectx);
+      }
+      catch (const parse::parse_error &e)
+      {
+        throw_json_parse_error(json_begin, json_end, e);
+      }
+    }
+  };
+
+  if (pool != NULL) {
+    pool->parallel_for(static_cast<int>(num_pieces), num_pieces, 1, count_pieces);
+  } else {
+    count_pieces(0, 0, 1);
+  }
+  for (intptr_t i = 0; i < num_pieces; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  out->begin = md->blockref->get_api()->allocate(md->blockref.get(), offsets[num_pieces]);
+  out->size = offsets[num_pieces];
+  if (pool != NULL) {
+    pool->parallel_for(static_cast<int>(num_pieces), num_pieces, 1, parse_pieces);
+  } else {
+    parse_pieces(0, 0, 1);
+  }
+
+  result.get_type().extended()->arrmeta_finalize_buffers(result.get()->metadata());
+  return result;
+}
+
 static ndt::type discover_type(const char *&begin, const char *end)
 {
   begin = skip_whitespace(begin, end);
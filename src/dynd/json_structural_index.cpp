@@ -0,0 +1,340 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <dynd/json_structural_index.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
+#include <dynd/parser_util.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DYND_JSON_SSE2
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DYND_JSON_AVX2
+#endif
+
+using namespace std;
+using namespace dynd;
+
+// The scanning follows the first stage of simdjson. Each 64-byte block is
+// turned into bitmasks of the characters of interest, with bit i for byte i,
+// and everything else is done with integer operations on those masks.
+
+namespace {
+
+/** Character classes of a 64-byte block. */
+struct block_masks {
+  uint64_t quote;
+  uint64_t backslash;
+  // '{' and '['
+  uint64_t open;
+  // '}' and ']'
+  uint64_t close;
+  // ':' and ','
+  uint64_t separator;
+};
+
+typedef void (*classify_blocks_t)(const char *begin, size_t block_count, block_masks *out);
+
+// How many blocks are classified by one call through the function pointer
+const size_t classify_batch = 8;
+
+inline int count_bits(uint64_t x)
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(x);
+#else
+  int count = 0;
+  for (; x != 0; x &= x - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+inline int lowest_bit(uint64_t x)
+{
+#ifdef __GNUC__
+  return __builtin_ctzll(x);
+#else
+  int i = 0;
+  for (; (x & 1) == 0; x >>= 1) {
+    ++i;
+  }
+  return i;
+#endif
+}
+
+void scalar_classify_blocks(const char *begin, size_t block_count, block_masks *out)
+{
+  for (size_t b = 0; b < block_count; ++b, begin += 64) {
+    block_masks m = {0, 0, 0, 0, 0};
+    for (int i = 0; i < 64; ++i) {
+      uint64_t bit = uint64_t(1) << i;
+      switch (begin[i]) {
+      case '"':
+        m.quote |= bit;
+        break;
+      case '\\':
+        m.backslash |= bit;
+        break;
+      case '{':
+      case '[':
+        m.open |= bit;
+        break;
+      case '}':
+      case ']':
+        m.close |= bit;
+        break;
+      case ':':
+      case ',':
+        m.separator |= bit;
+        break;
+      default:
+        break;
+      }
+    }
+    out[b] = m;
+  }
+}
+
+#ifdef DYND_JSON_SSE2
+inline uint64_t sse2_mask(__m128i v0, __m128i v1, __m128i v2, __m128i v3, char c)
+{
+  const __m128i x = _mm_set1_epi8(c);
+  return uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v0, x)))) |
+         (uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v1, x)))) << 16) |
+         (uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v2, x)))) << 32) |
+         (uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v3, x)))) << 48);
+}
+
+void sse2_classify_blocks(const char *begin, size_t block_count, block_masks *out)
+{
+  // '[' and '{' differ only in the 0x20 bit, as do ']' and '}', so setting
+  // that bit lets one comparison find both
+  const __m128i lower = _mm_set1_epi8(0x20);
+  for (size_t b = 0; b < block_count; ++b, begin += 64) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + 32));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + 48));
+    __m128i l0 = _mm_or_si128(v0, lower), l1 = _mm_or_si128(v1, lower);
+    __m128i l2 = _mm_or_si128(v2, lower), l3 = _mm_or_si128(v3, lower);
+    out[b].quote = sse2_mask(v0, v1, v2, v3, '"');
+    out[b].backslash = sse2_mask(v0, v1, v2, v3, '\\');
+    out[b].open = sse2_mask(l0, l1, l2, l3, '{');
+    out[b].close = sse2_mask(l0, l1, l2, l3, '}');
+    out[b].separator = sse2_mask(v0, v1, v2, v3, ':') | sse2_mask(v0, v1, v2, v3, ',');
+  }
+}
+#endif
+
+#ifdef DYND_JSON_AVX2
+__attribute__((target("avx2"))) inline uint64_t avx2_mask(__m256i lo, __m256i hi, char c)
+{
+  const __m256i x = _mm256_set1_epi8(c);
+  return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, x)))) |
+         (uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, x)))) << 32);
+}
+
+__attribute__((target("avx2"))) void avx2_classify_blocks(const char *begin, size_t block_count, block_masks *out)
+{
+  const __m256i lower = _mm256_set1_epi8(0x20);
+  for (size_t b = 0; b < block_count; ++b, begin += 64) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 32));
+    __m256i lower_lo = _mm256_or_si256(lo, lower), lower_hi = _mm256_or_si256(hi, lower);
+    out[b].quote = avx2_mask(lo, hi, '"');
+    out[b].backslash = avx2_mask(lo, hi, '\\');
+    out[b].open = avx2_mask(lower_lo, lower_hi, '{');
+    out[b].close = avx2_mask(lower_lo, lower_hi, '}');
+    out[b].separator = avx2_mask(lo, hi, ':') | avx2_mask(lo, hi, ',');
+  }
+}
+#endif
+
+classify_blocks_t get_classify_blocks()
+{
+  simd_level_t level = get_simd_level();
+#ifdef DYND_JSON_AVX2
+  if (level >= simd_level_avx2) {
+    return &avx2_classify_blocks;
+  }
+#endif
+#ifdef DYND_JSON_SSE2
+  if (level >= simd_level_sse2) {
+    return &sse2_classify_blocks;
+  }
+#endif
+  return &scalar_classify_blocks;
+}
+
+/**
+ * Follows the escapes and strings across consecutive blocks.
+ */
+class string_tracker {
+  // 1 if the previous block ended in an odd number of backslashes
+  uint64_t m_prev_odd_backslash;
+  // All ones if the previous block ended inside a string
+  uint64_t m_prev_in_string;
+
+  /** Returns the bytes escaped by a preceding odd-length run of backslashes. */
+  uint64_t find_escaped(uint64_t backslash)
+  {
+    const uint64_t even_bits = 0x5555555555555555ULL;
+    const uint64_t odd_bits = ~even_bits;
+
+    uint64_t starts = backslash & ~(backslash << 1);
+    // A run continuing from the previous block starts one position earlier
+    uint64_t even_start_mask = even_bits ^ m_prev_odd_backslash;
+    uint64_t even_starts = starts & even_start_mask;
+    uint64_t odd_starts = starts & ~even_start_mask;
+
+    // Adding the start of each run carries one past its end
+    uint64_t even_carries = backslash + even_starts;
+    uint64_t odd_carries = backslash + odd_starts;
+    bool ends_odd_backslash = odd_carries < backslash;
+    odd_carries |= m_prev_odd_backslash;
+    m_prev_odd_backslash = ends_odd_backslash ? 1 : 0;
+
+    uint64_t even_carry_ends = even_carries & ~backslash;
+    uint64_t odd_carry_ends = odd_carries & ~backslash;
+    // A run is odd if it starts and ends at positions of different parity
+    return (even_carry_ends & odd_bits) | (odd_carry_ends & even_bits);
+  }
+
+  static uint64_t prefix_xor(uint64_t x)
+  {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+public:
+  string_tracker() : m_prev_odd_backslash(0), m_prev_in_string(0) {}
+
+  /**
+   * Returns the mask of the bytes inside strings, which includes the opening
+   * quotes but not the closing ones, and sets ``out_quote`` to the quotes
+   * which are not escaped.
+   */
+  uint64_t next(const block_masks &m, uint64_t &out_quote)
+  {
+    uint64_t quote = m.quote & ~find_escaped(m.backslash);
+    out_quote = quote;
+    uint64_t in_string = prefix_xor(quote) ^ m_prev_in_string;
+    m_prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+    return in_string;
+  }
+};
+
+/**
+ * Calls ``func(pos, masks, in_string, quote)`` for each 64-byte block of
+ * ``[begin, end)`` until it returns true, padding the last block with spaces.
+ * Returns whether any call returned true.
+ */
+template <typename Func>
+bool for_each_block(const char *begin, const char *end, Func func)
+{
+  classify_blocks_t classify = get_classify_blocks();
+  string_tracker strings;
+  block_masks masks[classify_batch];
+  char tail[64];
+
+  const char *pos = begin;
+  while (pos < end) {
+    size_t block_count = min(static_cast<size_t>(end - pos) / 64, classify_batch);
+    if (block_count == 0) {
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, pos, end - pos);
+      classify(tail, 1, masks);
+      block_count = 1;
+    } else {
+      classify(pos, block_count, masks);
+    }
+    for (size_t b = 0; b < block_count; ++b, pos += 64) {
+      uint64_t quote;
+      uint64_t in_string = strings.next(masks[b], quote);
+      if (func(pos, masks[b], in_string, quote)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+} // anonymous namespace
+
+void parse::build_json_structural_index(const char *begin, const char *end, std::vector<intptr_t> &out)
+{
+  out.clear();
+  for_each_block(begin, end, [&](const char *pos, const block_masks &m, uint64_t in_string, uint64_t quote) {
+    // Opening quotes are inside the strings they start, and closing ones are not
+    uint64_t structural = ((m.open | m.close | m.separator) & ~in_string) | (quote & in_string);
+    intptr_t offset = pos - begin;
+    for (; structural != 0; structural &= structural - 1) {
+      out.push_back(offset + lowest_bit(structural));
+    }
+    return false;
+  });
+}
+
+const char *parse::skip_json_container(const char *begin, const char *end)
+{
+  const char *result = NULL;
+  intptr_t depth = 0;
+  bool found = for_each_block(begin, end, [&](const char *pos, const block_masks &m, uint64_t in_string, uint64_t) {
+    uint64_t open = m.open & ~in_string, close = m.close & ~in_string;
+    intptr_t close_count = count_bits(close);
+    if (close_count < depth) {
+      // The depth can't reach zero inside this block
+      depth += count_bits(open) - close_count;
+      return false;
+    }
+    for (uint64_t brackets = open | close; brackets != 0; brackets &= brackets - 1) {
+      uint64_t bit = brackets & (~brackets + 1);
+      depth += (open & bit) ? 1 : -1;
+      if (depth == 0) {
+        result = pos + lowest_bit(brackets) + 1;
+        return true;
+      }
+    }
+    return false;
+  });
+
+  if (!found) {
+    throw parse::parse_error(begin, "unterminated JSON object or array");
+  }
+  return result;
+}
+
+const char *parse::find_quote_or_backslash(const char *begin, const char *end)
+{
+#ifdef DYND_JSON_SSE2
+  const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\');
+  while (end - begin >= 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+    if (mask != 0) {
+      return begin + lowest_bit(static_cast<uint64_t>(mask));
+    }
+    begin += 16;
+  }
+#endif
+  while (begin < end && *begin != '"' && *begin != '\\') {
+    ++begin;
+  }
+  return begin;
+}
@@ -5,6 +5,7 @@
 
 #include <dynd/func/comparison.hpp>
 #include <dynd/kernels/compare_kernels.hpp>
+#include <dynd/types/categorical_type.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -13,7 +14,7 @@ intptr_t nd::equal_kernel<tuple_type_id, tuple_type_id>::instantiate(
     char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
     const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-    const std::map<std::string, ndt::type> &tp_vars)
+    const ndt::typevar_map &tp_vars)
 {
   intptr_t root_ckb_offset = ckb_offset;
   auto bsd = src_tp->extended<ndt::tuple_type>();
@@ -51,7 +52,7 @@ intptr_t nd::not_equal_kernel<tuple_type_id, tuple_type_id>::instantiate(
     char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
     const char *dst_arrmeta, intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-    const std::map<std::string, ndt::type> &tp_vars)
+    const ndt::typevar_map &tp_vars)
 {
   intptr_t root_ckb_offset = ckb_offset;
   auto bsd = src_tp->extended<ndt::tuple_type>();
@@ -84,3 +85,53 @@ intptr_t nd::not_equal_kernel<tuple_type_id, tuple_type_id>::instantiate(
   }
   return ckb_offset;
 }
+
+intptr_t nd::equal_kernel<categorical_type_id, categorical_type_id>::instantiate(
+    char *static_data, char *data, void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+    const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds, const ndt::typevar_map &tp_vars)
+{
+  if (src_tp[0] != src_tp[1]) {
+    throw not_comparable_error(src_tp[0], src_tp[1], comparison_type_equal);
+  }
+
+  switch (src_tp[0].extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+  case uint8_type_id:
+    return equal_kernel<uint8_type_id, uint8_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                   dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq,
+                                                                   ectx, nkwd, kwds, tp_vars);
+  case uint16_type_id:
+    return equal_kernel<uint16_type_id, uint16_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                     dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq,
+                                                                     ectx, nkwd, kwds, tp_vars);
+  default:
+    return equal_kernel<uint32_type_id, uint32_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                     dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq,
+                                                                     ectx, nkwd, kwds, tp_vars);
+  }
+}
+
+intptr_t nd::not_equal_kernel<categorical_type_id, categorical_type_id>::instantiate(
+    char *static_data, char *data, void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta,
+    intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
+    const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds, const ndt::typevar_map &tp_vars)
+{
+  if (src_tp[0] != src_tp[1]) {
+    throw not_comparable_error(src_tp[0], src_tp[1], comparison_type_not_equal);
+  }
+
+  switch (src_tp[0].extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+  case uint8_type_id:
+    return not_equal_kernel<uint8_type_id, uint8_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                       dst_arrmeta, nsrc, src_tp, src_arrmeta, kernreq,
+                                                                       ectx, nkwd, kwds, tp_vars);
+  case uint16_type_id:
+    return not_equal_kernel<uint16_type_id, uint16_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                         dst_arrmeta, nsrc, src_tp, src_arrmeta,
+                                                                         kernreq, ectx, nkwd, kwds, tp_vars);
+  default:
+    return not_equal_kernel<uint32_type_id, uint32_type_id>::instantiate(static_data, data, ckb, ckb_offset, dst_tp,
+                                                                         dst_arrmeta, nsrc, src_tp, src_arrmeta,
+                                                                         kernreq, ectx, nkwd, kwds, tp_vars);
+  }
+}
@@ -12,7 +12,7 @@ using namespace dynd;
 void nd::copy_ck::resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                    intptr_t nsrc, const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
                                    const array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                   const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   if (nsrc != 1) {
     std::stringstream ss;
@@ -28,7 +28,7 @@ intptr_t nd::copy_ck::instantiate(char *DYND_UNUSED(static_data), char *DYND_UNU
                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
                                   kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                   const nd::array *DYND_UNUSED(kwds),
-                                  const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                  const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   if (dst_tp.is_builtin()) {
     if (src_tp[0].is_builtin()) {
@@ -40,7 +40,7 @@ intptr_t nd::copy_ck::instantiate(char *DYND_UNUSED(static_data), char *DYND_UNU
       else {
         return assign::get()->instantiate(assign::get()->static_data(), NULL, ckb, ckb_offset, dst_tp, dst_arrmeta, 1,
                                           src_tp, src_arrmeta, kernreq, ectx, 0, NULL,
-                                          std::map<std::string, ndt::type>());
+                                          ndt::typevar_map());
       }
     }
     else {
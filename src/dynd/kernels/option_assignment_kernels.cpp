@@ -19,7 +19,7 @@ static intptr_t instantiate_option_as_value_assignment_kernel(
     char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset, const ndt::type &dst_tp,
     const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, const char *const *src_arrmeta,
     kernel_request_t kernreq, const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
-    const nd::array *DYND_UNUSED(kwds), const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+    const nd::array *DYND_UNUSED(kwds), const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   // In all cases not handled, we use the
   // regular S to T assignment kernel.
@@ -104,14 +104,14 @@ size_t kernels::make_option_assignment_kernel(
   const nd::base_callable *af = afl.get();
   const ndt::callable_type *const *af_tp =
       reinterpret_cast<const ndt::callable_type *const *>(afl.get_type());
-  map<std::string, ndt::type> typevars;
+  ndt::typevar_map typevars;
   for (intptr_t i = 0; i < size; ++i, ++af_tp, ++af) {
     typevars.clear();
     if ((*af_tp)->get_pos_type(0).match(src_tp, typevars) &&
         (*af_tp)->get_return_type().match(dst_tp, typevars)) {
       return af->instantiate(NULL,  NULL, ckb, ckb_offset, dst_tp,
                              dst_arrmeta, size, &src_tp, &src_arrmeta, kernreq,
-                             ectx, 0, NULL, std::map<std::string, ndt::type>());
+                             ectx, 0, NULL, ndt::typevar_map());
     }
   }
 
@@ -61,7 +61,7 @@ intptr_t nd::functional::rolling_ck::instantiate(char *_static_data, char *data,
                                                  const ndt::type *src_tp, const char *const *src_arrmeta,
                                                  kernel_request_t kernreq, const eval::eval_context *ectx,
                                                  intptr_t nkwd, const nd::array *kwds,
-                                                 const std::map<std::string, ndt::type> &tp_vars)
+                                                 const ndt::typevar_map &tp_vars)
 {
   typedef dynd::nd::functional::strided_rolling_ck self_type;
   rolling_callable_data *static_data = *reinterpret_cast<rolling_callable_data **>(_static_data);
@@ -119,7 +119,7 @@ intptr_t nd::functional::rolling_ck::instantiate(char *_static_data, char *data,
 
 void nd::functional::rolling_ck::resolve_dst_type(char *_static_data, char *data, ndt::type &dst_tp,
                                                   intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t nkwd,
-                                                  const array *kwds, const std::map<std::string, ndt::type> &tp_vars)
+                                                  const array *kwds, const ndt::typevar_map &tp_vars)
 
 {
   /*
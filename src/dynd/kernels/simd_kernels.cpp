@@ -0,0 +1,353 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include <dynd/kernels/simd_kernels.hpp>
+
+using namespace std;
+using namespace dynd;
+
+// The loops below are written so that the compiler vectorizes them. They are
+// compiled once for the baseline instruction set, which includes SSE2 on
+// x86-64, and once more for AVX2 using the target attribute, so that the
+// library does not need to be built with -mavx2 to use it.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DYND_SIMD_X86_GNUC
+#endif
+
+#ifdef __GNUC__
+#define DYND_SIMD_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define DYND_SIMD_ALWAYS_INLINE inline
+#endif
+
+namespace {
+
+template <typename T>
+struct add_op {
+  static auto f(T a, T b) -> decltype(a + b) { return a + b; }
+};
+
+template <typename T>
+struct subtract_op {
+  static auto f(T a, T b) -> decltype(a - b) { return a - b; }
+};
+
+template <typename T>
+struct multiply_op {
+  static auto f(T a, T b) -> decltype(a * b) { return a * b; }
+};
+
+template <typename T>
+struct divide_op {
+  static auto f(T a, T b) -> decltype(a / b) { return a / b; }
+};
+
+// Comparisons write a bool1, which is one byte holding 0 or 1
+
+template <typename T>
+struct less_op {
+  static unsigned char f(T a, T b) { return a < b; }
+};
+
+template <typename T>
+struct less_equal_op {
+  static unsigned char f(T a, T b) { return a <= b; }
+};
+
+template <typename T>
+struct equal_op {
+  static unsigned char f(T a, T b) { return a == b; }
+};
+
+template <typename T>
+struct not_equal_op {
+  static unsigned char f(T a, T b) { return a != b; }
+};
+
+template <typename T>
+struct greater_equal_op {
+  static unsigned char f(T a, T b) { return a >= b; }
+};
+
+template <typename T>
+struct greater_op {
+  static unsigned char f(T a, T b) { return a > b; }
+};
+
+template <template <typename> class Op, typename T>
+void baseline_loop(char *dst, const char *src0, const char *src1, size_t count)
+{
+  typedef decltype(Op<T>::f(T(), T())) R;
+
+  R *d = reinterpret_cast<R *>(dst);
+  const T *a = reinterpret_cast<const T *>(src0);
+  const T *b = reinterpret_cast<const T *>(src1);
+  for (size_t i = 0; i < count; ++i) {
+    d[i] = Op<T>::f(a[i], b[i]);
+  }
+}
+
+#ifdef DYND_SIMD_X86_GNUC
+template <template <typename> class Op, typename T>
+__attribute__((target("avx2"))) void avx2_loop(char *dst, const char *src0, const char *src1, size_t count)
+{
+  typedef decltype(Op<T>::f(T(), T())) R;
+
+  R *d = reinterpret_cast<R *>(dst);
+  const T *a = reinterpret_cast<const T *>(src0);
+  const T *b = reinterpret_cast<const T *>(src1);
+  for (size_t i = 0; i < count; ++i) {
+    d[i] = Op<T>::f(a[i], b[i]);
+  }
+}
+#endif
+
+// Reductions keep this many accumulators, enough to fill the vector
+// registers and hide the latency of the operation
+const size_t reduce_width = 16;
+
+template <typename T>
+struct sum_reduce {
+  static T f(T acc, T x) { return acc + x; }
+};
+
+// These keep the accumulator unless x compares past it, the same as the
+// scalar min and max kernels, so a NaN in the input is skipped
+
+template <typename T>
+struct min_reduce {
+  static T f(T acc, T x) { return x < acc ? x : acc; }
+};
+
+template <typename T>
+struct max_reduce {
+  static T f(T acc, T x) { return x > acc ? x : acc; }
+};
+
+// Folds src[0, count) into res with independent accumulators, each seeded
+// with res. This is inlined into the baseline and AVX2 versions below.
+template <template <typename> class Op, typename T>
+DYND_SIMD_ALWAYS_INLINE T reduce_block(T res, const T *src, size_t count)
+{
+  if (count >= reduce_width) {
+    T acc[reduce_width];
+    for (size_t j = 0; j < reduce_width; ++j) {
+      acc[j] = res;
+    }
+    size_t i = 0;
+    for (; i + reduce_width <= count; i += reduce_width) {
+      for (size_t j = 0; j < reduce_width; ++j) {
+        acc[j] = Op<T>::f(acc[j], src[i + j]);
+      }
+    }
+    for (size_t width = reduce_width / 2; width > 0; width /= 2) {
+      for (size_t j = 0; j < width; ++j) {
+        acc[j] = Op<T>::f(acc[j], acc[j + width]);
+      }
+    }
+    res = acc[0];
+    src += i;
+    count -= i;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    res = Op<T>::f(res, src[i]);
+  }
+  return res;
+}
+
+template <template <typename> class Op, typename T>
+T baseline_reduce_block(T res, const T *src, size_t count)
+{
+  return reduce_block<Op, T>(res, src, count);
+}
+
+#ifdef DYND_SIMD_X86_GNUC
+template <template <typename> class Op, typename T>
+__attribute__((target("avx2"))) T avx2_reduce_block(T res, const T *src, size_t count)
+{
+  return reduce_block<Op, T>(res, src, count);
+}
+#endif
+
+// Sums start from zero, and floating point sums are split pairwise into
+// blocks, which keeps the rounding error logarithmic in the length
+template <typename T, T (*Block)(T, const T *, size_t)>
+T pairwise_sum(const T *src, size_t count)
+{
+  if (!std::is_floating_point<T>::value || count <= 1024) {
+    return Block(T(0), src, count);
+  }
+
+  size_t half = count / 2;
+  return pairwise_sum<T, Block>(src, half) + pairwise_sum<T, Block>(src + half, count - half);
+}
+
+template <typename T, T (*Block)(T, const T *, size_t)>
+void sum_loop(char *dst, const char *src, size_t count)
+{
+  if (count != 0) {
+    T &res = *reinterpret_cast<T *>(dst);
+    res = res + pairwise_sum<T, Block>(reinterpret_cast<const T *>(src), count);
+  }
+}
+
+template <template <typename> class Op, typename T, T (*Block)(T, const T *, size_t)>
+void reduce_loop(char *dst, const char *src, size_t count)
+{
+  T &res = *reinterpret_cast<T *>(dst);
+  res = Block(res, reinterpret_cast<const T *>(src), count);
+}
+
+simd_level_t detect_simd_level()
+{
+#if defined(DYND_SIMD_X86_GNUC)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_level_avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return simd_level_sse2;
+  }
+  return simd_level_none;
+#elif defined(_M_X64)
+  return simd_level_sse2;
+#else
+  return simd_level_none;
+#endif
+}
+
+atomic<int> &simd_level()
+{
+  static atomic<int> level(detect_simd_level());
+  return level;
+}
+
+struct simd_table {
+  nd::detail::simd_binary_t loops[simd_level_avx2 + 1][nd::detail::simd_binary_op_count][builtin_type_id_count];
+  nd::detail::simd_reduce_t reduce_loops[simd_level_avx2 + 1][nd::detail::simd_reduce_op_count][builtin_type_id_count];
+
+  template <typename T>
+  void add_comparisons(type_id_t tp_id)
+  {
+    set<less_op, T>(nd::detail::simd_less, tp_id);
+    set<less_equal_op, T>(nd::detail::simd_less_equal, tp_id);
+    set<equal_op, T>(nd::detail::simd_equal, tp_id);
+    set<not_equal_op, T>(nd::detail::simd_not_equal, tp_id);
+    set<greater_equal_op, T>(nd::detail::simd_greater_equal, tp_id);
+    set<greater_op, T>(nd::detail::simd_greater, tp_id);
+  }
+
+  template <typename T>
+  void add_reductions(type_id_t tp_id)
+  {
+    reduce_loops[simd_level_sse2][nd::detail::simd_reduce_sum][tp_id] = &sum_loop<T, &baseline_reduce_block<sum_reduce, T>>;
+    reduce_loops[simd_level_sse2][nd::detail::simd_reduce_min][tp_id] =
+        &reduce_loop<min_reduce, T, &baseline_reduce_block<min_reduce, T>>;
+    reduce_loops[simd_level_sse2][nd::detail::simd_reduce_max][tp_id] =
+        &reduce_loop<max_reduce, T, &baseline_reduce_block<max_reduce, T>>;
+#ifdef DYND_SIMD_X86_GNUC
+    reduce_loops[simd_level_avx2][nd::detail::simd_reduce_sum][tp_id] = &sum_loop<T, &avx2_reduce_block<sum_reduce, T>>;
+    reduce_loops[simd_level_avx2][nd::detail::simd_reduce_min][tp_id] =
+        &reduce_loop<min_reduce, T, &avx2_reduce_block<min_reduce, T>>;
+    reduce_loops[simd_level_avx2][nd::detail::simd_reduce_max][tp_id] =
+        &reduce_loop<max_reduce, T, &avx2_reduce_block<max_reduce, T>>;
+#else
+    for (int op = 0; op < nd::detail::simd_reduce_op_count; ++op) {
+      reduce_loops[simd_level_avx2][op][tp_id] = reduce_loops[simd_level_sse2][op][tp_id];
+    }
+#endif
+  }
+
+  template <typename T>
+  void add_integer(type_id_t tp_id)
+  {
+    add_reductions<T>(tp_id);
+    set<add_op, T>(nd::detail::simd_add, tp_id);
+    set<subtract_op, T>(nd::detail::simd_subtract, tp_id);
+    set<multiply_op, T>(nd::detail::simd_multiply, tp_id);
+    add_comparisons<T>(tp_id);
+  }
+
+  template <typename T>
+  void add_float(type_id_t tp_id)
+  {
+    add_integer<T>(tp_id);
+    set<divide_op, T>(nd::detail::simd_divide, tp_id);
+  }
+
+  template <template <typename> class Op, typename T>
+  void set(nd::detail::simd_binary_op_t op, type_id_t tp_id)
+  {
+    loops[simd_level_sse2][op][tp_id] = &baseline_loop<Op, T>;
+#ifdef DYND_SIMD_X86_GNUC
+    loops[simd_level_avx2][op][tp_id] = &avx2_loop<Op, T>;
+#else
+    loops[simd_level_avx2][op][tp_id] = &baseline_loop<Op, T>;
+#endif
+  }
+
+  simd_table()
+  {
+    // Everything not set below, including all of simd_level_none, is NULL
+    memset(loops, 0, sizeof(loops));
+    memset(reduce_loops, 0, sizeof(reduce_loops));
+
+    add_integer<int8_t>(int8_type_id);
+    add_integer<int16_t>(int16_type_id);
+    add_integer<int32_t>(int32_type_id);
+    add_integer<int64_t>(int64_type_id);
+    add_integer<uint8_t>(uint8_type_id);
+    add_integer<uint16_t>(uint16_type_id);
+    add_integer<uint32_t>(uint32_type_id);
+    add_integer<uint64_t>(uint64_type_id);
+    add_float<float>(float32_type_id);
+    add_float<double>(float64_type_id);
+  }
+};
+
+} // anonymous namespace
+
+simd_level_t dynd::get_simd_level() { return static_cast<simd_level_t>(simd_level().load()); }
+
+simd_level_t dynd::get_max_simd_level()
+{
+  static const simd_level_t max_level = detect_simd_level();
+  return max_level;
+}
+
+void dynd::set_simd_level(simd_level_t level)
+{
+  simd_level() = level < get_max_simd_level() ? level : get_max_simd_level();
+}
+
+namespace {
+
+const simd_table &get_simd_table()
+{
+  static const simd_table table;
+  return table;
+}
+
+} // anonymous namespace
+
+nd::detail::simd_binary_t nd::detail::get_simd_binary(simd_binary_op_t op, type_id_t src_type_id)
+{
+  if (src_type_id < 0 || src_type_id >= builtin_type_id_count) {
+    return NULL;
+  }
+  return get_simd_table().loops[get_simd_level()][op][src_type_id];
+}
+
+nd::detail::simd_reduce_t nd::detail::get_simd_reduce(simd_reduce_op_t op, type_id_t src_type_id)
+{
+  if (src_type_id < 0 || src_type_id >= builtin_type_id_count) {
+    return NULL;
+  }
+  return get_simd_table().reduce_loops[get_simd_level()][op][src_type_id];
+}
@@ -53,7 +53,7 @@ intptr_t nd::masked_take_ck::instantiate(char *DYND_UNUSED(static_data), char *D
                                          const char *const *src_arrmeta, kernel_request_t kernreq,
                                          const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                          const nd::array *DYND_UNUSED(kwds),
-                                         const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                         const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   typedef nd::masked_take_ck self_type;
 
@@ -130,7 +130,7 @@ intptr_t nd::indexed_take_ck::instantiate(char *DYND_UNUSED(static_data), char *
                                           const char *const *src_arrmeta, kernel_request_t kernreq,
                                           const eval::eval_context *ectx, intptr_t DYND_UNUSED(nkwd),
                                           const nd::array *DYND_UNUSED(kwds),
-                                          const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                          const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   typedef nd::indexed_take_ck self_type;
 
@@ -183,7 +183,7 @@ intptr_t nd::take_ck::instantiate(char *DYND_UNUSED(static_data), char *DYND_UNU
                                   intptr_t ckb_offset, const ndt::type &dst_tp, const char *dst_arrmeta, intptr_t nsrc,
                                   const ndt::type *src_tp, const char *const *src_arrmeta, kernel_request_t kernreq,
                                   const eval::eval_context *ectx, intptr_t nkwd, const nd::array *kwds,
-                                  const std::map<std::string, ndt::type> &tp_vars)
+                                  const ndt::typevar_map &tp_vars)
 {
   ndt::type mask_el_tp = src_tp[1].get_type_at_dimension(NULL, 1);
   if (mask_el_tp.get_type_id() == bool_type_id) {
@@ -202,7 +202,7 @@ intptr_t nd::take_ck::instantiate(char *DYND_UNUSED(static_data), char *DYND_UNU
 void nd::take_ck::resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                    intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp, intptr_t DYND_UNUSED(nkwd),
                                    const nd::array *DYND_UNUSED(kwds),
-                                   const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                   const ndt::typevar_map &DYND_UNUSED(tp_vars))
 {
   /*
     if (nsrc != 2) {
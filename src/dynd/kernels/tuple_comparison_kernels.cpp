@@ -213,13 +213,13 @@ size_t dynd::make_tuple_comparison_kernel(void *ckb, intptr_t ckb_offset, const
     //    reinterpret_cast<ckernel_builder<kernel_request_host> *>(ckb)
     //      ->reserve(ckb_offset + sizeof(ckernel_prefix));
     if (comptype == comparison_type_equal) {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
       const char *src_arrmeta[2] = {src0_arrmeta, src1_arrmeta};
       return nd::equal_kernel<tuple_type_id, tuple_type_id>::instantiate(
           NULL, NULL, ckb, ckb_offset, ndt::type::make<bool1>(), NULL, 2, &src_tp, src_arrmeta,
           kernel_request_host | kernel_request_single, ectx, 0, NULL, tp_vars);
     } else {
-      std::map<std::string, ndt::type> tp_vars;
+      ndt::typevar_map tp_vars;
       const char *src_arrmeta[2] = {src0_arrmeta, src1_arrmeta};
       return nd::not_equal_kernel<tuple_type_id, tuple_type_id>::instantiate(
           NULL, NULL, ckb, ckb_offset, ndt::type::make<bool1>(), NULL, 2, &src_tp, src_arrmeta,
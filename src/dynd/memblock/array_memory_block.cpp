@@ -4,6 +4,7 @@
 //
 
 #include <dynd/memblock/array_memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 #include <dynd/types/base_memory_type.hpp>
 #include <dynd/array.hpp>
 #include <dynd/exceptions.hpp>
@@ -21,17 +22,14 @@ namespace detail {
     preamble->~array_preamble();
 
     // Finally free the memory block itself
-    delete[] reinterpret_cast<char *>(memblock);
+    memory_block_deallocate(memblock);
   }
 }
 } // namespace dynd::detail
 
 intrusive_ptr<memory_block_data> dynd::make_array_memory_block(size_t arrmeta_size)
 {
-  char *result = new char[sizeof(array_preamble) + arrmeta_size];
-  if (result == 0) {
-    throw bad_alloc();
-  }
+  char *result = reinterpret_cast<char *>(detail::memory_block_allocate(sizeof(array_preamble) + arrmeta_size));
   // Zero out all the arrmeta to start
   memset(result, 0, sizeof(array_preamble) + arrmeta_size);
   return intrusive_ptr<memory_block_data>(new (result) memory_block_data(1, array_memory_block_type), false);
@@ -41,10 +39,7 @@ intrusive_ptr<memory_block_data> dynd::make_array_memory_block(size_t arrmeta_si
                                                                size_t extra_alignment, char **out_extra_ptr)
 {
   size_t extra_offset = inc_to_alignment(sizeof(array_preamble) + arrmeta_size, extra_alignment);
-  char *result = new char[extra_offset + extra_size];
-  if (result == 0) {
-    throw bad_alloc();
-  }
+  char *result = reinterpret_cast<char *>(detail::memory_block_allocate(extra_offset + extra_size));
   // Zero out all the arrmeta to start
   memset(result, 0, sizeof(array_preamble) + arrmeta_size);
   // Return a pointer to the extra allocated memory
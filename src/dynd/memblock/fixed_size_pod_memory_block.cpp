@@ -6,6 +6,7 @@
 #include <cstdlib>
 
 #include <dynd/memblock/fixed_size_pod_memory_block.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -13,26 +14,27 @@ using namespace dynd;
 namespace dynd {
 namespace detail {
 
-  void free_fixed_size_pod_memory_block(memory_block_data *memblock)
-  {
-    delete[] reinterpret_cast<char *>(memblock);
-  }
+  void free_fixed_size_pod_memory_block(memory_block_data *memblock) { memory_block_deallocate(memblock); }
 }
 } // namespace dynd::detail
 
 intrusive_ptr<memory_block_data> dynd::make_fixed_size_pod_memory_block(intptr_t size_bytes, intptr_t alignment,
                                                                         char **out_datapointer)
 {
-  // Calculate the aligned starting point for the data
-  intptr_t start =
-      (intptr_t)(((uintptr_t)sizeof(memory_block_data) + (uintptr_t)(alignment - 1)) & ~((uintptr_t)(alignment - 1)));
-  // Allocate it
-  char *result = new char[start + size_bytes];
-  if (result == 0) {
-    throw bad_alloc();
-  }
-  // Give back the data pointer
-  *out_datapointer = result + start;
+  return make_fixed_size_pod_memory_block(size_bytes, alignment, out_datapointer, get_memory_allocator());
+}
+
+intrusive_ptr<memory_block_data> dynd::make_fixed_size_pod_memory_block(intptr_t size_bytes, intptr_t alignment,
+                                                                        char **out_datapointer,
+                                                                        memory_allocator *allocator)
+{
+  // Allocate it, with room to align the data in memory, not just relative to the block
+  char *result = reinterpret_cast<char *>(
+      detail::memory_block_allocate(sizeof(memory_block_data) + (alignment - 1) + size_bytes, allocator));
+  // Give back the aligned data pointer
+  *out_datapointer = reinterpret_cast<char *>(
+      (reinterpret_cast<uintptr_t>(result) + sizeof(memory_block_data) + static_cast<uintptr_t>(alignment - 1)) &
+      ~static_cast<uintptr_t>(alignment - 1));
   // Use placement new to initialize and return the memory block
   return intrusive_ptr<memory_block_data>(new (result) memory_block_data(1, fixed_size_pod_memory_block_type), false);
 }
@@ -73,6 +73,7 @@ struct memmap_memory_block {
   std::string m_filename;
   uint32_t m_access;
   intptr_t m_begin, m_end;
+  bool m_private;
 // Handle to the mapped memory
 #ifdef WIN32
   HANDLE m_hFile, m_hMapFile;
@@ -86,10 +87,13 @@ struct memmap_memory_block {
   intptr_t m_mapOffset;
 
   memmap_memory_block(const std::string &filename, uint32_t access, char **out_pointer, intptr_t *out_size,
-                      intptr_t begin, intptr_t end)
-      : m_mbd(1, memmap_memory_block_type), m_filename(filename), m_access(access), m_begin(begin), m_end(end)
+                      intptr_t begin, intptr_t end, bool private_mapping)
+      : m_mbd(1, memmap_memory_block_type), m_filename(filename), m_access(access), m_begin(begin), m_end(end),
+        m_private(private_mapping)
   {
     bool readwrite = ((access & nd::write_access_flag) == nd::write_access_flag);
+    // A private mapping is writable without writing to the file
+    bool writefile = readwrite && !private_mapping;
 #ifdef WIN32
     // TODO: This function isn't quite exception-safe, use a smart pointer for the handles to fix.
 
@@ -100,7 +104,7 @@ struct memmap_memory_block {
     sysGran = sysInfo.dwAllocationGranularity;
 
     // Open the file using the windows API
-    m_hFile = CreateFile(m_filename.c_str(), GENERIC_READ | (readwrite ? GENERIC_WRITE : 0), FILE_SHARE_READ, NULL,
+    m_hFile = CreateFile(m_filename.c_str(), GENERIC_READ | (writefile ? GENERIC_WRITE : 0), FILE_SHARE_READ, NULL,
                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
     if (m_hFile == NULL) {
       stringstream ss;
@@ -121,7 +125,8 @@ struct memmap_memory_block {
     m_mapOffset = begin - mapbegin;
     intptr_t mapsize = end - mapbegin;
 
-    m_hMapFile = CreateFileMapping(m_hFile, NULL, readwrite ? PAGE_READWRITE : PAGE_READONLY,
+    m_hMapFile = CreateFileMapping(m_hFile, NULL,
+                                   private_mapping ? PAGE_WRITECOPY : (readwrite ? PAGE_READWRITE : PAGE_READONLY),
 #ifdef _WIN64
                                    (uint32_t)(((uint64_t)end) >> 32),
 #else
@@ -136,7 +141,9 @@ struct memmap_memory_block {
     }
 
     // Create the mapped memory
-    m_mapPointer = (char *)MapViewOfFile(m_hMapFile, FILE_MAP_READ | (readwrite ? FILE_MAP_WRITE : 0),
+    m_mapPointer = (char *)MapViewOfFile(m_hMapFile,
+                                         private_mapping ? FILE_MAP_COPY
+                                                         : (FILE_MAP_READ | (readwrite ? FILE_MAP_WRITE : 0)),
 #ifdef _WIN64
                                          (uint32_t)(((uint64_t)mapbegin) >> 32),
 #else
@@ -153,7 +160,7 @@ struct memmap_memory_block {
     *out_pointer = m_mapPointer + m_mapOffset;
     *out_size = end - begin;
 #else // Finished win32 implementation, now posix
-    m_fd = open(m_filename.c_str(), readwrite ? O_RDWR : O_RDONLY);
+    m_fd = open(m_filename.c_str(), writefile ? O_RDWR : O_RDONLY);
     if (m_fd == -1) {
       stringstream ss;
       ss << "failed to open file \"" << m_filename << "\" for memory mapping";
@@ -185,7 +192,8 @@ struct memmap_memory_block {
     m_mapOffset = begin - mapbegin;
     intptr_t mapsize = end - mapbegin;
 
-    m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0), MAP_SHARED, m_fd, mapbegin);
+    m_mapPointer = (char *)mmap(NULL, mapsize, PROT_READ | (readwrite ? PROT_WRITE : 0),
+                                private_mapping ? MAP_PRIVATE : MAP_SHARED, m_fd, mapbegin);
     if (m_mapPointer == (char *)MAP_FAILED) {
       close(m_fd);
       stringstream ss;
@@ -214,9 +222,10 @@ struct memmap_memory_block {
 } // anonymous namespace
 
 intrusive_ptr<memory_block_data> dynd::make_memmap_memory_block(const std::string &filename, uint32_t access, char **out_pointer,
-                                             intptr_t *out_size, intptr_t begin, intptr_t end)
+                                             intptr_t *out_size, intptr_t begin, intptr_t end, bool private_mapping)
 {
-  memmap_memory_block *pmb = new memmap_memory_block(filename, access, out_pointer, out_size, begin, end);
+  memmap_memory_block *pmb =
+      new memmap_memory_block(filename, access, out_pointer, out_size, begin, end, private_mapping);
   return intrusive_ptr<memory_block_data>(reinterpret_cast<memory_block_data *>(pmb), false);
 }
 
@@ -231,6 +240,38 @@ namespace detail {
 }
 } // namespace dynd::detail
 
+void dynd::memmap_advise(char *ptr, intptr_t size, memmap_advice_t advice)
+{
+#ifndef WIN32
+  int posix_advice;
+  switch (advice) {
+  case memmap_advice_sequential:
+    posix_advice = MADV_SEQUENTIAL;
+    break;
+  case memmap_advice_random:
+    posix_advice = MADV_RANDOM;
+    break;
+  case memmap_advice_willneed:
+    posix_advice = MADV_WILLNEED;
+    break;
+  default:
+    posix_advice = MADV_NORMAL;
+    break;
+  }
+
+  // madvise needs a page-aligned address
+  intptr_t pageSize = sysconf(_SC_PAGE_SIZE);
+  char *begin = reinterpret_cast<char *>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(pageSize - 1));
+  if (size > 0) {
+    madvise(begin, size + (ptr - begin), posix_advice);
+  }
+#else
+  (void)ptr;
+  (void)size;
+  (void)advice;
+#endif
+}
+
 void dynd::memmap_memory_block_debug_print(const memory_block_data *memblock, std::ostream &o,
                                            const std::string &indent)
 {
@@ -238,4 +279,7 @@ void dynd::memmap_memory_block_debug_print(const memory_block_data *memblock, st
   o << indent << " filename: " << emb->m_filename << "\n";
   o << indent << " begin: " << emb->m_begin << "\n";
   o << indent << " end: " << emb->m_end << "\n";
+  if (emb->m_private) {
+    o << indent << " private mapping\n";
+  }
 }
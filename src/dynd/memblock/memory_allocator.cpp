@@ -0,0 +1,245 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include <dynd/memblock/memory_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+// The size classes of the pool, spaced to waste at most a quarter of a block
+const size_t size_classes[] = {32,  48,  64,  80,   96,   112,  128,  160,  192,  224,  256,  320,  384, 448,
+                               512, 640, 768, 896,  1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096};
+const size_t size_class_count = sizeof(size_classes) / sizeof(size_classes[0]);
+
+// The most memory each free list of a thread keeps before freeing blocks to the system
+const size_t max_cached_bytes = 64 * 1024;
+
+struct free_block {
+  free_block *next;
+};
+
+/**
+ * The free lists and counters of one thread. It is trivially constructible
+ * and destructible, so it can be used while the thread exits, after its free
+ * lists were released.
+ */
+struct thread_block_cache {
+  free_block *free_lists[size_class_count];
+  size_t cached_bytes[size_class_count];
+  memory_allocator_stats stats;
+  bool registered;
+  bool released;
+};
+
+thread_local thread_block_cache cache;
+
+/**
+ * Frees the blocks in the free lists of a thread to the system when the
+ * thread exits. Blocks freed after that go to the system directly.
+ */
+struct thread_block_cache_releaser {
+  void touch() {}
+
+  ~thread_block_cache_releaser()
+  {
+    for (size_t i = 0; i < size_class_count; ++i) {
+      while (cache.free_lists[i] != NULL) {
+        free_block *block = cache.free_lists[i];
+        cache.free_lists[i] = block->next;
+        free(block);
+        ++cache.stats.system_deallocations;
+      }
+      cache.cached_bytes[i] = 0;
+    }
+    cache.released = true;
+  }
+};
+
+thread_local thread_block_cache_releaser cache_releaser;
+
+size_t size_class_index(size_t size)
+{
+  return lower_bound(size_classes, size_classes + size_class_count, size) - size_classes;
+}
+
+void *system_allocate(size_t size)
+{
+  void *ptr = malloc(size);
+  if (ptr == NULL) {
+    throw bad_alloc();
+  }
+  ++cache.stats.system_allocations;
+
+  return ptr;
+}
+
+void system_deallocate(void *ptr, size_t DYND_UNUSED(size))
+{
+  free(ptr);
+  ++cache.stats.system_deallocations;
+}
+
+void *pool_allocate(size_t size)
+{
+  if (size > size_classes[size_class_count - 1]) {
+    return system_allocate(size);
+  }
+
+  size_t i = size_class_index(size);
+  free_block *block = cache.free_lists[i];
+  if (block == NULL) {
+    return system_allocate(size_classes[i]);
+  }
+
+  cache.free_lists[i] = block->next;
+  cache.cached_bytes[i] -= size_classes[i];
+  ++cache.stats.pool_allocations;
+
+  return block;
+}
+
+void pool_deallocate(void *ptr, size_t size)
+{
+  if (size > size_classes[size_class_count - 1] || cache.released) {
+    system_deallocate(ptr, size);
+    return;
+  }
+
+  size_t i = size_class_index(size);
+  if (cache.cached_bytes[i] + size_classes[i] > max_cached_bytes) {
+    system_deallocate(ptr, size);
+    return;
+  }
+
+  if (!cache.registered) {
+    cache_releaser.touch();
+    cache.registered = true;
+  }
+
+  free_block *block = reinterpret_cast<free_block *>(ptr);
+  block->next = cache.free_lists[i];
+  cache.free_lists[i] = block;
+  cache.cached_bytes[i] += size_classes[i];
+}
+
+#if defined(MAP_ANONYMOUS) && (defined(MAP_HUGETLB) || defined(MADV_HUGEPAGE))
+
+// The size of the huge pages on x86-64 and the usual size on other platforms
+const size_t huge_page_size = 2 * 1024 * 1024;
+
+size_t huge_page_round(size_t size) { return (size + huge_page_size - 1) & ~(huge_page_size - 1); }
+
+void *huge_page_allocate(size_t size)
+{
+  size = huge_page_round(size);
+
+  void *ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (ptr == MAP_FAILED) {
+    // No huge pages are reserved, so ask for transparent huge pages
+    ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+      throw bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+  }
+  ++cache.stats.system_allocations;
+
+  return ptr;
+}
+
+void huge_page_deallocate(void *ptr, size_t size)
+{
+  munmap(ptr, huge_page_round(size));
+  ++cache.stats.system_deallocations;
+}
+
+#else
+
+void *huge_page_allocate(size_t size) { return system_allocate(size); }
+
+void huge_page_deallocate(void *ptr, size_t size) { system_deallocate(ptr, size); }
+
+#endif
+
+memory_allocator system_allocator = {&system_allocate, &system_deallocate};
+memory_allocator pool_allocator = {&pool_allocate, &pool_deallocate};
+memory_allocator huge_page_allocator = {&huge_page_allocate, &huge_page_deallocate};
+
+atomic<memory_allocator *> current_allocator(&pool_allocator);
+
+/**
+ * Goes in front of every block allocated by memory_block_allocate, to free
+ * it with the allocator which allocated it. Its size keeps the alignment of
+ * the system allocator.
+ */
+struct alignas(16) memory_block_header {
+  memory_allocator *allocator;
+  size_t size;
+};
+
+} // anonymous namespace
+
+memory_allocator *dynd::get_system_memory_allocator() { return &system_allocator; }
+
+memory_allocator *dynd::get_pool_memory_allocator() { return &pool_allocator; }
+
+memory_allocator *dynd::get_huge_page_memory_allocator() { return &huge_page_allocator; }
+
+memory_allocator *dynd::get_memory_allocator() { return current_allocator.load(memory_order_relaxed); }
+
+void dynd::set_memory_allocator(memory_allocator *allocator)
+{
+  current_allocator.store((allocator == NULL) ? &pool_allocator : allocator);
+}
+
+memory_allocator_stats dynd::get_memory_allocator_stats()
+{
+  memory_allocator_stats stats = cache.stats;
+  stats.cached_bytes = 0;
+  for (size_t i = 0; i < size_class_count; ++i) {
+    stats.cached_bytes += cache.cached_bytes[i];
+  }
+
+  return stats;
+}
+
+void *dynd::detail::memory_block_allocate(size_t size)
+{
+  return memory_block_allocate(size, current_allocator.load(memory_order_relaxed));
+}
+
+void *dynd::detail::memory_block_allocate(size_t size, memory_allocator *allocator)
+{
+  size += sizeof(memory_block_header);
+  memory_block_header *header = reinterpret_cast<memory_block_header *>(allocator->allocate(size));
+  header->allocator = allocator;
+  header->size = size;
+  ++cache.stats.allocations;
+
+  return header + 1;
+}
+
+void dynd::detail::memory_block_deallocate(void *ptr)
+{
+  memory_block_header *header = reinterpret_cast<memory_block_header *>(ptr) - 1;
+  ++cache.stats.deallocations;
+  header->allocator->deallocate(header, header->size);
+}
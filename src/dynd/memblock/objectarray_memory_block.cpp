@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include <dynd/memblock/objectarray_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -30,6 +31,11 @@ struct objectarray_memory_block {
   bool m_finalized;
   /** The malloc'd memory */
   vector<memory_chunk> m_memory_handles;
+  /**
+   * A POD memory block for variable-sized data owned by the objects, created
+   * on first use. Being a member, it is freed after the objects are destroyed.
+   */
+  intrusive_ptr<memory_block_data> m_arena;
 
   /**
    * Allocates some new memory from which to dole out
@@ -53,7 +59,7 @@ struct objectarray_memory_block {
   objectarray_memory_block(const ndt::type &dt, size_t arrmeta_size, const char *arrmeta, intptr_t stride,
                            intptr_t initial_count)
       : m_mbd(1, objectarray_memory_block_type), m_dt(dt), arrmeta_size(arrmeta_size), m_arrmeta(arrmeta),
-        m_stride(stride), m_total_allocated_count(0), m_finalized(false), m_memory_handles()
+        m_stride(stride), m_total_allocated_count(0), m_finalized(false), m_memory_handles(), m_arena()
   {
     if ((dt.get_flags() & type_flag_destructor) == 0) {
       stringstream ss;
@@ -75,6 +81,29 @@ struct objectarray_memory_block {
 };
 } // anonymous namespace
 
+memory_block_data *dynd::get_objectarray_memory_block_arena(memory_block_data *memblock)
+{
+  if (memblock->m_type != objectarray_memory_block_type) {
+    throw runtime_error("get_objectarray_memory_block_arena requires an objectarray memory block");
+  }
+  objectarray_memory_block *emb = reinterpret_cast<objectarray_memory_block *>(memblock);
+  if (emb->m_arena.get() == NULL) {
+    emb->m_arena = make_pod_memory_block(ndt::type::make<uint8_t>(), 4096);
+  }
+  return emb->m_arena.get();
+}
+
+static thread_local memory_block_data *current_string_arena = NULL;
+
+memory_block_data *dynd::get_string_arena() { return current_string_arena; }
+
+dynd::string_arena_scope::string_arena_scope(memory_block_data *arena) : m_previous(current_string_arena)
+{
+  current_string_arena = arena;
+}
+
+dynd::string_arena_scope::~string_arena_scope() { current_string_arena = m_previous; }
+
 intrusive_ptr<memory_block_data> dynd::make_objectarray_memory_block(const ndt::type &dt, const char *arrmeta, intptr_t stride,
                                                   intptr_t initial_count, size_t arrmeta_size)
 {
@@ -126,12 +155,14 @@ namespace detail {
 
     if (mc->capacity_count - previous_index < count) {
       emb->append_memory(max(emb->m_total_allocated_count, count));
+      // Appending may have moved the chunks
+      mc = &emb->m_memory_handles[emb->m_memory_handles.size() - 2];
       memory_chunk *new_mc = &emb->m_memory_handles.back();
       // Move the old memory to the newly allocated block
       if (previous_count > 0) {
         // Subtract the previously used memory from the old chunk's count
         mc->used_count -= previous_count;
-        memcpy(new_mc->memory, previous_allocated, previous_count);
+        memcpy(new_mc->memory, previous_allocated, previous_count * emb->m_stride);
         // If the old memory only had the memory being resized,
         // free it completely.
         if (previous_allocated == mc->memory) {
@@ -199,6 +230,10 @@ namespace detail {
       memory_chunk &mc = emb->m_memory_handles.front();
       emb->m_dt.extended()->data_destruct_strided(emb->m_arrmeta, mc.memory, emb->m_stride, mc.used_count);
       mc.used_count = 0;
+      // With every object destroyed, nothing refers to the arena anymore
+      if (emb->m_arena.get() != NULL) {
+        emb->m_arena->get_api()->reset(emb->m_arena.get());
+      }
     }
   }
 
@@ -7,6 +7,8 @@
 #include <climits>
 
 #include <dynd/parser_util.hpp>
+#include <dynd/json_structural_index.hpp>
+#include <dynd/number_conversion.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/string_encodings.hpp>
 #include <dynd/types/option_type.hpp>
@@ -70,6 +72,8 @@ bool parse::parse_doublequote_string_no_ws(const char *&rbegin, const char *end,
     return false;
   }
   for (;;) {
+    // Everything up to the next quote or backslash is plain string content
+    begin = find_quote_or_backslash(begin, end);
     if (begin == end) {
       throw parse::parse_error(rbegin, "string has no ending quote");
     }
@@ -585,10 +589,15 @@ double parse::checked_string_to_float64(const char *begin, const char *end, assi
     }
   }
 
-  // TODO: use http://www.netlib.org/fp/dtoa.c
+  double value;
+  if (parse_float64(begin, end, value)) {
+    return value;
+  }
+
+  // Hexadecimal floats and the like, or something which is not a number at all
   char *end_ptr;
   std::string s(begin, end);
-  double value = strtod(s.c_str(), &end_ptr);
+  value = strtod(s.c_str(), &end_ptr);
   if (errmode != assign_error_nocheck && (size_t)(end_ptr - s.c_str()) != s.size()) {
     stringstream ss;
     ss << "parse error converting string ";
@@ -0,0 +1,413 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/serialize.hpp>
+#include <dynd/bytes.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/memblock/external_memory_block.hpp>
+#include <dynd/memblock/memmap_memory_block.hpp>
+#include <dynd/func/callable.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/tuple_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+const char serialize_magic[8] = {'D', 'Y', 'N', 'D', 'S', 'E', 'R', '\0'};
+const uint32_t serialize_version = 1;
+const uint32_t serialize_byte_order = 0x01020304;
+// The alignment the buffer needs to be read in place, enough for any type
+const size_t serialize_alignment = 16;
+
+size_t get_data_size(const ndt::type &tp)
+{
+  return tp.is_builtin() ? tp.get_data_size() : tp.extended()->get_default_data_size();
+}
+
+/** Whether the data of the type holds no pointers that need relocating */
+bool is_relocatable_pod(const ndt::type &tp)
+{
+  return tp.is_builtin() || (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+}
+
+/**
+ * Writes the data of an array into a buffer, followed by the variable-sized
+ * data it points to, with the pointers replaced by offsets in the buffer.
+ */
+class serializer {
+  vector<char> &m_buffer;
+
+  /** Appends the data, aligned, returning its offset */
+  size_t append(const char *data, size_t size, size_t alignment)
+  {
+    size_t offset = inc_to_alignment(m_buffer.size(), alignment);
+    m_buffer.resize(offset + size);
+    if (size != 0) {
+      memcpy(&m_buffer[offset], data, size);
+    }
+
+    return offset;
+  }
+
+public:
+  serializer(vector<char> &buffer) : m_buffer(buffer) {}
+
+  /**
+   * Appends the data of a value in C order, returning its offset. The value
+   * must have the arrmeta nd::empty gives its type.
+   */
+  size_t write(const ndt::type &tp, const char *arrmeta, const char *data)
+  {
+    size_t offset = append(data, get_data_size(tp), max<size_t>(tp.get_data_alignment(), 1));
+    relocate(tp, arrmeta, offset);
+
+    return offset;
+  }
+
+  /**
+   * Copies what the value at ``offset`` in the buffer points to into the
+   * buffer, replacing its pointers with offsets. The buffer may be
+   * reallocated while doing so, so only offsets into it are kept.
+   */
+  void relocate(const ndt::type &tp, const char *arrmeta, size_t offset)
+  {
+    if (is_relocatable_pod(tp)) {
+      return;
+    }
+
+    switch (tp.get_type_id()) {
+    case fixed_dim_type_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < md->dim_size; ++i) {
+        relocate(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), offset + i * md->stride);
+      }
+      return;
+    }
+    case var_dim_type_id: {
+      const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+      var_dim_type_data d = *reinterpret_cast<const var_dim_type_data *>(&m_buffer[offset]);
+      if (md->stride != static_cast<intptr_t>(get_data_size(el_tp))) {
+        throw runtime_error("nd::serialize: var dimension is not in C order");
+      }
+
+      size_t el_offset = append(d.begin + md->offset, d.size * md->stride, max<size_t>(el_tp.get_data_alignment(), 1));
+      reinterpret_cast<var_dim_type_data *>(&m_buffer[offset])->begin = reinterpret_cast<char *>(el_offset);
+      for (size_t i = 0; i < d.size; ++i) {
+        relocate(el_tp, arrmeta + sizeof(var_dim_type_arrmeta), el_offset + i * md->stride);
+      }
+      return;
+    }
+    case tuple_type_id:
+    case struct_type_id: {
+      const ndt::tuple_type *tt = tp.extended<ndt::tuple_type>();
+      const uintptr_t *data_offsets = tt->get_data_offsets(arrmeta);
+      const uintptr_t *arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+      for (intptr_t i = 0; i < tt->get_field_count(); ++i) {
+        relocate(tt->get_field_type(i), arrmeta + arrmeta_offsets[i], offset + data_offsets[i]);
+      }
+      return;
+    }
+    case option_type_id:
+      relocate(tp.extended<ndt::option_type>()->get_value_type(), arrmeta, offset);
+      return;
+    case string_type_id:
+    case bytes_type_id: {
+      // Inline values are copied with the data, and NA strings have no data
+      const bytes *b = reinterpret_cast<const bytes *>(&m_buffer[offset]);
+      if (b->is_inline() || b->data() == NULL) {
+        return;
+      }
+
+      size_t size = b->size();
+      size_t chars_offset = append(b->data(), size, 1);
+      // The copied bytes value doesn't own the copy of its data, so it is
+      // overwritten without being destroyed
+      bytes *dst = new (&m_buffer[offset]) bytes();
+      dst->borrow(reinterpret_cast<char *>(chars_offset), size);
+      return;
+    }
+    default:
+      break;
+    }
+
+    stringstream ss;
+    ss << "nd::serialize: cannot serialize type " << tp;
+    throw type_error(ss.str());
+  }
+};
+
+/**
+ * Adds ``delta`` to the pointers in the data of a value read from a buffer
+ * of ``size`` bytes at ``base``, after checking that what they point to is
+ * in the buffer.
+ */
+class deserializer {
+  char *m_begin, *m_end;
+  intptr_t m_delta;
+  const intrusive_ptr<memory_block_data> &m_blockref;
+
+  void check_range(const char *begin, size_t size) const
+  {
+    if (begin < m_begin || begin > m_end || size > static_cast<size_t>(m_end - begin)) {
+      throw runtime_error("nd::deserialize: buffer is corrupt, it points outside of itself");
+    }
+  }
+
+public:
+  deserializer(char *begin, size_t size, intptr_t delta, const intrusive_ptr<memory_block_data> &blockref)
+      : m_begin(begin), m_end(begin + size), m_delta(delta), m_blockref(blockref)
+  {
+  }
+
+  /** Sets the references in default-constructed arrmeta to the memory block of the buffer */
+  void init_arrmeta(const ndt::type &tp, char *arrmeta)
+  {
+    if (is_relocatable_pod(tp)) {
+      return;
+    }
+
+    switch (tp.get_type_id()) {
+    case fixed_dim_type_id:
+      init_arrmeta(tp.extended<ndt::fixed_dim_type>()->get_element_type(), arrmeta + sizeof(fixed_dim_type_arrmeta));
+      break;
+    case var_dim_type_id:
+      reinterpret_cast<var_dim_type_arrmeta *>(arrmeta)->blockref = m_blockref;
+      init_arrmeta(tp.extended<ndt::var_dim_type>()->get_element_type(), arrmeta + sizeof(var_dim_type_arrmeta));
+      break;
+    case tuple_type_id:
+    case struct_type_id: {
+      const ndt::tuple_type *tt = tp.extended<ndt::tuple_type>();
+      const uintptr_t *arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+      for (intptr_t i = 0; i < tt->get_field_count(); ++i) {
+        init_arrmeta(tt->get_field_type(i), arrmeta + arrmeta_offsets[i]);
+      }
+      break;
+    }
+    case option_type_id:
+      init_arrmeta(tp.extended<ndt::option_type>()->get_value_type(), arrmeta);
+      break;
+    default:
+      break;
+    }
+  }
+
+  /**
+   * Adds the delta to the pointers in the value at ``data``. With ``check``,
+   * nothing is written, and only the ranges the relocated pointers refer to
+   * are checked, so a corrupt buffer can be rejected before it is modified.
+   */
+  void relocate(const ndt::type &tp, const char *arrmeta, char *data, bool check)
+  {
+    if (is_relocatable_pod(tp)) {
+      return;
+    }
+
+    switch (tp.get_type_id()) {
+    case fixed_dim_type_id: {
+      const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      for (intptr_t i = 0; i < md->dim_size; ++i) {
+        relocate(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), data + i * md->stride, check);
+      }
+      return;
+    }
+    case var_dim_type_id: {
+      const var_dim_type_arrmeta *md = reinterpret_cast<const var_dim_type_arrmeta *>(arrmeta);
+      const ndt::type &el_tp = tp.extended<ndt::var_dim_type>()->get_element_type();
+      var_dim_type_data *d = reinterpret_cast<var_dim_type_data *>(data);
+      char *begin = d->begin + m_delta;
+      if (check) {
+        if (d->size > static_cast<size_t>(m_end - m_begin) / max<intptr_t>(md->stride, 1)) {
+          throw runtime_error("nd::deserialize: buffer is corrupt, it points outside of itself");
+        }
+        check_range(begin, d->size * md->stride);
+      }
+      else {
+        d->begin = begin;
+      }
+      for (size_t i = 0; i < d->size; ++i) {
+        relocate(el_tp, arrmeta + sizeof(var_dim_type_arrmeta), begin + i * md->stride, check);
+      }
+      return;
+    }
+    case tuple_type_id:
+    case struct_type_id: {
+      const ndt::tuple_type *tt = tp.extended<ndt::tuple_type>();
+      const uintptr_t *data_offsets = tt->get_data_offsets(arrmeta);
+      const uintptr_t *arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+      for (intptr_t i = 0; i < tt->get_field_count(); ++i) {
+        relocate(tt->get_field_type(i), arrmeta + arrmeta_offsets[i], data + data_offsets[i], check);
+      }
+      return;
+    }
+    case option_type_id:
+      relocate(tp.extended<ndt::option_type>()->get_value_type(), arrmeta, data, check);
+      return;
+    case string_type_id:
+    case bytes_type_id: {
+      bytes *b = reinterpret_cast<bytes *>(data);
+      if (b->is_inline() || (b->data() == NULL && b->size() == 0)) {
+        return;
+      }
+      if (check) {
+        if (!b->is_borrowed()) {
+          throw runtime_error("nd::deserialize: buffer is corrupt, a string owns its data");
+        }
+        check_range(b->data() + m_delta, b->size());
+      }
+      else {
+        b->borrow(b->data() + m_delta, b->size());
+      }
+      return;
+    }
+    default:
+      break;
+    }
+
+    stringstream ss;
+    ss << "nd::deserialize: cannot deserialize type " << tp;
+    throw type_error(ss.str());
+  }
+};
+
+void delete_buffer(void *buffer) { delete reinterpret_cast<vector<char> *>(buffer); }
+
+/** Reads the buffer of ``size`` bytes at ``begin`` in place */
+nd::array read_in_place(char *begin, size_t size, uint64_t access,
+                               const intrusive_ptr<memory_block_data> &blockref)
+{
+  serialize_header header;
+  if (size < sizeof(header)) {
+    throw runtime_error("nd::deserialize: buffer is too small to be a serialized array");
+  }
+  memcpy(&header, begin, sizeof(header));
+  if (memcmp(header.magic, serialize_magic, sizeof(header.magic)) != 0 || header.version != serialize_version) {
+    throw runtime_error("nd::deserialize: buffer is not a serialized array");
+  }
+  if (header.byte_order != serialize_byte_order || header.pointer_size != sizeof(intptr_t)) {
+    throw runtime_error("nd::deserialize: buffer was written on a machine with a different byte order or pointer size");
+  }
+  if (reinterpret_cast<uintptr_t>(begin) % serialize_alignment != 0) {
+    throw runtime_error("nd::deserialize: buffer must be aligned to 16 bytes to be read in place");
+  }
+  if (header.size != size || header.datashape_size > size || header.data_offset > size ||
+      sizeof(header) + header.datashape_size > header.data_offset) {
+    throw runtime_error("nd::deserialize: buffer is truncated or corrupt");
+  }
+
+  ndt::type tp(std::string(begin + sizeof(header), begin + sizeof(header) + header.datashape_size));
+  if (tp.is_symbolic() || tp.get_kind() == memory_kind || get_data_size(tp) > size - header.data_offset) {
+    throw runtime_error("nd::deserialize: buffer is truncated or corrupt");
+  }
+
+  nd::array result(make_array_memory_block(tp.get_arrmeta_size()));
+  array_preamble *preamble = result.get();
+  if (!tp.is_builtin()) {
+    tp.extended()->arrmeta_default_construct(preamble->metadata(), false);
+  }
+  preamble->tp = tp;
+  preamble->data = begin + header.data_offset;
+  preamble->owner = blockref;
+  preamble->flags = access;
+
+  deserializer d(begin, size, static_cast<intptr_t>(reinterpret_cast<uintptr_t>(begin) - header.base), blockref);
+  d.init_arrmeta(tp, preamble->metadata());
+  // Everything is checked before any pointer is written, so a corrupt buffer is left as it was
+  d.relocate(tp, preamble->metadata(), preamble->data, true);
+  if (header.base != reinterpret_cast<uintptr_t>(begin)) {
+    d.relocate(tp, preamble->metadata(), preamble->data, false);
+    reinterpret_cast<serialize_header *>(begin)->base = reinterpret_cast<uintptr_t>(begin);
+  }
+
+  return result;
+}
+
+} // anonymous namespace
+
+nd::array nd::serialize(const array &a)
+{
+  array c = a.eval();
+  if (!c.get_type().is_c_contiguous(c.get()->metadata())) {
+    c = c.eval_copy();
+  }
+  const ndt::type &tp = c.get_type();
+  if (tp.get_kind() == memory_kind) {
+    stringstream ss;
+    ss << "nd::serialize: cannot serialize type " << tp;
+    throw type_error(ss.str());
+  }
+  std::string datashape = tp.str();
+
+  vector<char> *buffer = new vector<char>;
+  intrusive_ptr<memory_block_data> buffer_ref = make_external_memory_block(buffer, &delete_buffer);
+
+  serialize_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, serialize_magic, sizeof(header.magic));
+  header.version = serialize_version;
+  header.byte_order = serialize_byte_order;
+  header.pointer_size = sizeof(intptr_t);
+  header.datashape_size = datashape.size();
+  buffer->insert(buffer->end(), reinterpret_cast<const char *>(&header),
+                 reinterpret_cast<const char *>(&header) + sizeof(header));
+  buffer->insert(buffer->end(), datashape.begin(), datashape.end());
+  buffer->resize(inc_to_alignment(buffer->size(), serialize_alignment));
+
+  serializer s(*buffer);
+  size_t data_offset = s.write(tp, c.get()->metadata(), c.cdata());
+
+  serialize_header *written_header = reinterpret_cast<serialize_header *>(buffer->data());
+  written_header->data_offset = data_offset;
+  written_header->size = buffer->size();
+
+  intptr_t size = buffer->size(), stride = 1;
+  return make_strided_array_from_data(ndt::type::make<uint8_t>(), 1, &size, &stride, nd::default_access_flags,
+                                      buffer->data(), buffer_ref);
+}
+
+nd::array nd::deserialize(const array &buffer, deserialize_mode_t mode)
+{
+  const ndt::type &tp = buffer.get_type();
+  if (tp.get_ndim() != 1 || tp.get_dtype().get_data_size() != 1 || !tp.is_c_contiguous(buffer.get()->metadata())) {
+    stringstream ss;
+    ss << "nd::deserialize: buffer must be a C-contiguous array of bytes, not of type " << tp;
+    throw type_error(ss.str());
+  }
+  size_t size = buffer.get_dim_size();
+
+  if (mode == deserialize_in_place) {
+    if ((buffer.get_access_flags() & nd::write_access_flag) == 0) {
+      throw runtime_error("nd::deserialize: buffer must be writable to be read in place");
+    }
+    // Writing through the result could make its pointers refer outside of the buffer
+    return read_in_place(buffer.data(), size, nd::read_access_flag, buffer.get_data_memblock());
+  }
+
+  vector<char> *copy = new vector<char>(buffer.cdata(), buffer.cdata() + size);
+  intrusive_ptr<memory_block_data> copy_ref = make_external_memory_block(copy, &delete_buffer);
+  return read_in_place(copy->data(), size, nd::read_access_flag | nd::immutable_access_flag, copy_ref);
+}
+
+nd::array nd::deserialize_mmap(const std::string &filename)
+{
+  char *mm_ptr = NULL;
+  intptr_t mm_size = 0;
+  intrusive_ptr<memory_block_data> mm =
+      make_memmap_memory_block(filename, nd::read_access_flag | nd::write_access_flag, &mm_ptr, &mm_size, 0,
+                               numeric_limits<intptr_t>::max(), true);
+
+  return read_in_place(mm_ptr, mm_size, nd::read_access_flag | nd::immutable_access_flag, mm);
+}
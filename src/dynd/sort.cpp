@@ -17,9 +17,30 @@ DYND_API nd::callable nd::sort::make()
 
 DYND_API struct nd::sort nd::sort;
 
+DYND_API nd::callable nd::argsort::make()
+{
+  return callable::make<argsort_kernel>();
+}
+
+DYND_API struct nd::argsort nd::argsort;
+
 DYND_API nd::callable nd::unique::make()
 {
   return callable::make<unique_kernel>();
 }
 
 DYND_API struct nd::unique nd::unique;
+
+DYND_API nd::callable nd::value_counts::make()
+{
+  return callable::make<value_counts_kernel>();
+}
+
+DYND_API struct nd::value_counts nd::value_counts;
+
+DYND_API nd::callable nd::count_distinct::make()
+{
+  return callable::make<count_distinct_kernel>();
+}
+
+DYND_API struct nd::count_distinct nd::count_distinct;
@@ -164,7 +164,7 @@ ndt::type ndt::type::at_array(int nindices, const irange *indices) const
 }
 
 bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta,
-                      std::map<std::string, ndt::type> &tp_vars) const
+                      ndt::typevar_map &tp_vars) const
 {
   // A type being matched against itself works for both type id and more
   // complicated types
@@ -182,18 +182,18 @@ bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const
 
 bool ndt::type::match(const char *arrmeta, const ndt::type &candidate_tp, const char *candidate_arrmeta) const
 {
-  std::map<std::string, ndt::type> tp_vars;
+  ndt::typevar_map tp_vars;
   return match(arrmeta, candidate_tp, candidate_arrmeta, tp_vars);
 }
 
-bool ndt::type::match(const ndt::type &candidate_tp, std::map<std::string, ndt::type> &tp_vars) const
+bool ndt::type::match(const ndt::type &candidate_tp, ndt::typevar_map &tp_vars) const
 {
   return match(NULL, candidate_tp, NULL, tp_vars);
 }
 
 bool ndt::type::match(const ndt::type &candidate_tp) const
 {
-  std::map<std::string, ndt::type> tp_vars;
+  ndt::typevar_map tp_vars;
   return match(candidate_tp, tp_vars);
 }
 
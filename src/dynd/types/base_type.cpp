@@ -226,7 +226,7 @@ size_t ndt::base_type::make_comparison_kernel(void *DYND_UNUSED(ckb), intptr_t D
 
 bool ndt::base_type::match(const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
                            const char *DYND_UNUSED(candidate_arrmeta),
-                           std::map<std::string, type> &DYND_UNUSED(tp_vars)) const
+                           typevar_map &DYND_UNUSED(tp_vars)) const
 {
   // The default match implementation is equality, pattern types
   // must override this virtual function.
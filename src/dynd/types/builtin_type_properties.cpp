@@ -126,15 +126,15 @@ size_t dynd::make_builtin_type_elwise_property_getter_kernel(void *ckb, intptr_t
     case 0:
       return nd::real_kernel<float32_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     case 1:
       return nd::imag_kernel<float32_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     case 2:
       return nd::conj_kernel<float32_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     default:
       break;
     }
@@ -144,15 +144,15 @@ size_t dynd::make_builtin_type_elwise_property_getter_kernel(void *ckb, intptr_t
     case 0:
       return nd::real_kernel<float64_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     case 1:
       return nd::imag_kernel<float64_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     case 2:
       return nd::conj_kernel<float64_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     default:
       break;
     }
@@ -176,7 +176,7 @@ size_t dynd::make_builtin_type_elwise_property_setter_kernel(void *ckb, intptr_t
     case 2:
       return nd::conj_kernel<float32_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     default:
       break;
     }
@@ -186,7 +186,7 @@ size_t dynd::make_builtin_type_elwise_property_setter_kernel(void *ckb, intptr_t
     case 2:
       return nd::conj_kernel<float64_type_id>::instantiate(NULL, NULL, ckb, ckb_offset, ndt::type(), dst_arrmeta, 1,
                                                            NULL, &src_arrmeta, kernreq, ectx, 0, NULL,
-                                                           std::map<std::string, ndt::type>());
+                                                           ndt::typevar_map());
     default:
       break;
     }
@@ -293,7 +293,7 @@ intptr_t ndt::callable_type::make_assignment_kernel(void *ckb, intptr_t ckb_offs
 }
 
 bool ndt::callable_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                               std::map<std::string, type> &tp_vars) const
+                               typevar_map &tp_vars) const
 {
   if (candidate_tp.get_type_id() != callable_type_id) {
     return false;
@@ -366,7 +366,7 @@ void ndt::callable_type::get_dynamic_type_properties(std::map<std::string, nd::c
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = make_fixed_dim(tp.extended<callable_type>()->get_npos(), make_type<type_type>());
@@ -388,7 +388,7 @@ void ndt::callable_type::get_dynamic_type_properties(std::map<std::string, nd::c
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = make_fixed_dim(tp.extended<callable_type>()->get_nkwd(), make_type<type_type>());
@@ -410,7 +410,7 @@ void ndt::callable_type::get_dynamic_type_properties(std::map<std::string, nd::c
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<callable_type>()->get_kwd_names().get_type();
@@ -476,7 +476,7 @@ static array_preamble *function___call__(const array_preamble *params, void *DYN
   }
   ckernel_builder<kernel_request_host> ckb;
   af->instantiate(NULL, NULL, &ckb, 0, args[0].get_type(), args[0].get()->metadata(), nargs, src_tp, dynd_arrmeta,
-                  kernel_request_single, &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                  kernel_request_single, &eval::default_eval_context, 0, NULL, ndt::typevar_map());
   // Call the ckernel
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   char *in_ptrs[max_args];
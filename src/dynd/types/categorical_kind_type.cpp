@@ -135,7 +135,7 @@ void ndt::categorical_kind_type::data_destruct_strided(
 bool ndt::categorical_kind_type::match(
     const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
     const char *DYND_UNUSED(candidate_arrmeta),
-    std::map<std::string, type> &DYND_UNUSED(tp_vars)) const
+    typevar_map &DYND_UNUSED(tp_vars)) const
 {
   return candidate_tp.get_type_id() == categorical_type_id;
 }
@@ -17,6 +17,7 @@
 #include <dynd/func/assignment.hpp>
 #include <dynd/kernels/base_property_kernel.hpp>
 #include <dynd/search.hpp>
+#include <dynd/kernels/unique_kernel.hpp>
 
 using namespace dynd;
 using namespace std;
@@ -112,9 +113,9 @@ public:
 
 } // anoymous namespace
 
-/** This function converts the set of char* pointers into a strided immutable
+/** This function converts the sorted char* pointers into a strided immutable
  * nd::array of the categories */
-static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, const ndt::type &element_tp,
+static nd::array make_sorted_categories(const vector<const char *> &uniques, const ndt::type &element_tp,
                                         const char *arrmeta)
 {
   nd::array categories = nd::empty(uniques.size(), element_tp);
@@ -125,7 +126,7 @@ static nd::array make_sorted_categories(const set<const char *, cmp> &uniques, c
 
   intptr_t stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
   char *dst_ptr = categories.data();
-  for (set<const char *, cmp>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
+  for (vector<const char *>::const_iterator it = uniques.begin(); it != uniques.end(); ++it) {
     char *src = const_cast<char *>(*it);
     fn(k.get(), dst_ptr, &src);
     dst_ptr += stride;
@@ -160,7 +161,7 @@ ndt::categorical_type::categorical_type(const nd::array &categories, bool presor
       throw dynd::type_error("categorical_type only supports construction from "
                              "a fixed-dim array of categories");
     }
-    m_category_tp = categories.get_type().at(0);
+    m_category_tp = cdt.extended<fixed_dim_type>()->get_element_type();
     if (!m_category_tp.is_scalar()) {
       throw dynd::type_error("categorical_type only supports construction from "
                              "a 1-dimensional strided array of categories");
@@ -211,7 +212,8 @@ ndt::categorical_type::categorical_type(const nd::array &categories, bool presor
                                            unchecked_fixed_dim_get<intptr_t>(m_category_index_to_value, i)) = i;
     }
 
-    m_categories = make_sorted_categories(uniques, m_category_tp, categories_element_arrmeta);
+    m_categories = make_sorted_categories(vector<const char *>(uniques.begin(), uniques.end()), m_category_tp,
+                                          categories_element_arrmeta);
   }
 
   // Use the number of categories to set which underlying integer storage to use
@@ -260,9 +262,10 @@ void ndt::categorical_type::print_type(std::ostream &o) const
 
   o << "categorical[" << m_category_tp;
   o << ", [";
-  m_category_tp.print_data(o, arrmeta, get_category_data_from_value(0));
-  for (size_t i = 1; i != category_count; ++i) {
-    o << ", ";
+  for (size_t i = 0; i != category_count; ++i) {
+    if (i != 0) {
+      o << ", ";
+    }
     m_category_tp.print_data(o, arrmeta, get_category_data_from_value((uint32_t)i));
   }
   o << "]]";
@@ -289,7 +292,7 @@ uint32_t ndt::categorical_type::get_value_from_category(const char *category_arr
   const char *src_arrmeta[2] = {m_categories.get()->metadata(), category_arrmeta};
   char *src_data[2] = {const_cast<char *>(m_categories.cdata()), const_cast<char *>(category_data)};
   intptr_t i = (*nd::binary_search::get().get())(dst_tp, 2, src_tp, src_arrmeta, src_data, 0, NULL,
-                                                 std::map<std::string, ndt::type>())
+                                                 ndt::typevar_map())
                    .as<intptr_t>();
   if (i < 0) {
     stringstream ss;
@@ -515,15 +518,24 @@ ndt::type ndt::factor_categorical(const nd::array &values)
   ::make_comparison_kernel(&k, 0, el_tp, el_arrmeta, el_tp, el_arrmeta, comparison_type_sorting_less,
                            &eval::default_eval_context);
   expr_single_t fn = k.get()->get_function<expr_single_t>();
-
   cmp less(fn, k.get());
-  set<const char *, cmp> uniques(less);
 
-  for (intptr_t i = 0; i < dim_size; ++i) {
-    const char *data = values_eval.cdata() + i * stride;
-    if (uniques.find(data) == uniques.end()) {
-      uniques.insert(data);
+  vector<const char *> uniques;
+  nd::detail::hash_functions functions;
+  if (nd::detail::get_hash_functions(el_tp.get_type_id(), functions)) {
+    // Find the distinct values with a hash table, so only they get sorted
+    vector<nd::detail::value_count> counts = functions.count_values(values_eval.cdata(), stride, dim_size, NULL, 1);
+    for (const nd::detail::value_count &c : counts) {
+      uniques.push_back(values_eval.cdata() + c.first_index * stride);
     }
+    std::sort(uniques.begin(), uniques.end(), less);
+  }
+  else {
+    set<const char *, cmp> unique_set(less);
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      unique_set.insert(values_eval.cdata() + i * stride);
+    }
+    uniques.assign(unique_set.begin(), unique_set.end());
   }
 
   // Copy the values (now sorted and unique) into a new nd::array
@@ -532,6 +544,70 @@ ndt::type ndt::factor_categorical(const nd::array &values)
   return type(new categorical_type(categories, true), false);
 }
 
+template <typename UIntType>
+static void write_codes(char *dst, intptr_t dst_stride, const vector<uint32_t> &codes)
+{
+  for (uint32_t code : codes) {
+    *reinterpret_cast<UIntType *>(dst) = static_cast<UIntType>(code);
+    dst += dst_stride;
+  }
+}
+
+nd::array nd::dictionary_encode(const array &values)
+{
+  array values_eval = values.eval();
+  if (values_eval.get_ndim() != 1) {
+    stringstream ss;
+    ss << "nd::dictionary_encode requires a one-dimensional array, not one of type " << values_eval.get_type();
+    throw invalid_argument(ss.str());
+  }
+
+  intptr_t dim_size, stride;
+  ndt::type el_tp;
+  const char *el_arrmeta;
+  values_eval.get_type().get_as_strided(values_eval.get()->metadata(), &dim_size, &stride, &el_tp, &el_arrmeta);
+
+  vector<uint32_t> codes(dim_size);
+  ndt::type cat_tp;
+  detail::hash_functions functions;
+  if (detail::get_hash_functions(el_tp.get_type_id(), functions)) {
+    vector<intptr_t> first_indices;
+    functions.encode(values_eval.cdata(), stride, dim_size, codes.data(), first_indices);
+
+    // The categories in order of first occurrence, so that the value of
+    // each category is the code it was given
+    array categories = empty(first_indices.size(), el_tp);
+    intptr_t categories_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(categories.get()->metadata())->stride;
+    for (size_t i = 0; i < first_indices.size(); ++i) {
+      functions.copy(categories.data() + i * categories_stride, values_eval.cdata() + first_indices[i] * stride);
+    }
+    cat_tp = ndt::categorical_type::make(categories);
+  }
+  else {
+    cat_tp = ndt::factor_categorical(values_eval);
+    const ndt::categorical_type *cd = cat_tp.extended<ndt::categorical_type>();
+    for (intptr_t i = 0; i < dim_size; ++i) {
+      codes[i] = cd->get_value_from_category(el_arrmeta, values_eval.cdata() + i * stride);
+    }
+  }
+
+  array res = empty(dim_size, cat_tp);
+  intptr_t res_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(res.get()->metadata())->stride;
+  switch (cat_tp.extended<ndt::categorical_type>()->get_storage_type().get_type_id()) {
+  case uint8_type_id:
+    write_codes<uint8_t>(res.data(), res_stride, codes);
+    break;
+  case uint16_type_id:
+    write_codes<uint16_t>(res.data(), res_stride, codes);
+    break;
+  default:
+    write_codes<uint32_t>(res.data(), res_stride, codes);
+    break;
+  }
+
+  return res;
+}
+
 struct get_ints_kernel : nd::base_kernel<get_ints_kernel> {
   nd::array self;
 
@@ -542,7 +618,7 @@ struct get_ints_kernel : nd::base_kernel<get_ints_kernel> {
   static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                               const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                               const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     dst_tp = helper(kwds[0]).get_type();
   }
@@ -552,7 +628,7 @@ struct get_ints_kernel : nd::base_kernel<get_ints_kernel> {
                               intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                              const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     get_ints_kernel::make(ckb, kernreq, ckb_offset, kwds[0]);
     return ckb_offset;
@@ -608,7 +684,7 @@ void ndt::categorical_type::get_dynamic_type_properties(std::map<std::string, nd
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  const dynd::nd::array &DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<categorical_type>()->m_categories.get_type();
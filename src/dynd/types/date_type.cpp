@@ -257,7 +257,7 @@ struct strftime_kernel : nd::base_kernel<strftime_kernel> {
   static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                               const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                               const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     dst_tp = helper(kwds[0], kwds[1].as<std::string>()).get_type();
   }
@@ -267,7 +267,7 @@ struct strftime_kernel : nd::base_kernel<strftime_kernel> {
                               intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                              const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, kwds[0], kwds[1].as<std::string>());
     return ckb_offset;
@@ -302,7 +302,7 @@ struct replace_kernel : nd::base_kernel<replace_kernel> {
   static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                               const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                               const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     dst_tp = helper(kwds[0], kwds[1].is_missing() ? numeric_limits<int32_t>::max() : kwds[1].as<int32_t>(),
                     kwds[2].is_missing() ? numeric_limits<int32_t>::max() : kwds[2].as<int32_t>(),
@@ -315,7 +315,7 @@ struct replace_kernel : nd::base_kernel<replace_kernel> {
                               intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                              const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, kwds[0],
          kwds[1].is_missing() ? numeric_limits<int32_t>::max() : kwds[1].as<int32_t>(),
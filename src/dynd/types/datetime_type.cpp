@@ -44,7 +44,7 @@ struct datetime_get_struct_kernel : nd::base_kernel<datetime_get_struct_kernel,
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -67,7 +67,7 @@ struct datetime_set_struct_kernel : nd::base_kernel<datetime_set_struct_kernel,
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -104,7 +104,7 @@ struct datetime_get_date_kernel : nd::base_kernel<datetime_get_date_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -140,7 +140,7 @@ struct datetime_get_time_kernel : nd::base_kernel<datetime_get_time_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -173,7 +173,7 @@ struct datetime_get_year_kernel : nd::base_kernel<datetime_get_year_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -206,7 +206,7 @@ struct datetime_get_month_kernel : nd::base_kernel<datetime_get_month_kernel, 1>
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -239,7 +239,7 @@ struct datetime_get_day_kernel : nd::base_kernel<datetime_get_day_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -275,7 +275,7 @@ struct datetime_get_hour_kernel : nd::base_kernel<datetime_get_hour_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -311,7 +311,7 @@ struct datetime_get_minute_kernel : nd::base_kernel<datetime_get_minute_kernel,
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -347,7 +347,7 @@ struct datetime_get_second_kernel : nd::base_kernel<datetime_get_second_kernel,
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -383,7 +383,7 @@ struct datetime_get_microsecond_kernel : nd::base_kernel<datetime_get_microsecon
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
@@ -418,7 +418,7 @@ struct datetime_get_tick_kernel : nd::base_kernel<datetime_get_tick_kernel, 1> {
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
                               const nd::array *DYND_UNUSED(kwds),
-                              const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, src_tp[0]);
     return ckb_offset;
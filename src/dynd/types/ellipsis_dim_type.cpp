@@ -15,7 +15,7 @@ using namespace dynd;
 ndt::ellipsis_dim_type::ellipsis_dim_type(const std::string &name, const type &element_type)
     : base_dim_type(ellipsis_dim_type_id, pattern_kind, element_type, 0, 1, 0, type_flag_symbolic | type_flag_variadic,
                     false),
-      m_name(name)
+      m_name(name), m_symbol(name)
 {
   if (!m_name.empty()) {
     // Make sure name begins with a capital letter, and is an identifier
@@ -122,7 +122,7 @@ void ndt::ellipsis_dim_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 }
 
 bool ndt::ellipsis_dim_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                   std::map<std::string, type> &tp_vars) const
+                                   typevar_map &tp_vars) const
 {
   // TODO XXX This is wrong, "Any" could represent a type that doesn't match
   // against this one...
@@ -133,7 +133,7 @@ bool ndt::ellipsis_dim_type::match(const char *arrmeta, const type &candidate_tp
   if (candidate_tp.get_ndim() == 0) {
     const std::string &tv_name = get_name();
     if (!tv_name.empty()) {
-      type &tv_type = tp_vars[tv_name];
+      type &tv_type = tp_vars[m_symbol];
       if (tv_type.is_null()) {
         // This typevar hasn't been seen yet, make it
         // be an empty dim fragment
@@ -159,7 +159,7 @@ bool ndt::ellipsis_dim_type::match(const char *arrmeta, const type &candidate_tp
     intptr_t matched_ndim = candidate_tp.get_ndim() - get_ndim() + 1;
     const std::string &tv_name = get_name();
     if (!tv_name.empty()) {
-      type &tv_type = tp_vars[tv_name];
+      type &tv_type = tp_vars[m_symbol];
       if (tv_type.is_null()) {
         // This typevar hasn't been seen yet, so it's
         // a dim fragment of the given size.
@@ -217,7 +217,7 @@ void ndt::ellipsis_dim_type::get_dynamic_type_properties(std::map<std::string, n
     static void resolve_dst_type(char *DYND_UNUSED(static_data), size_t DYND_UNUSED(data_size), char *data,
                                  ndt::type &dst_tp, intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  const dynd::nd::array &DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = static_cast<nd::array>(tp.extended<ellipsis_dim_type>()->get_name()).get_type();
@@ -185,7 +185,7 @@ void ndt::fixed_dim_kind_type::data_destruct_strided(const char *DYND_UNUSED(arr
 }
 
 bool ndt::fixed_dim_kind_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                                     std::map<std::string, type> &tp_vars) const
+                                     typevar_map &tp_vars) const
 {
   switch (candidate_tp.get_type_id()) {
   case fixed_dim_type_id:
@@ -71,7 +71,7 @@ bool ndt::option_type::is_avail(const char *arrmeta, const char *data, const eva
     nd::callable &af = get_is_avail();
     type src_tp[1] = {type(this, true)};
     af.get()->instantiate(NULL, NULL, &ckb, 0, type::make<bool1>(), NULL, 1, src_tp, &arrmeta, kernel_request_single,
-                          ectx, 0, NULL, std::map<std::string, type>());
+                          ectx, 0, NULL, typevar_map());
     ckernel_prefix *ckp = ckb.get();
     char result;
     ckp->get_function<expr_single_t>()(ckp, &result, const_cast<char **>(&data));
@@ -124,7 +124,7 @@ void ndt::option_type::assign_na(const char *arrmeta, char *data, const eval::ev
     ckernel_builder<kernel_request_host> ckb;
     nd::callable &af = get_assign_na();
     af.get()->instantiate(NULL, NULL, &ckb, 0, type(this, true), arrmeta, 0, NULL, NULL, kernel_request_single, ectx, 0,
-                          NULL, std::map<std::string, type>());
+                          NULL, typevar_map());
     ckernel_prefix *ckp = ckb.get();
     ckp->get_function<expr_single_t>()(ckp, data, NULL);
   }
@@ -289,7 +289,7 @@ void ndt::option_type::data_destruct_strided(const char *arrmeta, char *data, in
 }
 
 bool ndt::option_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                             std::map<std::string, type> &tp_vars) const
+                             typevar_map &tp_vars) const
 {
   if (candidate_tp.get_type_id() != option_type_id) {
     return false;
@@ -322,7 +322,7 @@ nd::array ndt::pointer_type::get_option_nafunc() const
 }
 
 bool ndt::pointer_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                              std::map<std::string, type> &tp_vars) const
+                              typevar_map &tp_vars) const
 {
   if (candidate_tp.get_type_id() != pointer_type_id) {
     return false;
@@ -356,7 +356,7 @@ struct dereference_kernel : nd::base_kernel<dereference_kernel> {
   static void resolve_dst_type(char *DYND_UNUSED(static_data), char *DYND_UNUSED(data), ndt::type &dst_tp,
                                intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                intptr_t DYND_UNUSED(nkwd), const nd::array *kwds,
-                               const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                               const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     dst_tp = helper(kwds[0]).get_type();
   }
@@ -366,7 +366,7 @@ struct dereference_kernel : nd::base_kernel<dereference_kernel> {
                               intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                               const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                               const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                              const nd::array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                              const nd::array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
   {
     make(ckb, kernreq, ckb_offset, kwds[0]);
     return ckb_offset;
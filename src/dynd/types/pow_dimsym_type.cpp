@@ -17,7 +17,7 @@ ndt::pow_dimsym_type::pow_dimsym_type(const type &base_tp,
                                       const type &element_type)
     : base_dim_type(pow_dimsym_type_id, pattern_kind, element_type, 0, 1, 0,
                     type_flag_symbolic, false),
-      m_base_tp(base_tp), m_exponent(exponent)
+      m_base_tp(base_tp), m_exponent(exponent), m_exponent_symbol(exponent)
 {
   if (base_tp.is_scalar() ||
       base_tp.extended<base_dim_type>()->get_element_type().get_type_id() !=
@@ -141,7 +141,7 @@ void ndt::pow_dimsym_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 
 bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
                                  const char *candidate_arrmeta,
-                                 std::map<std::string, type> &tp_vars) const
+                                 typevar_map &tp_vars) const
 {
   if (candidate_tp.get_type_id() == typevar_constructed_type_id) {
     return candidate_tp.extended<typevar_constructed_type>()->match(
@@ -157,7 +157,7 @@ bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
           arrmeta, candidate_tp.extended<pow_dimsym_type>()->get_element_type(),
           NULL, tp_vars);
       type &tv_type =
-          tp_vars[candidate_tp.extended<pow_dimsym_type>()->get_exponent()];
+          tp_vars[candidate_tp.extended<pow_dimsym_type>()->get_exponent_symbol()];
       if (tv_type.is_null()) {
         // This typevar hasn't been seen yet
         tv_type = typevar_dim_type::make(
@@ -175,7 +175,7 @@ bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
   } else if (candidate_tp.get_ndim() == 0) {
     if (get_element_type().get_ndim() == 0) {
       // Look up to see if the exponent typevar is already matched
-      type &tv_type = tp_vars[get_exponent()];
+      type &tv_type = tp_vars[m_exponent_symbol];
       if (tv_type.is_null()) {
         // Fill in the exponent by the number of dimensions left
         tv_type = make_fixed_dim(0, type::make<void>());
@@ -196,7 +196,7 @@ bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
   }
 
   // Look up to see if the exponent typevar is already matched
-  type &tv_type = tp_vars[get_exponent()];
+  type &tv_type = tp_vars[m_exponent_symbol];
   intptr_t exponent;
   if (tv_type.is_null()) {
     // Fill in the exponent by the number of dimensions left
@@ -222,7 +222,7 @@ bool ndt::pow_dimsym_type::match(const char *arrmeta, const type &candidate_tp,
   // Get the base type
   type base_tp = get_base_type();
   if (base_tp.get_type_id() == typevar_dim_type_id) {
-    type &btv_type = tp_vars[base_tp.extended<typevar_dim_type>()->get_name()];
+    type &btv_type = tp_vars[base_tp.extended<typevar_dim_type>()->get_symbol()];
     if (btv_type.is_null()) {
       // We haven't seen this typevar yet, set it to the concrete's
       // dimension type
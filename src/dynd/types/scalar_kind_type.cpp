@@ -26,7 +26,7 @@ bool ndt::scalar_kind_type::operator==(const base_type &other) const
 bool ndt::scalar_kind_type::match(
     const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
     const char *DYND_UNUSED(candidate_arrmeta),
-    std::map<std::string, type> &DYND_UNUSED(tp_vars)) const
+    typevar_map &DYND_UNUSED(tp_vars)) const
 {
   // Match against any scalar
   return candidate_tp.is_scalar();
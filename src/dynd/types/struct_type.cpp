@@ -41,31 +41,84 @@ ndt::struct_type::struct_type(const nd::array &field_names, const nd::array &fie
 
   m_members.kind = variadic ? kind_kind : struct_kind;
 
+  create_field_index();
   create_array_properties();
 }
 
 ndt::struct_type::~struct_type() {}
 
-intptr_t ndt::struct_type::get_field_index(const char *field_name_begin, const char *field_name_end) const
+/** FNV-1a hash of a field name */
+static size_t hash_field_name(const char *begin, const char *end)
 {
-  size_t size = field_name_end - field_name_begin;
-  if (size > 0) {
-    char firstchar = *field_name_begin;
-    intptr_t field_count = get_field_count();
-    const char *fn_ptr = m_field_names.cdata();
-    intptr_t fn_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(m_field_names.get()->metadata())->stride;
-    for (intptr_t i = 0; i != field_count; ++i, fn_ptr += fn_stride) {
-      const string *fn = reinterpret_cast<const string *>(fn_ptr);
-      const char *begin = fn->begin(), *end = fn->end();
-      if ((size_t)(end - begin) == size && *begin == firstchar) {
-        if (memcmp(fn->begin(), field_name_begin, size) == 0) {
-          return i;
-        }
+  uint64_t h = 14695981039346656037ULL;
+  for (; begin != end; ++begin) {
+    h = (h ^ static_cast<unsigned char>(*begin)) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(h ^ (h >> 32));
+}
+
+void ndt::struct_type::create_field_index()
+{
+  size_t table_size = 4;
+  while (table_size < 2 * static_cast<size_t>(m_field_count)) {
+    table_size *= 2;
+  }
+  m_field_index_table.assign(table_size, -1);
+  for (intptr_t i = 0; i != m_field_count; ++i) {
+    const string &fn = get_field_name_raw(i);
+    size_t slot = hash_field_name(fn.begin(), fn.end()) & (table_size - 1);
+    while (m_field_index_table[slot] != -1) {
+      // With duplicate names, the first field keeps the name as before
+      if (field_name_equals(m_field_index_table[slot], fn.begin(), fn.end())) {
+        break;
       }
+      slot = (slot + 1) & (table_size - 1);
+    }
+    if (m_field_index_table[slot] == -1) {
+      m_field_index_table[slot] = i;
     }
   }
 
-  return -1;
+  // Until records have been seen, predict the fields in the order of the type
+  m_field_order_hints.reset(new std::atomic<intptr_t>[m_field_count + 1]);
+  for (intptr_t i = 0; i <= m_field_count; ++i) {
+    m_field_order_hints[i] = i < m_field_count ? i : -1;
+  }
+}
+
+intptr_t ndt::struct_type::get_field_index(const char *field_name_begin, const char *field_name_end) const
+{
+  if (m_field_index_table.empty()) {
+    return -1;
+  }
+
+  size_t mask = m_field_index_table.size() - 1;
+  for (size_t slot = hash_field_name(field_name_begin, field_name_end) & mask;; slot = (slot + 1) & mask) {
+    intptr_t i = m_field_index_table[slot];
+    if (i == -1 || field_name_equals(i, field_name_begin, field_name_end)) {
+      return i;
+    }
+  }
+}
+
+intptr_t ndt::struct_type::get_field_index_after(intptr_t prev_index, const char *field_name_begin,
+                                                 const char *field_name_end) const
+{
+  if (!m_field_order_hints) {
+    return get_field_index(field_name_begin, field_name_end);
+  }
+
+  std::atomic<intptr_t> &hint = m_field_order_hints[prev_index + 1];
+  intptr_t i = hint.load(std::memory_order_relaxed);
+  if (i != -1 && field_name_equals(i, field_name_begin, field_name_end)) {
+    return i;
+  }
+
+  i = get_field_index(field_name_begin, field_name_end);
+  if (i != -1) {
+    hint.store(i, std::memory_order_relaxed);
+  }
+  return i;
 }
 
 static bool is_simple_identifier_name(const char *begin, const char *end)
@@ -372,7 +425,7 @@ void ndt::struct_type::get_dynamic_type_properties(std::map<std::string, nd::cal
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<struct_type>()->m_field_types.get_type();
@@ -394,7 +447,7 @@ void ndt::struct_type::get_dynamic_type_properties(std::map<std::string, nd::cal
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<struct_type>()->m_field_names.get_type();
@@ -416,7 +469,7 @@ void ndt::struct_type::get_dynamic_type_properties(std::map<std::string, nd::cal
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  const dynd::nd::array &DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<struct_type>()->m_arrmeta_offsets.get_type();
@@ -446,7 +499,7 @@ namespace nd {
     static void resolve_dst_type(char *static_data, char *DYND_UNUSED(data), ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const array *kwds,
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       dst_tp = helper(kwds[0], *reinterpret_cast<intptr_t *>(static_data)).get_type();
     }
@@ -456,7 +509,7 @@ namespace nd {
                                 intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                 const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
                                 const eval::eval_context *DYND_UNUSED(ectx), intptr_t DYND_UNUSED(nkwd),
-                                const array *kwds, const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                const array *kwds, const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       get_array_field_kernel::make(ckb, kernreq, ckb_offset, kwds[0], *reinterpret_cast<intptr_t *>(static_data));
       return ckb_offset;
@@ -530,7 +583,7 @@ void ndt::struct_type::get_dynamic_array_properties(std::map<std::string, nd::ca
 }
 
 bool ndt::struct_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                             std::map<std::string, type> &tp_vars) const
+                             typevar_map &tp_vars) const
 {
   intptr_t candidate_field_count = candidate_tp.extended<struct_type>()->get_field_count();
   bool candidate_variadic = candidate_tp.extended<tuple_type>()->is_variadic();
@@ -507,7 +507,7 @@ void ndt::tuple_type::arrmeta_debug_print(const char *arrmeta, std::ostream &o,
 }
 
 bool ndt::tuple_type::match(const char *arrmeta, const type &candidate_tp, const char *candidate_arrmeta,
-                            std::map<std::string, type> &tp_vars) const
+                            typevar_map &tp_vars) const
 {
   intptr_t candidate_field_count = candidate_tp.extended<tuple_type>()->get_field_count();
   bool candidate_variadic = candidate_tp.extended<tuple_type>()->is_variadic();
@@ -560,7 +560,7 @@ void ndt::tuple_type::get_dynamic_type_properties(std::map<std::string, nd::call
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<tuple_type>()->m_field_types.get_type();
@@ -582,7 +582,7 @@ void ndt::tuple_type::get_dynamic_type_properties(std::map<std::string, nd::call
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = tp.extended<tuple_type>()->m_arrmeta_offsets.get_type();
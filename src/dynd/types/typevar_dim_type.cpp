@@ -12,7 +12,8 @@ using namespace std;
 using namespace dynd;
 
 ndt::typevar_dim_type::typevar_dim_type(const std::string &name, const type &element_type)
-    : base_dim_type(typevar_dim_type_id, pattern_kind, element_type, 0, 1, 0, type_flag_symbolic, false), m_name(name)
+    : base_dim_type(typevar_dim_type_id, pattern_kind, element_type, 0, 1, 0, type_flag_symbolic, false),
+      m_name(name), m_symbol(name)
 {
   if (m_name.empty()) {
     throw type_error("dynd typevar name cannot be null");
@@ -110,13 +111,13 @@ void ndt::typevar_dim_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 
 bool ndt::typevar_dim_type::match(const char *arrmeta, const type &candidate_tp,
                                   const char *DYND_UNUSED(candidate_arrmeta),
-                                  std::map<std::string, type> &tp_vars) const
+                                  typevar_map &tp_vars) const
 {
   if (candidate_tp.is_scalar()) {
     return false;
   }
 
-  type &tv_type = tp_vars[get_name()];
+  type &tv_type = tp_vars[m_symbol];
   if (tv_type.is_null()) {
     // This typevar hasn't been seen yet
     tv_type = candidate_tp;
@@ -171,7 +172,7 @@ void ndt::typevar_dim_type::get_dynamic_type_properties(std::map<std::string, nd
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       dst_tp = static_cast<nd::array>(tp.extended<typevar_dim_type>()->get_name()).get_type();
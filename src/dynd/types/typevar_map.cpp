@@ -0,0 +1,96 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <mutex>
+#include <unordered_set>
+
+#include <dynd/types/typevar_map.hpp>
+
+using namespace std;
+using namespace dynd;
+
+const std::string *ndt::typevar_symbol::intern(const std::string &name)
+{
+  // The strings are never freed, since symbols may be held by types that are
+  // destroyed during static destruction
+  static mutex *symbols_mutex = new mutex;
+  static unordered_set<std::string> *symbols = new unordered_set<std::string>;
+
+  lock_guard<mutex> lock(*symbols_mutex);
+  return &*symbols->insert(name).first;
+}
+
+ndt::typevar_map::typevar_map(const typevar_map &other)
+    : m_data(get_static_data()), m_size(0), m_capacity(static_capacity)
+{
+  reserve(other.m_size);
+  for (; m_size < other.m_size; ++m_size) {
+    new (m_data + m_size) value_type(other.m_data[m_size]);
+  }
+}
+
+ndt::typevar_map::typevar_map(typevar_map &&other) : m_data(get_static_data()), m_size(0), m_capacity(static_capacity)
+{
+  *this = std::move(other);
+}
+
+ndt::typevar_map &ndt::typevar_map::operator=(const typevar_map &rhs)
+{
+  if (this != &rhs) {
+    clear();
+    reserve(rhs.m_size);
+    for (; m_size < rhs.m_size; ++m_size) {
+      new (m_data + m_size) value_type(rhs.m_data[m_size]);
+    }
+  }
+
+  return *this;
+}
+
+ndt::typevar_map &ndt::typevar_map::operator=(typevar_map &&rhs)
+{
+  if (this == &rhs) {
+    return *this;
+  }
+
+  clear();
+  if (rhs.is_static()) {
+    for (; m_size < rhs.m_size; ++m_size) {
+      new (m_data + m_size) value_type(std::move(rhs.m_data[m_size]));
+    }
+    rhs.clear();
+  } else {
+    // Take over the heap storage of rhs
+    if (!is_static()) {
+      ::operator delete(m_data);
+    }
+    m_data = rhs.m_data;
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+    rhs.m_data = rhs.get_static_data();
+    rhs.m_size = 0;
+    rhs.m_capacity = static_capacity;
+  }
+
+  return *this;
+}
+
+void ndt::typevar_map::reserve(size_t capacity)
+{
+  if (capacity <= m_capacity) {
+    return;
+  }
+
+  value_type *data = static_cast<value_type *>(::operator new(capacity * sizeof(value_type)));
+  for (size_t i = 0; i < m_size; ++i) {
+    new (data + i) value_type(std::move(m_data[i]));
+    m_data[i].~value_type();
+  }
+  if (!is_static()) {
+    ::operator delete(m_data);
+  }
+  m_data = data;
+  m_capacity = capacity;
+}
@@ -11,7 +11,8 @@ using namespace std;
 using namespace dynd;
 
 ndt::typevar_type::typevar_type(const std::string &name)
-    : base_type(typevar_type_id, pattern_kind, 0, 1, type_flag_symbolic, 0, 0, 0), m_name(name)
+    : base_type(typevar_type_id, pattern_kind, 0, 1, type_flag_symbolic, 0, 0, 0), m_name(name),
+      m_symbol(name)
 {
   if (m_name.empty()) {
     throw type_error("dynd typevar name cannot be null");
@@ -103,7 +104,7 @@ void ndt::typevar_type::arrmeta_destruct(char *DYND_UNUSED(arrmeta)) const
 }
 
 bool ndt::typevar_type::match(const char *DYND_UNUSED(arrmeta), const type &candidate_tp,
-                              const char *DYND_UNUSED(candidate_arrmeta), std::map<std::string, type> &tp_vars) const
+                              const char *DYND_UNUSED(candidate_arrmeta), typevar_map &tp_vars) const
 {
   if (candidate_tp.get_type_id() == typevar_type_id) {
     return *this == *candidate_tp.extended();
@@ -113,7 +114,7 @@ bool ndt::typevar_type::match(const char *DYND_UNUSED(arrmeta), const type &cand
     return false;
   }
 
-  type &tv_type = tp_vars[m_name];
+  type &tv_type = tp_vars[m_symbol];
   if (tv_type.is_null()) {
     // This typevar hasn't been seen yet
     tv_type = candidate_tp;
@@ -151,7 +152,7 @@ void ndt::typevar_type::get_dynamic_type_properties(std::map<std::string, nd::ca
     static void resolve_dst_type(char *DYND_UNUSED(static_data), char *data, ndt::type &dst_tp,
                                  intptr_t DYND_UNUSED(nsrc), const ndt::type *DYND_UNUSED(src_tp),
                                  intptr_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
-                                 const std::map<std::string, ndt::type> &DYND_UNUSED(tp_vars))
+                                 const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       const type &tp = *reinterpret_cast<const ndt::type *>(data);
       const nd::array &a = tp.extended<typevar_type>()->get_name();
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "inc_gtest.hpp"
 #include "../test_memory.hpp"
@@ -695,6 +696,49 @@ TEST(Array, PrintBoolVector)
   EXPECT_EQ("array([True, True, True],\n      type=\"3 * bool\")", ss.str());
 }
 
+TEST(Array, DataAlignment)
+{
+  // Small data stays in the array memory block
+  nd::array a = nd::empty(3, ndt::type::make<int>());
+  EXPECT_TRUE(a.get()->owner.get() == NULL);
+
+  // Larger data is allocated apart, on a cache line
+  a = nd::empty(1000, ndt::type::make<double>());
+  EXPECT_TRUE(a.get()->owner.get() != NULL);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.cdata()) % 64);
+  a.vals() = 1.5;
+  EXPECT_EQ(1.5, a(999).as<double>());
+  a.flag_as_immutable();
+  EXPECT_EQ(nd::read_access_flag | nd::immutable_access_flag, a.get_flags());
+
+  // Data which needs destruction is never separated
+  a = nd::empty(100, ndt::string_type::make());
+  EXPECT_TRUE(a.get()->owner.get() == NULL);
+
+  eval::eval_context ectx;
+  ectx.data_alignment = 4096;
+  ectx.huge_page_threshold = 0;
+  intptr_t shape[2] = {10, 20};
+  a = nd::make_strided_array(ndt::type::make<float>(), 2, shape, nd::read_access_flag | nd::write_access_flag, NULL,
+                             &ectx);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.cdata()) % 4096);
+
+  // Data on huge pages
+  ectx.huge_page_threshold = 1;
+  a = nd::make_strided_array(ndt::type::make<float>(), 2, shape, nd::read_access_flag | nd::write_access_flag, NULL,
+                             &ectx);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(a.cdata()) % 4096);
+  a.vals() = 2.5f;
+  EXPECT_EQ(2.5f, a(9, 19).as<float>());
+
+  // The settings of the default evaluation context apply globally
+  eval::eval_context saved = eval::default_eval_context;
+  eval::default_eval_context.separate_data_threshold = numeric_limits<intptr_t>::max();
+  a = nd::empty(1000, ndt::type::make<double>());
+  EXPECT_TRUE(a.get()->owner.get() == NULL);
+  eval::default_eval_context = saved;
+}
+
 REGISTER_TYPED_TEST_CASE_P(Array, ScalarConstructor, OneDimConstructor, TwoDimConstructor, ThreeDimConstructor,
                            AsScalar);
 
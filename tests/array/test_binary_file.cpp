@@ -0,0 +1,107 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <iterator>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/binary_file.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(BinaryFile, Strided)
+{
+  nd::array a = parse_json("2 * 3 * float64", "[[1.5, 2, 3], [4, 5, 6.25]]");
+  nd::save_binary("test_binary_file.dynd", a);
+
+  nd::array b = nd::load_mmap("test_binary_file.dynd", nd::read_access_flag | nd::immutable_access_flag,
+                              memmap_advice_sequential);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_ARRAY_EQ(a, b);
+  // The data is the mapping, aligned in it
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b.cdata()) % 64);
+  EXPECT_EQ(nd::read_access_flag | nd::immutable_access_flag, b.get_flags());
+
+  // A view with other strides is written in C order
+  nd::array c = a(irange(), irange().by(-1));
+  nd::save_binary("test_binary_file.dynd", c);
+  b = nd::load_mmap("test_binary_file.dynd");
+  EXPECT_ARRAY_EQ(c, b);
+  EXPECT_EQ(8 * 3, reinterpret_cast<const fixed_dim_type_arrmeta *>(b.get()->metadata())->stride);
+
+  b = nd::array();
+  remove("test_binary_file.dynd");
+}
+
+TEST(BinaryFile, Struct)
+{
+  nd::array a = parse_json("3 * {x: int32, y: float64, z: 2 * int8}",
+                           "[[1, 2.5, [3, 4]], [5, 6.5, [7, 8]], [9, 10.5, [11, 12]]]");
+  nd::save_binary("test_binary_file.dynd", a);
+
+  nd::array b = nd::load_mmap("test_binary_file.dynd");
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(b).as<std::string>());
+
+  b = nd::array();
+  remove("test_binary_file.dynd");
+}
+
+TEST(BinaryFile, Scalar)
+{
+  nd::save_binary("test_binary_file.dynd", 3.25);
+  EXPECT_ARRAY_EQ(3.25, nd::load_mmap("test_binary_file.dynd"));
+  remove("test_binary_file.dynd");
+}
+
+TEST(BinaryFile, Write)
+{
+  nd::save_binary("test_binary_file.dynd", parse_json("3 * int32", "[1, 2, 3]"));
+  {
+    nd::array b = nd::load_mmap("test_binary_file.dynd", nd::read_access_flag | nd::write_access_flag);
+    b(1).vals() = 20;
+  }
+
+  EXPECT_ARRAY_EQ(parse_json("3 * int32", "[1, 20, 3]"), nd::load_mmap("test_binary_file.dynd"));
+  remove("test_binary_file.dynd");
+}
+
+TEST(BinaryFile, Errors)
+{
+  // Types which point to other memory can't be saved
+  EXPECT_THROW(nd::save_binary("test_binary_file.dynd", parse_json("2 * string", "[\"a\", \"b\"]")), type_error);
+  EXPECT_THROW(nd::save_binary("test_binary_file.dynd", parse_json("var * int32", "[1, 2]")), type_error);
+
+  {
+    ofstream f("test_binary_file.dynd", ios::binary);
+    f << "not a dynd binary file, but long enough to have a header";
+  }
+  EXPECT_THROW(nd::load_mmap("test_binary_file.dynd"), runtime_error);
+
+  // A truncated file
+  nd::save_binary("test_binary_file.dynd", parse_json("3 * int32", "[1, 2, 3]"));
+  std::string contents;
+  {
+    ifstream f("test_binary_file.dynd", ios::binary);
+    contents.assign(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+  }
+  {
+    ofstream f("test_binary_file.dynd", ios::binary | ios::trunc);
+    f.write(contents.data(), contents.size() - 4);
+  }
+  EXPECT_THROW(nd::load_mmap("test_binary_file.dynd"), runtime_error);
+
+  remove("test_binary_file.dynd");
+}
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <sstream>
 
 #include "inc_gtest.hpp"
 
@@ -93,3 +95,76 @@ TEST(JSONFormatter, UniformDim)
   a = parse_json("var * ?real", "[1.5, null, 3.125, 9.25, null, null]");
   EXPECT_EQ("[1.5,null,3.125,9.25,null,null]", format_json(a).as<std::string>());
 }
+
+TEST(JSONFormatter, Sink)
+{
+  std::string long_name(100, 'x');
+  std::string json = "[{\"name\": \"first\", \"values\": [1, 2.5, -3], \"flag\": true},"
+                     " {\"name\": \"" + long_name + "\", \"values\": [0.1, 1e100, 7], \"flag\": null},"
+                     " {\"name\": \"\", \"values\": [0, 0, 0], \"flag\": false},"
+                     " {\"name\": \"last\", \"values\": [4, 5, 6], \"flag\": true}]";
+  nd::array a = parse_json(ndt::type("4 * {name: string, values: 3 * float64, flag: ?bool}"), json.c_str());
+  std::string expected = format_json(a).as<std::string>();
+
+  // Every chunk fits the buffer, which is at least 64 bytes
+  for (intptr_t buffer_size : {1, 64, 80, 65536}) {
+    std::string out;
+    intptr_t chunk_count = 0;
+    json_callback_sink sink([&](const char *begin, const char *end) {
+      EXPECT_LE(end - begin, std::max<intptr_t>(buffer_size, 64));
+      out.append(begin, end);
+      ++chunk_count;
+    });
+    format_json(a, sink, false, buffer_size);
+    EXPECT_EQ(expected, out);
+    if (buffer_size == 65536) {
+      EXPECT_EQ(1, chunk_count);
+    } else {
+      EXPECT_LT(1, chunk_count);
+    }
+  }
+
+  std::ostringstream ss;
+  json_ostream_sink os_sink(ss);
+  format_json(a, os_sink, true, 32);
+  EXPECT_EQ(format_json(a, true).as<std::string>(), ss.str());
+
+  EXPECT_THROW(format_json(a, os_sink, false, 0), invalid_argument);
+}
+
+TEST(JSONFormatter, Lines)
+{
+  nd::array a = parse_json("var * {a: int32, b: string}", "[{\"a\": 1, \"b\": \"x\"}, {\"a\": 2, \"b\": \"y\\nz\"},"
+                                                           " {\"a\": 3, \"b\": \"\"}]");
+  std::ostringstream ss;
+  json_ostream_sink sink(ss);
+  format_json_lines(a, sink, false, 8);
+  EXPECT_EQ("{\"a\":1,\"b\":\"x\"}\n{\"a\":2,\"b\":\"y\\nz\"}\n{\"a\":3,\"b\":\"\"}\n", ss.str());
+
+  // The lines parse back to the same records
+  nd::array b = nd::json::parse_lines(a.get_type().extended<ndt::var_dim_type>()->get_element_type(), ss.str());
+  ASSERT_EQ(3, b.get_dim_size());
+  EXPECT_EQ(2, b(1, 0).as<int32_t>());
+  EXPECT_EQ("y\nz", b(1, 1).as<std::string>());
+
+  // An empty dimension writes nothing, and a scalar has no lines
+  std::ostringstream empty_ss;
+  json_ostream_sink empty_sink(empty_ss);
+  format_json_lines(parse_json("0 * int32", "[]"), empty_sink);
+  EXPECT_EQ("", empty_ss.str());
+  EXPECT_THROW(format_json_lines(nd::array(1), empty_sink), invalid_argument);
+}
+
+TEST(JSONFormatter, FdSink)
+{
+  FILE *f = tmpfile();
+  ASSERT_TRUE(f != NULL);
+  json_fd_sink sink(fileno(f));
+  nd::array a = parse_json("3 * int64", "[1, -2, 30000000000]");
+  format_json(a, sink, false, 4);
+  rewind(f);
+  char buffer[64];
+  size_t size = fread(buffer, 1, sizeof(buffer), f);
+  fclose(f);
+  EXPECT_EQ("[1,-2,30000000000]", std::string(buffer, size));
+}
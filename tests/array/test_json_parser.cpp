@@ -7,12 +7,16 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <random>
 
 #include "inc_gtest.hpp"
 #include "../dynd_assertions.hpp"
 
 #include <dynd/view.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/json_structural_index.hpp>
+#include <dynd/parser_util.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 #include <dynd/func/callable.hpp>
 #include <dynd/types/var_dim_type.hpp>
 #include <dynd/types/fixed_dim_type.hpp>
@@ -554,3 +558,193 @@ TEST(JSONParser, ListOfStruct)
                                "\"data\":{ \"when\":\"2013-12-25\", \"name\":\"Frank\"}}]"),
                invalid_argument);
 }
+
+TEST(JSONParser, Lines)
+{
+  ndt::type tp = ndt::struct_type::make({"id", "name"}, {ndt::type::make<int32_t>(), ndt::string_type::make()});
+
+  nd::array a = nd::json::parse_lines(tp, "{\"id\": 1, \"name\": \"one\"}\n"
+                                          "\n"
+                                          "  {\"name\": \"two\", \"id\": 2}  \r\n"
+                                          "{\"id\": 3, \"name\": \"three\"}");
+  EXPECT_EQ(ndt::var_dim_type::make(tp), a.get_type());
+  ASSERT_EQ(3, a.get_dim_size());
+  EXPECT_EQ(1, a(0, 0).as<int32_t>());
+  EXPECT_EQ("one", a(0, 1).as<std::string>());
+  EXPECT_EQ(2, a(1, 0).as<int32_t>());
+  EXPECT_EQ("two", a(1, 1).as<std::string>());
+  EXPECT_EQ(3, a(2, 0).as<int32_t>());
+  EXPECT_EQ("three", a(2, 1).as<std::string>());
+
+  // Nested var dims are parsed on the calling thread
+  a = nd::json::parse_lines(ndt::var_dim_type::make(ndt::type::make<int>()), "[1, 2]\n[]\n[3]\n", 4);
+  ASSERT_EQ(3, a.get_dim_size());
+  EXPECT_EQ(2, a(0).get_dim_size());
+  EXPECT_EQ(2, a(0, 1).as<int>());
+  EXPECT_EQ(0, a(1).get_dim_size());
+  EXPECT_EQ(3, a(2, 0).as<int>());
+
+  EXPECT_EQ(0, nd::json::parse_lines(tp, "\n \n").get_dim_size());
+
+  // Only one value is allowed per line
+  EXPECT_THROW(nd::json::parse_lines(ndt::type::make<int>(), "1 2\n3\n"), invalid_argument);
+}
+
+TEST(JSONParser, LinesParallel)
+{
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.min_grain_size = 64;
+
+  ndt::type tp = ndt::struct_type::make({"id", "name"}, {ndt::type::make<int64_t>(), ndt::string_type::make()});
+  std::string json;
+  for (int i = 0; i < 10000; ++i) {
+    json += "{\"id\": " + std::to_string(i) + ", \"name\": \"n" + std::to_string(i % 17) + "\"}\n";
+    if (i % 100 == 0) {
+      json += "\n";
+    }
+  }
+
+  nd::array a = nd::json::parse_lines(tp, json, 4);
+  ASSERT_EQ(10000, a.get_dim_size());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(i, a(i, 0).as<int64_t>());
+    ASSERT_EQ("n" + std::to_string(i % 17), a(i, 1).as<std::string>());
+  }
+
+  // Errors report the line number within the whole buffer
+  json += "{\"id\": 1, \"name\": 2}\n";
+  try
+  {
+    nd::json::parse_lines(tp, json, 4);
+    FAIL() << "expected a parse error";
+  }
+  catch (const invalid_argument &e)
+  {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find("line 10101,"));
+  }
+
+  eval::default_eval_context = saved_ectx;
+}
+
+// The structural characters outside of strings and the opening quotes,
+// found one byte at a time
+static vector<intptr_t> reference_structural_index(const std::string &json)
+{
+  vector<intptr_t> result;
+  bool in_string = false, escaped = false;
+  for (size_t i = 0; i < json.size(); ++i) {
+    char c = json[i];
+    if (escaped) {
+      escaped = false;
+      if (c == '"') {
+        continue;
+      }
+    } else if (c == '\\') {
+      escaped = true;
+      continue;
+    }
+    if (c == '"') {
+      if (!in_string) {
+        result.push_back(i);
+      }
+      in_string = !in_string;
+    } else if (!in_string && strchr("{}[]:,", c) != NULL) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+TEST(JSONStructuralIndex, Random)
+{
+  simd_level_t saved_level = get_simd_level();
+
+  // Lots of backslashes and quotes, so that escapes and strings cross the
+  // 64-byte block boundaries in every way
+  const char alphabet[] = "\"\\\\{}[]:, ab";
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> char_dist(0, sizeof(alphabet) - 2);
+  std::uniform_int_distribution<int> size_dist(0, 300);
+  for (int level = simd_level_none; level <= get_max_simd_level(); ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+    for (int i = 0; i < 500; ++i) {
+      std::string json(size_dist(gen), ' ');
+      for (size_t j = 0; j < json.size(); ++j) {
+        json[j] = alphabet[char_dist(gen)];
+      }
+      vector<intptr_t> index;
+      parse::build_json_structural_index(json.data(), json.data() + json.size(), index);
+      ASSERT_EQ(reference_structural_index(json), index) << "simd level " << level << ", input " << json;
+    }
+  }
+
+  set_simd_level(saved_level);
+}
+
+TEST(JSONStructuralIndex, SkipContainer)
+{
+  simd_level_t saved_level = get_simd_level();
+
+  for (int level = simd_level_none; level <= get_max_simd_level(); ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+
+    std::string json = "{\"a\": [1, {\"b]\": \"}\\\"}\"}], \"c\": \"\\\\\"} , 5";
+    const char *end = parse::skip_json_container(json.data(), json.data() + json.size());
+    EXPECT_EQ(" , 5", std::string(end, json.data() + json.size()));
+
+    // Brackets nested across several blocks
+    json = std::string(100, '[') + std::string(50, ' ') + "\"]]]\"" + std::string(100, ']') + "]";
+    end = parse::skip_json_container(json.data(), json.data() + json.size());
+    EXPECT_EQ("]", std::string(end, json.data() + json.size()));
+
+    json = "[[1, 2], \"]\"";
+    EXPECT_THROW(parse::skip_json_container(json.data(), json.data() + json.size()), parse::parse_error);
+  }
+
+  set_simd_level(saved_level);
+}
+
+TEST(JSONParser, SkipUnknownFields)
+{
+  ndt::type tp = ndt::struct_type::make({"id", "name"}, {ndt::type::make<int32_t>(), ndt::string_type::make()});
+
+  nd::array a = parse_json(tp, "{\"extra\": {\"x\": [1, 2, {\"y\": \"}]\\\"\"}], \"z\": null},"
+                               " \"id\": 7, \"more\": [[], [[]]], \"name\": \"a \\\"b\\\" c\"}");
+  EXPECT_EQ(7, a(0).as<int32_t>());
+  EXPECT_EQ("a \"b\" c", a(1).as<std::string>());
+
+  // A long string with an escape past the first 16 bytes
+  a = parse_json(tp, "{\"id\": 1, \"name\": \"abcdefghijklmnopqrstuvwxyz\\tABCDEFGHIJKLMNOPQRSTUVWXYZ\"}");
+  EXPECT_EQ("abcdefghijklmnopqrstuvwxyz\tABCDEFGHIJKLMNOPQRSTUVWXYZ", a(1).as<std::string>());
+
+  EXPECT_THROW(parse_json(tp, "{\"id\": 1, \"name\": \"x\", \"extra\": [1, [2]"), invalid_argument);
+
+  // Skipped fields must still be valid JSON
+  EXPECT_THROW(parse_json(tp, "{\"id\": 1, \"junk\": [1,,}], \"name\": \"x\"}"), invalid_argument);
+  EXPECT_THROW(parse_json(tp, "{\"id\": 1, \"junk\": {\"a\" 1}, \"name\": \"x\"}"), invalid_argument);
+  EXPECT_THROW(parse_json(tp, "{\"id\": 1, \"junk\": [tru], \"name\": \"x\"}"), invalid_argument);
+}
+
+TEST(JSONParser, StructFieldOrder)
+{
+  ndt::type tp = ndt::struct_type::make({"a", "b", "c"}, {ndt::type::make<int32_t>(), ndt::type::make<int32_t>(),
+                                                          ndt::option_type::make(ndt::type::make<int32_t>())});
+
+  // Records in the type's order, in one fixed different order, and in a
+  // mixture of orders with missing and unknown fields
+  nd::array a = nd::json::parse_lines(tp, "{\"a\": 1, \"b\": 2, \"c\": 3}\n"
+                                          "{\"c\": 6, \"b\": 5, \"a\": 4}\n"
+                                          "{\"c\": 9, \"b\": 8, \"a\": 7}\n"
+                                          "{\"b\": 11, \"x\": 0, \"a\": 10}\n"
+                                          "{\"a\": 13, \"c\": 15, \"b\": 14}\n");
+  ASSERT_EQ(5, a.get_dim_size());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(3 * i + 1, a(i, 0).as<int32_t>());
+    EXPECT_EQ(3 * i + 2, a(i, 1).as<int32_t>());
+    if (i != 3) {
+      EXPECT_EQ(3 * i + 3, a(i, 2).as<int32_t>());
+    } else {
+      EXPECT_TRUE(a(i, 2).is_missing());
+    }
+  }
+}
@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdlib>
+#include <thread>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/memblock/memory_allocator.hpp>
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+int counting_allocations = 0, counting_deallocations = 0;
+
+void *counting_allocate(size_t size)
+{
+  ++counting_allocations;
+  return malloc(size);
+}
+
+void counting_deallocate(void *ptr, size_t DYND_UNUSED(size))
+{
+  ++counting_deallocations;
+  free(ptr);
+}
+
+memory_allocator counting_allocator = {&counting_allocate, &counting_deallocate};
+
+} // anonymous namespace
+
+TEST(MemoryAllocator, Default) { EXPECT_EQ(get_pool_memory_allocator(), get_memory_allocator()); }
+
+TEST(MemoryAllocator, PoolReusesScalars)
+{
+  // Warm up the free lists, and the callables which are initialized on first use
+  {
+    nd::array a = 1;
+    nd::array b = nd::add(a, 1);
+    EXPECT_ARRAY_EQ(2, b);
+  }
+
+  memory_allocator_stats before = get_memory_allocator_stats();
+  for (int i = 0; i < 100; ++i) {
+    nd::array a = i;
+    nd::array b = nd::add(a, 1);
+    EXPECT_ARRAY_EQ(i + 1, b);
+  }
+  memory_allocator_stats after = get_memory_allocator_stats();
+
+  EXPECT_EQ(after.allocations - before.allocations, after.deallocations - before.deallocations);
+  EXPECT_LE(100u, after.allocations - before.allocations);
+  // Nearly all of the blocks come from the free lists
+  EXPECT_LE(after.allocations - before.allocations - 10, after.pool_allocations - before.pool_allocations);
+  EXPECT_GE(10u, after.system_allocations - before.system_allocations);
+}
+
+TEST(MemoryAllocator, LargeBlocks)
+{
+  // Warm up the free list of the size class of the array memory block
+  {
+    nd::array a = nd::empty(1 << 16, ndt::type::make<double>());
+  }
+
+  memory_allocator_stats before = get_memory_allocator_stats();
+  {
+    nd::array a = nd::empty(1 << 16, ndt::type::make<double>());
+  }
+  memory_allocator_stats after = get_memory_allocator_stats();
+
+  // Large blocks are never kept in the free lists
+  EXPECT_EQ(1u, after.system_allocations - before.system_allocations);
+  EXPECT_EQ(1u, after.system_deallocations - before.system_deallocations);
+  EXPECT_EQ(before.cached_bytes, after.cached_bytes);
+}
+
+TEST(MemoryAllocator, Custom)
+{
+  counting_allocations = 0;
+  counting_deallocations = 0;
+
+  set_memory_allocator(&counting_allocator);
+  EXPECT_EQ(&counting_allocator, get_memory_allocator());
+  nd::array a = 1.5;
+  nd::array b = nd::empty(3, ndt::type::make<int>());
+  set_memory_allocator(NULL);
+  EXPECT_EQ(get_pool_memory_allocator(), get_memory_allocator());
+
+  EXPECT_EQ(2, counting_allocations);
+  EXPECT_EQ(0, counting_deallocations);
+
+  // Blocks are freed by the allocator which allocated them
+  a = nd::array();
+  b = nd::array();
+  EXPECT_EQ(2, counting_allocations);
+  EXPECT_EQ(2, counting_deallocations);
+}
+
+TEST(MemoryAllocator, Threads)
+{
+  memory_allocator_stats before = get_memory_allocator_stats();
+
+  size_t thread_allocations = 0;
+  thread t([&thread_allocations]() {
+    for (int i = 0; i < 10; ++i) {
+      nd::array a = i;
+    }
+    thread_allocations = get_memory_allocator_stats().allocations;
+  });
+  t.join();
+
+  // The counters of other threads are separate
+  EXPECT_EQ(10u, thread_allocations);
+  EXPECT_EQ(before.allocations, get_memory_allocator_stats().allocations);
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/binary_file.hpp>
+#include <dynd/exceptions.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/serialize.hpp>
+#include <dynd/types/bytes_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Serialize, POD)
+{
+  nd::array a = parse_json("2 * 3 * float64", "[[1.5, 2, 3], [4, 5, 6.25]]");
+  nd::array buffer = nd::serialize(a);
+  EXPECT_EQ(ndt::type::make<uint8_t>(), buffer.get_dtype());
+
+  nd::array b = nd::deserialize(buffer);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_ARRAY_EQ(a, b);
+  EXPECT_EQ(nd::read_access_flag | nd::immutable_access_flag, b.get_flags());
+
+  // A view with other strides is written in C order
+  nd::array c = a(irange(), irange().by(-1));
+  EXPECT_ARRAY_EQ(c, nd::deserialize(nd::serialize(c)));
+
+  EXPECT_ARRAY_EQ(3.25, nd::deserialize(nd::serialize(3.25)));
+}
+
+TEST(Serialize, String)
+{
+  nd::array a = parse_json("3 * string", "[\"short\", \"a string too long to be stored inline\", \"\"]");
+  nd::array buffer = nd::serialize(a);
+  nd::array b = nd::deserialize(buffer);
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_ARRAY_EQ(a, b);
+
+  // The long string is a view into the copy of the buffer
+  const dynd::string *s = reinterpret_cast<const dynd::string *>(b(1).cdata());
+  EXPECT_FALSE(s->is_inline());
+  EXPECT_TRUE(s->is_borrowed());
+  EXPECT_TRUE(s->data() > b.cdata());
+}
+
+TEST(Serialize, VarDim)
+{
+  nd::array a = parse_json("3 * var * {name: string, values: var * int32, weight: ?float64}",
+                           "[[{\"name\": \"first item in the first row\", \"values\": [1, 2, 3], \"weight\": 1.5}],"
+                           " [],"
+                           " [{\"name\": \"x\", \"values\": [], \"weight\": null},"
+                           "  {\"name\": \"the last item of the last row\", \"values\": [4, 5], \"weight\": 2}]]");
+  nd::array b = nd::deserialize(nd::serialize(a));
+  EXPECT_EQ(a.get_type(), b.get_type());
+  EXPECT_EQ(format_json(a).as<std::string>(), format_json(b).as<std::string>());
+
+  nd::array c = nd::empty(ndt::bytes_type::make());
+  reinterpret_cast<bytes *>(c.data())->assign("some bytes which do not fit inline", 34);
+  nd::array d = nd::deserialize(nd::serialize(c));
+  EXPECT_EQ(c.get_type(), d.get_type());
+  const bytes *db = reinterpret_cast<const bytes *>(d.cdata());
+  EXPECT_EQ(std::string("some bytes which do not fit inline"), std::string(db->data(), db->size()));
+}
+
+TEST(Serialize, InPlace)
+{
+  nd::array a = parse_json("2 * string", "[\"a string too long to be stored inline\", \"and another one\"]");
+  nd::array buffer = nd::serialize(a);
+
+  nd::array b = nd::deserialize(buffer, nd::deserialize_in_place);
+  EXPECT_ARRAY_EQ(a, b);
+  EXPECT_EQ(nd::read_access_flag, b.get_flags());
+  // The strings are views into the buffer
+  const dynd::string *s = reinterpret_cast<const dynd::string *>(b(0).cdata());
+  EXPECT_TRUE(s->data() > buffer.cdata() && s->data() < buffer.cdata() + buffer.get_dim_size());
+
+  // The buffer is already relocated for its address, so reading it again works
+  EXPECT_ARRAY_EQ(a, nd::deserialize(buffer, nd::deserialize_in_place));
+  // A copy is relocated again
+  EXPECT_ARRAY_EQ(a, nd::deserialize(buffer));
+  b = nd::array();
+  EXPECT_ARRAY_EQ(a, nd::deserialize(buffer.eval_copy()));
+}
+
+TEST(Serialize, Mmap)
+{
+  nd::array a = parse_json("3 * string", "[\"short\", \"a string too long to be stored inline\", \"\"]");
+  nd::array buffer = nd::serialize(a);
+  {
+    ofstream f("test_serialize.dynd", ios::binary);
+    f.write(buffer.cdata(), buffer.get_dim_size());
+  }
+
+  nd::array b = nd::deserialize_mmap("test_serialize.dynd");
+  EXPECT_ARRAY_EQ(a, b);
+  b = nd::array();
+
+  // The file isn't modified by reading it, so it reads the same again
+  EXPECT_ARRAY_EQ(a, nd::deserialize_mmap("test_serialize.dynd"));
+  remove("test_serialize.dynd");
+}
+
+TEST(Serialize, Errors)
+{
+  EXPECT_THROW(nd::deserialize(parse_json("3 * int32", "[1, 2, 3]")), type_error);
+
+  nd::array buffer = nd::serialize(parse_json("2 * string", "[\"a string too long to be stored inline\", \"b\"]"));
+  EXPECT_THROW(nd::deserialize(buffer(irange() < 20)), runtime_error);
+
+  // A string which points outside of the buffer
+  nd::array corrupt = buffer.eval_copy();
+  const serialize_header *header = reinterpret_cast<const serialize_header *>(corrupt.cdata());
+  reinterpret_cast<size_t *>(corrupt.data() + header->data_offset)[0] += 1000;
+  EXPECT_THROW(nd::deserialize(corrupt), runtime_error);
+
+  // Read in place, a corrupt buffer is left as it was, with the valid first string not relocated
+  nd::array a = parse_json("2 * string", "[\"a string too long to be stored inline\", \"and another long string\"]");
+  corrupt = nd::serialize(a).eval_copy();
+  header = reinterpret_cast<const serialize_header *>(corrupt.cdata());
+  reinterpret_cast<size_t *>(corrupt.data() + header->data_offset)[2] += 1000;
+  std::vector<char> before(corrupt.cdata(), corrupt.cdata() + corrupt.get_dim_size());
+  EXPECT_THROW(nd::deserialize(corrupt, nd::deserialize_in_place), runtime_error);
+  EXPECT_TRUE(std::equal(before.begin(), before.end(), corrupt.cdata()));
+}
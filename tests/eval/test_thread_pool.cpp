@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "inc_gtest.hpp"
+
+#include <dynd/eval/thread_pool.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(ThreadPool, ParallelFor)
+{
+  eval::thread_pool pool(4);
+  EXPECT_EQ(4, pool.get_num_threads());
+
+  // Every index is visited exactly once, by a worker in range
+  const intptr_t size = 100003;
+  vector<atomic<int>> visits(size);
+  for (intptr_t i = 0; i < size; ++i) {
+    visits[i] = 0;
+  }
+  atomic<bool> bad_worker(false);
+  pool.parallel_for(4, size, 1000, [&](int worker, intptr_t begin, intptr_t end) {
+    if (worker < 0 || worker >= 4) {
+      bad_worker = true;
+    }
+    for (intptr_t i = begin; i < end; ++i) {
+      ++visits[i];
+    }
+  });
+  EXPECT_FALSE(bad_worker);
+  for (intptr_t i = 0; i < size; ++i) {
+    EXPECT_EQ(1, visits[i]) << "index " << i;
+  }
+
+  // A range smaller than two grains runs in one call on the calling thread
+  int calls = 0;
+  pool.parallel_for(4, 1500, 1000, [&](int worker, intptr_t begin, intptr_t end) {
+    EXPECT_EQ(0, worker);
+    EXPECT_EQ(0, begin);
+    EXPECT_EQ(1500, end);
+    ++calls;
+  });
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ThreadPool, Nested)
+{
+  eval::thread_pool pool(3);
+  atomic<intptr_t> total(0);
+  pool.parallel_for(3, 30, 1, [&](int, intptr_t begin, intptr_t end) {
+    for (intptr_t i = begin; i < end; ++i) {
+      pool.parallel_for(3, 10, 1, [&](int, intptr_t inner_begin, intptr_t inner_end) {
+        total += inner_end - inner_begin;
+      });
+    }
+  });
+  EXPECT_EQ(300, total);
+}
+
+TEST(ThreadPool, Exception)
+{
+  eval::thread_pool pool(4);
+  EXPECT_THROW(pool.parallel_for(4, 1000, 10,
+                                 [](int, intptr_t begin, intptr_t end) {
+                                   if (begin <= 500 && 500 < end) {
+                                     throw runtime_error("chunk failed");
+                                   }
+                                 }),
+               runtime_error);
+
+  // The pool is still usable afterwards
+  atomic<intptr_t> total(0);
+  pool.parallel_for(4, 1000, 10, [&](int, intptr_t begin, intptr_t end) { total += end - begin; });
+  EXPECT_EQ(1000, total);
+}
@@ -20,6 +20,8 @@
 
 #include <dynd/types/option_type.hpp>
 #include <dynd/kernels/arithmetic.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
+#include <dynd/callables/ckernel_cache.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -470,6 +472,50 @@ TEST(Arithmetic, OptionArrayNotOptionFloat64)
   }
 }
 
+TEST(Arithmetic, Contiguous)
+{
+  // An odd length, so the vectorized loops also have a remainder to handle
+  const int n = 1003;
+  nd::array a = nd::empty(n, ndt::type::make<double>());
+  nd::array b = nd::empty(n, ndt::type::make<double>());
+  nd::array c = nd::empty(n, ndt::type::make<int8_t>());
+  nd::array d = nd::empty(n, ndt::type::make<int8_t>());
+  for (int i = 0; i < n; ++i) {
+    reinterpret_cast<double *>(a.data())[i] = 0.5 * i;
+    reinterpret_cast<double *>(b.data())[i] = 3.0 - i;
+    reinterpret_cast<int8_t *>(c.data())[i] = static_cast<int8_t>(i);
+    reinterpret_cast<int8_t *>(d.data())[i] = static_cast<int8_t>(7 * i);
+  }
+
+  simd_level_t max_level = get_max_simd_level();
+  for (int level = simd_level_none; level <= max_level; ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+    nd::get_ckernel_cache().clear();
+
+    nd::array sum = a + b, difference = a - b, product = a * b, quotient = a / b;
+    nd::array int_sum = c + d, int_product = c * d;
+    EXPECT_EQ(ndt::make_fixed_dim(n, ndt::type::make<int>()), int_sum.get_type());
+    for (int i = 0; i < n; ++i) {
+      double x = 0.5 * i, y = 3.0 - i;
+      EXPECT_EQ(x + y, sum(i).as<double>());
+      EXPECT_EQ(x - y, difference(i).as<double>());
+      EXPECT_EQ(x * y, product(i).as<double>());
+      EXPECT_EQ(x / y, quotient(i).as<double>());
+      int8_t u = static_cast<int8_t>(i), v = static_cast<int8_t>(7 * i);
+      EXPECT_EQ(u + v, int_sum(i).as<int>());
+      EXPECT_EQ(u * v, int_product(i).as<int>());
+    }
+
+    // Strided views take the scalar loop
+    nd::array strided_sum = a(irange().by(2)) + b(irange().by(2));
+    for (int i = 0; i < n; i += 2) {
+      EXPECT_EQ(0.5 * i + (3.0 - i), strided_sum(i / 2).as<double>());
+    }
+  }
+  set_simd_level(max_level);
+  nd::get_ckernel_cache().clear();
+}
+
 REGISTER_TYPED_TEST_CASE_P(Arithmetic, SimpleBroadcast, StridedScalarBroadcast,
                            ScalarOnTheRight, ScalarOnTheLeft, ComplexScalar);
 
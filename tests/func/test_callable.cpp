@@ -14,6 +14,7 @@
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/date_type.hpp>
 #include <dynd/func/callable.hpp>
+#include <dynd/callables/ckernel_cache.hpp>
 #include <dynd/func/apply.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
 #include <dynd/kernels/expr_kernel_generator.hpp>
@@ -50,7 +51,7 @@ TEST(Callable, Assignment)
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_single, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        ndt::typevar_map());
   int int_out = 0;
   char str_in[16] = "3251";
   const char *str_in_ptr = str_in;
@@ -63,7 +64,7 @@ TEST(Callable, Assignment)
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_strided, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        ndt::typevar_map());
   int ints_out[3] = {0, 0, 0};
   char strs_in[3][16] = {"123", "4567", "891029"};
   const char *strs_in_ptr = strs_in[0];
@@ -129,6 +130,73 @@ TEST(Callable, CallOperator)
   EXPECT_THROW(f(kwds("y", 3.5)), invalid_argument);
 }
 
+TEST(Callable, KernelCache)
+{
+  nd::ckernel_cache &cache = nd::get_ckernel_cache();
+  cache.clear();
+  cache.reset_stats();
+
+  nd::callable f = nd::functional::apply([](int x, int y) { return x - y; });
+  nd::array a = f(3, 7);
+  EXPECT_EQ(0u, cache.get_hits());
+  EXPECT_EQ(1u, cache.get_misses());
+  nd::array b = f(12, 7);
+  EXPECT_EQ(1u, cache.get_hits());
+  EXPECT_EQ(1u, cache.get_misses());
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(-4, a.as<int>());
+  EXPECT_EQ(5, b.as<int>());
+
+  // A capacity of zero disables the cache
+  size_t capacity = cache.get_capacity();
+  cache.set_capacity(0);
+  EXPECT_EQ(0u, cache.size());
+  cache.reset_stats();
+  EXPECT_EQ(1, f(8, 7).as<int>());
+  EXPECT_EQ(0u, cache.get_hits());
+  EXPECT_EQ(0u, cache.get_misses());
+  cache.set_capacity(capacity);
+}
+
+TEST(Callable, Prepare)
+{
+  nd::callable f = nd::functional::apply([](int x, int y) { return x - y; });
+
+  ndt::type src_tp[2] = {ndt::type::make<int>(), ndt::type::make<int>()};
+  const char *src_arrmeta[2] = {NULL, NULL};
+  nd::bound_kernel bk = f.prepare(2, src_tp, src_arrmeta);
+  EXPECT_EQ(ndt::type::make<int>(), bk.get_dst_type());
+
+  int x = 10, y = 3, dst = 0;
+  char *src[2] = {reinterpret_cast<char *>(&x), reinterpret_cast<char *>(&y)};
+  bk.single(reinterpret_cast<char *>(&dst), src);
+  EXPECT_EQ(7, dst);
+  x = 4;
+  bk.single(reinterpret_cast<char *>(&dst), src);
+  EXPECT_EQ(1, dst);
+
+  bk = f.prepare(2, src_tp, src_arrmeta, kernel_request_strided);
+  int xs[3] = {5, 6, 7}, ys[3] = {1, 2, 3}, dsts[3] = {0, 0, 0};
+  char *strided_src[2] = {reinterpret_cast<char *>(xs), reinterpret_cast<char *>(ys)};
+  intptr_t src_stride[2] = {sizeof(int), sizeof(int)};
+  bk.strided(reinterpret_cast<char *>(dsts), sizeof(int), strided_src, src_stride, 3);
+  EXPECT_EQ(4, dsts[0]);
+  EXPECT_EQ(4, dsts[1]);
+  EXPECT_EQ(4, dsts[2]);
+
+  // The destination type is resolved from the types of the arguments
+  nd::callable g = nd::functional::elwise(f);
+  nd::array args[2] = {{1, 2, 3}, {3, 2, 1}};
+  bk = g.prepare(2, args);
+  EXPECT_EQ(ndt::type("3 * int32"), bk.get_dst_type());
+  nd::array res = nd::empty(bk.get_dst_type());
+  char *args_data[2] = {args[0].data(), args[1].data()};
+  bk.single(res.data(), args_data);
+  EXPECT_ARRAY_EQ(nd::array({-2, 0, 2}), res);
+
+  EXPECT_THROW(f.prepare(1, src_tp, src_arrmeta), invalid_argument);
+}
+
 TEST(Callable, DynamicCall)
 {
   nd::callable af;
@@ -163,21 +231,21 @@ TEST(Callable, DecomposedDynamicCall)
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; });
   ret_tp = af.get_ret_type();
-  EXPECT_EQ(26.5, (*af.get())(ret_tp, 3, types, arrmetas, datas, 0, NULL, map<std::string, ndt::type>()).as<double>());
+  EXPECT_EQ(26.5, (*af.get())(ret_tp, 3, types, arrmetas, datas, 0, NULL, ndt::typevar_map()).as<double>());
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "z");
   ret_tp = af.get_ret_type();
   EXPECT_EQ(26.5,
-            (*af.get())(ret_tp, 2, types, arrmetas, datas, 1, values + 2, map<std::string, ndt::type>()).as<double>());
+            (*af.get())(ret_tp, 2, types, arrmetas, datas, 1, values + 2, ndt::typevar_map()).as<double>());
 
   af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "y", "z");
   ret_tp = af.get_ret_type();
   EXPECT_EQ(26.5,
-            (*af.get())(ret_tp, 1, types, arrmetas, datas, 2, values + 1, map<std::string, ndt::type>()).as<double>());
+            (*af.get())(ret_tp, 1, types, arrmetas, datas, 2, values + 1, ndt::typevar_map()).as<double>());
 
   //  af = nd::functional::apply([](int x, double y, int z) { return 2 * x - y + 3 * z; }, "x", "y", "z");
   //  ret_tp = af.get_ret_type();
-  //  EXPECT_EQ(26.5, (*af.get())(ret_tp, 0, NULL, NULL, NULL, 3, values, map<string, ndt::type>()).as<double>());
+  //  EXPECT_EQ(26.5, (*af.get())(ret_tp, 0, NULL, NULL, NULL, 3, values, ndt::typevar_map()).as<double>());
 }
 
 TEST(Callable, KeywordParsing)
@@ -201,8 +269,7 @@ TEST(Callable, Option)
                         const callable_type *DYND_UNUSED(self_tp),
                         intptr_t DYND_UNUSED(nsrc),
                         const ndt::type *DYND_UNUSED(src_tp), nd::array &kwds,
-                        const std::map<std::string, ndt::type>
-&DYND_UNUSED(tp_vars))
+                        const ndt::typevar_map &DYND_UNUSED(tp_vars))
     {
       nd::array x = kwds.p("x");
       if (x.is_missing()) {
@@ -265,7 +332,7 @@ TEST(Callable, AssignmentAsExpr)
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_single, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        ndt::typevar_map());
   int int_out = 0;
   char str_in[16] = "3251";
   char *str_in_ptr = str_in;
@@ -278,7 +345,7 @@ TEST(Callable, AssignmentAsExpr)
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, af.get_type()->get_return_type(), NULL,
                         af.get_type()->get_npos(), af.get_type()->get_pos_types_raw(), src_arrmeta,
                         kernel_request_strided, &eval::default_eval_context, 0, NULL,
-                        std::map<std::string, ndt::type>());
+                        ndt::typevar_map());
   int ints_out[3] = {0, 0, 0};
   char strs_in[3][16] = {"123", "4567", "891029"};
   char *strs_in_ptr = strs_in[0];
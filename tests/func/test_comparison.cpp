@@ -16,6 +16,8 @@
 #include <dynd/func/elwise.hpp>
 #include <dynd/array.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
+#include <dynd/callables/ckernel_cache.hpp>
 
 using namespace dynd;
 
@@ -82,3 +84,39 @@ TEST(Comparison, OptionArray)
   EXPECT_ARRAY_EQ(nd::is_avail(data == data), expected);
   EXPECT_ARRAY_EQ(nd::is_avail(data != data), expected);
 }
+
+TEST(Comparison, Contiguous)
+{
+  const int n = 1003;
+  nd::array a = nd::empty(n, ndt::type::make<float>());
+  nd::array b = nd::empty(n, ndt::type::make<float>());
+  nd::array c = nd::empty(n, ndt::type::make<uint16_t>());
+  nd::array d = nd::empty(n, ndt::type::make<uint16_t>());
+  for (int i = 0; i < n; ++i) {
+    reinterpret_cast<float *>(a.data())[i] = static_cast<float>(i % 7);
+    reinterpret_cast<float *>(b.data())[i] = static_cast<float>(i % 5);
+    reinterpret_cast<uint16_t *>(c.data())[i] = static_cast<uint16_t>(i * 97);
+    reinterpret_cast<uint16_t *>(d.data())[i] = static_cast<uint16_t>(i * 89);
+  }
+
+  simd_level_t max_level = get_max_simd_level();
+  for (int level = simd_level_none; level <= max_level; ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+    nd::get_ckernel_cache().clear();
+
+    nd::array lt = a < b, le = a <= b, eq = a == b, ne = a != b, ge = a >= b, gt = a > b, uint_lt = c < d;
+    EXPECT_EQ(ndt::make_fixed_dim(n, ndt::type::make<bool1>()), lt.get_type());
+    for (int i = 0; i < n; ++i) {
+      int x = i % 7, y = i % 5;
+      EXPECT_EQ(x < y, lt(i).as<bool>());
+      EXPECT_EQ(x <= y, le(i).as<bool>());
+      EXPECT_EQ(x == y, eq(i).as<bool>());
+      EXPECT_EQ(x != y, ne(i).as<bool>());
+      EXPECT_EQ(x >= y, ge(i).as<bool>());
+      EXPECT_EQ(x > y, gt(i).as<bool>());
+      EXPECT_EQ(static_cast<uint16_t>(i * 97) < static_cast<uint16_t>(i * 89), uint_lt(i).as<bool>());
+    }
+  }
+  set_simd_level(max_level);
+  nd::get_ckernel_cache().clear();
+}
@@ -113,7 +113,7 @@ TEST(Elwise, UnaryExpr_StridedToVarDim)
   const char *src_arrmeta[1] = {in.get()->metadata()};
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, dst_tp, out.get()->metadata(),
                         af.get_type()->get_npos(), &src_tp, src_arrmeta, kernel_request_single,
-                        &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                        &eval::default_eval_context, 0, NULL, ndt::typevar_map());
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   usngo(ckb.get(), out.data(), const_cast<char **>(&in_ptr));
   EXPECT_EQ(5, out.get_shape()[0]);
@@ -143,7 +143,7 @@ TEST(Elwise, UnaryExpr_VarToVarDim)
   const char *src_arrmeta[1] = {in.get()->metadata()};
   af.get()->instantiate(af.get()->static_data(), NULL, &ckb, 0, out.get_type(), out.get()->metadata(),
                         af.get_type()->get_npos(), &in.get_type(), src_arrmeta, kernel_request_single,
-                        &eval::default_eval_context, 0, NULL, std::map<std::string, ndt::type>());
+                        &eval::default_eval_context, 0, NULL, ndt::typevar_map());
   expr_single_t usngo = ckb.get()->get_function<expr_single_t>();
   usngo(ckb.get(), out.data(), const_cast<char **>(&in_ptr));
   EXPECT_EQ(5, out.get_shape()[0]);
@@ -256,3 +256,132 @@ TEST(Elwise, Simple)
 //  EXPECT_ARRAY_EQ(nd::array({3, 5, 7}).to_cuda_device(), baf(a, b));
 #endif
 }
+
+TEST(Elwise, CoalescedDims)
+{
+  nd::callable af = nd::functional::elwise(nd::functional::apply<callable0>());
+
+  nd::array a = nd::empty("1000 * 4 * int32");
+  nd::array b = nd::empty("1000 * 4 * int32");
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 4000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 2 * i;
+  }
+
+  // Contiguous, all dimensions run as one loop
+  nd::array c = af(a, b);
+  EXPECT_EQ(ndt::type("1000 * 4 * int32"), c.get_type());
+  const int *c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 4000; ++i) {
+    EXPECT_EQ(3 * i, c_data[i]);
+  }
+
+  // Only some of the operands are contiguous
+  c = af(a(irange(), irange().by(2)), b(irange(), irange() < 2));
+  EXPECT_EQ(ndt::type("1000 * 2 * int32"), c.get_type());
+  c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(4 * i + 8 * i, c_data[2 * i]);
+    EXPECT_EQ(4 * i + 2 + 8 * i + 2, c_data[2 * i + 1]);
+  }
+
+  // Broadcasting a row and a column
+  c = af(a, b(0));
+  c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 4000; ++i) {
+    EXPECT_EQ(i + 2 * (i % 4), c_data[i]);
+  }
+  c = af(a(irange(), irange() < 1), b);
+  EXPECT_EQ(ndt::type("1000 * 4 * int32"), c.get_type());
+  c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 4000; ++i) {
+    EXPECT_EQ(i - i % 4 + 2 * i, c_data[i]);
+  }
+}
+
+TEST(Elwise, ContiguousStrided)
+{
+  nd::callable af = nd::functional::elwise(nd::functional::apply<callable0>());
+
+  nd::array a = nd::empty("3 * 4 * int32");
+  nd::array b = nd::empty("3 * 4 * int32");
+  nd::array c = nd::empty("3 * 4 * int32");
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 12; ++i) {
+    a_data[i] = i;
+    b_data[i] = 10 * i;
+  }
+
+  // Run the kernel for one row as a strided kernel over the rows
+  nd::array args[2] = {a(0), b(0)};
+  nd::bound_kernel k = af.prepare(2, args, kernel_request_strided);
+  char *src[2] = {a.data(), b.data()};
+  intptr_t src_stride[2] = {16, 16};
+  k.strided(c.data(), 16, src, src_stride, 3);
+
+  const int *c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_EQ(11 * i, c_data[i]);
+  }
+
+  // Rows that are not laid out back to back
+  src_stride[1] = 0;
+  k.strided(c.data(), 16, src, src_stride, 3);
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_EQ(i + 10 * (i % 4), c_data[i]);
+  }
+}
+
+TEST(Elwise, Parallel)
+{
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 100;
+
+  nd::callable af = nd::functional::elwise(nd::functional::apply<callable0>());
+
+  nd::array a = nd::empty("1000 * 8 * int32");
+  nd::array b = nd::empty("1000 * 8 * int32");
+  int *a_data = reinterpret_cast<int *>(a.data());
+  int *b_data = reinterpret_cast<int *>(b.data());
+  for (int i = 0; i < 8000; ++i) {
+    a_data[i] = i;
+    b_data[i] = 3 * i;
+  }
+
+  // Contiguous, split across the workers as one dimension
+  nd::array c = af(a, b);
+  const int *c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 8000; ++i) {
+    EXPECT_EQ(4 * i, c_data[i]);
+  }
+
+  // Two dimensions which cannot be merged, and a broadcast row
+  c = af(a(irange(), irange().by(2)), b(0, irange() < 4));
+  EXPECT_EQ(ndt::type("1000 * 4 * int32"), c.get_type());
+  c_data = reinterpret_cast<const int *>(c.cdata());
+  for (int i = 0; i < 1000; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_EQ(8 * i + 2 * j + 3 * j, c_data[4 * i + j]);
+    }
+  }
+
+  // An error in one of the workers is raised in the caller
+  nd::callable parse_int = nd::functional::elwise(
+      make_callable_from_assignment(ndt::type::make<int>(), ndt::string_type::make(), assign_error_default));
+  nd::array s = nd::empty("1000 * string");
+  for (int i = 0; i < 1000; ++i) {
+    s(i).vals() = (i == 777) ? "seven" : "7";
+  }
+  EXPECT_THROW(parse_int(s), std::exception);
+  s(777).vals() = "7";
+  nd::array parsed = parse_int(s);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(7, parsed(i).as<int>());
+  }
+
+  eval::default_eval_context = saved_ectx;
+}
@@ -0,0 +1,115 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+#include "inc_gtest.hpp"
+#include "../dynd_assertions.hpp"
+
+#include <dynd/array.hpp>
+#include <dynd/func/arithmetic.hpp>
+#include <dynd/func/lazy.hpp>
+#include <dynd/func/math.hpp>
+#include <dynd/func/random.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(Lazy, MultiplyAdd)
+{
+  // Not a multiple of the block size, so the last block is partial
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::type("3001 * float64"), "seed", 1));
+  nd::array b = nd::random::uniform(kwds("dst_tp", ndt::type("3001 * float64"), "seed", 2));
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::type("3001 * float64"), "seed", 3));
+
+  nd::functional::lazy expr = nd::functional::lazy(a) * b + c;
+  EXPECT_EQ(ndt::type::make<double>(), expr.get_dtype());
+  EXPECT_ARRAY_EQ(nd::add(nd::multiply(a, b), c), expr.eval());
+}
+
+TEST(Lazy, Broadcast)
+{
+  nd::array a = {{1, 2, 3}, {4, 5, 6}};
+  nd::array b = {0.5, 1.5, 2.5};
+
+  nd::functional::lazy expr = (nd::functional::lazy(a) - b) / b;
+  EXPECT_EQ(ndt::type::make<double>(), expr.get_dtype());
+  EXPECT_ARRAY_EQ(nd::divide(nd::subtract(a, b), b), expr.eval());
+}
+
+TEST(Lazy, Deferred)
+{
+  nd::array a = {1, 2, 3};
+  nd::functional::lazy expr = -nd::functional::lazy(a) * a;
+
+  // Nothing is computed until the expression is evaluated
+  a(1).vals() = 10;
+  EXPECT_ARRAY_EQ((nd::array{-1, -100, -9}), expr.eval());
+}
+
+TEST(Lazy, Shared)
+{
+  nd::array a = {1.0, 2.0, 3.0, 4.0};
+  nd::array b = {2.0, 2.0, 2.0, 2.0};
+
+  nd::functional::lazy x(a);
+  nd::functional::lazy t = x * b;
+  nd::functional::lazy expr = (t + t) / x;
+
+  // The array and the subexpression are each used once in the fused callable
+  vector<nd::array> args;
+  nd::callable f = expr.fuse(args);
+  ASSERT_EQ(2u, args.size());
+  EXPECT_ARRAY_EQ((nd::array{4.0, 4.0, 4.0, 4.0}), f(args.size(), args.data()));
+
+  // The fused callable can be reused on other arrays
+  nd::array c = {{1.0, 3.0}, {5.0, 7.0}};
+  EXPECT_ARRAY_EQ((nd::array{{3.0, 3.0}, {3.0, 3.0}}), f(c, 1.5));
+}
+
+TEST(Lazy, Math)
+{
+  nd::array a = {0.0, 0.5, 1.0, 1.5};
+  nd::functional::lazy expr = nd::functional::lazy(nd::sin, {a}) * a;
+  EXPECT_ARRAY_EQ(nd::multiply(nd::sin(a), a), expr.eval());
+}
+
+TEST(Lazy, EvalIntoDst)
+{
+  nd::array a = {1.5, 2.5, 3.5};
+  nd::array b = {1.0, 2.0, 3.0};
+  nd::functional::lazy expr = nd::functional::lazy(a) + b;
+
+  nd::array dst = nd::empty(ndt::type("3 * float64"));
+  expr.eval(dst);
+  EXPECT_ARRAY_EQ((nd::array{2.5, 4.5, 6.5}), dst);
+
+  // The result is converted to the destination type
+  nd::array dst32 = nd::empty(ndt::type("3 * float32"));
+  expr.eval(dst32);
+  EXPECT_ARRAY_EQ((nd::array{2.5f, 4.5f, 6.5f}), dst32);
+
+  // The result is broadcast to the destination shape
+  nd::array dst2 = nd::empty(ndt::type("2 * 3 * float64"));
+  expr.eval(dst2);
+  EXPECT_ARRAY_EQ((nd::array{{2.5, 4.5, 6.5}, {2.5, 4.5, 6.5}}), dst2);
+}
+
+TEST(Lazy, Leaf)
+{
+  nd::array a = {1, 2, 3};
+  nd::array b = nd::functional::lazy(a).eval();
+  EXPECT_ARRAY_EQ(a, b);
+  EXPECT_NE(a.data(), b.data());
+}
+
+TEST(Lazy, Errors)
+{
+  nd::array a = {1, 2, 3};
+  EXPECT_THROW(nd::functional::lazy(nd::add, {a}), invalid_argument);
+  EXPECT_THROW(nd::functional::lazy(nd::array()), invalid_argument);
+}
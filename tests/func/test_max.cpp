@@ -12,6 +12,7 @@
 
 #include <dynd/func/min.hpp>
 #include <dynd/func/max.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -61,3 +62,50 @@ TEST(Max, FixedDimVarDim)
   EXPECT_ARRAY_EQ(10, nd::max(parse_json(ndt::type("2 * var * int32"), "[[0], [10, 2]]")));
   EXPECT_ARRAY_EQ(23.5, nd::max(parse_json(ndt::type("3 * var * float64"), "[[23.5], [10, 2, 15], [-4]]")));
 }
+
+TEST(Max, Contiguous)
+{
+  const int n = 1001;
+  nd::array a = nd::empty(n, ndt::type::make<float>());
+  nd::array b = nd::empty(n, ndt::type::make<uint16_t>());
+  float *a_data = reinterpret_cast<float *>(a.data());
+  uint16_t *b_data = reinterpret_cast<uint16_t *>(b.data());
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = static_cast<float>((i * 37) % n) - 500.0f;
+    b_data[i] = static_cast<uint16_t>((i * 37) % n + 10);
+  }
+  // The scalar kernels skip NaNs after the first element, and so do the
+  // vectorized ones
+  a_data[100] = numeric_limits<float>::quiet_NaN();
+
+  simd_level_t max_level = get_max_simd_level();
+  for (int level = simd_level_none; level <= max_level; ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+
+    EXPECT_ARRAY_EQ(-500.0f, nd::min(a));
+    EXPECT_ARRAY_EQ(500.0f, nd::max(a));
+    EXPECT_ARRAY_EQ(static_cast<uint16_t>(10), nd::min(b));
+    EXPECT_ARRAY_EQ(static_cast<uint16_t>(1010), nd::max(b));
+  }
+  set_simd_level(max_level);
+}
+
+TEST(Max, Parallel)
+{
+  nd::array a = nd::empty(64, 10000, ndt::type::make<int>());
+  int *a_data = reinterpret_cast<int *>(a.data());
+  for (int i = 0; i < 640000; ++i) {
+    a_data[i] = static_cast<int>((i * 7919LL) % 640000) - 320000;
+  }
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 1000;
+
+  // The inner dimension is reduced on several threads for every row
+  EXPECT_ARRAY_EQ(319999, nd::max(a));
+  EXPECT_ARRAY_EQ(-320000, nd::min(a));
+  EXPECT_ARRAY_EQ(319991, nd::max(a(0)));
+
+  eval::default_eval_context = saved_ectx;
+}
@@ -25,6 +25,23 @@ TEST(Mean, 1D)
   EXPECT_ARRAY_EQ(4.5, nd::mean(nd::array{0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}));
 }
 
+TEST(Mean, Parallel)
+{
+  nd::array a = nd::empty(100000, ndt::type::make<double>());
+  double *a_data = reinterpret_cast<double *>(a.data());
+  for (int i = 0; i < 100000; ++i) {
+    a_data[i] = i % 10;
+  }
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 1000;
+
+  EXPECT_ARRAY_EQ(4.5, nd::mean(a));
+
+  eval::default_eval_context = saved_ectx;
+}
+
 #if _MSC_VER >= 1900
 
 TEST(Mean, 2D)
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <sstream>
 
 #include "inc_gtest.hpp"
 #include "dynd_assertions.hpp"
@@ -211,3 +213,65 @@ TEST(Multidispatch, BinaryWithPermutation)
   EXPECT_THROW(func(int32(), int64()), runtime_error);
   EXPECT_THROW(func(int32(), float16()), runtime_error);
 }
+
+TEST(Dispatch, Unary)
+{
+  nd::callable func0 = nd::functional::apply([](int32) { return 0; });
+  nd::callable func1 = nd::functional::apply([](float32) { return 1; });
+  nd::callable func2 = nd::functional::apply([](float64) { return 2; });
+
+  nd::callable func = nd::functional::dispatch(ndt::type("(Any) -> Any"), {func0, func1, func2});
+  EXPECT_ARRAY_EQ(0, func(int32()));
+  EXPECT_ARRAY_EQ(1, func(float32()));
+  EXPECT_ARRAY_EQ(2, func(float64()));
+  EXPECT_THROW(func(int64()), runtime_error);
+  EXPECT_THROW(func(float16()), runtime_error);
+  EXPECT_THROW(func(nd::array("abc")), runtime_error);
+}
+
+TEST(Dispatch, Binary)
+{
+  nd::callable func0 = nd::functional::apply([](int32, int32) { return 0; });
+  nd::callable func1 = nd::functional::apply([](int32, float32) { return 1; });
+  nd::callable func2 = nd::functional::apply([](float64, float64) { return 2; });
+
+  nd::callable func = nd::functional::dispatch(ndt::type("(Any, Any) -> Any"), {func0, func1, func2});
+  EXPECT_ARRAY_EQ(0, func(int32(), int32()));
+  EXPECT_ARRAY_EQ(1, func(int32(), float32()));
+  EXPECT_ARRAY_EQ(2, func(float64(), float64()));
+  EXPECT_THROW(func(float32(), int32()), runtime_error);
+  EXPECT_THROW(func(int32(), int64()), runtime_error);
+}
+
+TEST(Dispatch, OnNull)
+{
+  std::map<std::array<type_id_t, 2>, nd::callable> children;
+  children[{{int32_type_id, int32_type_id}}] = nd::functional::apply([](int32 x, int32 y) { return x - y; });
+  children[{{float64_type_id, int32_type_id}}] = nd::functional::apply([](float64 x, int32 y) { return x * y; });
+
+  nd::callable func = nd::functional::dispatch(ndt::type("(Any, Any) -> Any"), children,
+                                               [](const ndt::type &DYND_UNUSED(dst_tp), intptr_t nsrc,
+                                                  const ndt::type *src_tp) {
+                                                 stringstream ss;
+                                                 ss << nsrc << " " << src_tp[0] << " " << src_tp[1];
+                                                 throw invalid_argument(ss.str());
+                                               });
+  EXPECT_ARRAY_EQ(3, func(5, 2));
+  EXPECT_ARRAY_EQ(5.0, func(2.5, 2));
+  try {
+    func(2, 2.5);
+    FAIL() << "expected an exception";
+  }
+  catch (const invalid_argument &e) {
+    EXPECT_EQ("2 int32 float64", std::string(e.what()));
+  }
+
+  // A child with a dynamic type id can't go in the table
+  type_id_t dynamic_id = static_cast<type_id_t>(DYND_TYPE_ID_MAX + 1);
+  children[{{string_type_id, dynamic_id}}] = children[{{int32_type_id, int32_type_id}}];
+  EXPECT_THROW(nd::functional::dispatch(ndt::type("(Any, Any) -> Any"), children,
+                                        [](const ndt::type &, intptr_t, const ndt::type *) {
+                                          throw runtime_error("no child found");
+                                        }),
+               invalid_argument);
+}
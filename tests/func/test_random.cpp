@@ -7,11 +7,14 @@
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "inc_gtest.hpp"
 #include "dynd_assertions.hpp"
 
 #include <dynd/func/random.hpp>
+#include <dynd/philox.hpp>
+#include <dynd/json_formatter.hpp>
 
 typedef testing::Types<int32_t, int64_t, uint32_t, uint64_t> IntegralTypes;
 typedef testing::Types<float, double> RealTypes;
@@ -61,4 +64,148 @@ TYPED_TEST_P(Random, Uniform)
 
 REGISTER_TYPED_TEST_CASE_P(Random, Uniform);
 INSTANTIATE_TYPED_TEST_CASE_P(Integral, Random, IntegralTypes);
-INSTANTIATE_TYPED_TEST_CASE_P(Real, Random, RealTypes);
\ No newline at end of file
+INSTANTIATE_TYPED_TEST_CASE_P(Real, Random, RealTypes);
+
+TEST(Random, Philox)
+{
+  // Known answers from the Random123 test vectors
+  philox4x32::block_type block = philox4x32(0)(philox4x32::block_type{{0, 0, 0, 0}});
+  EXPECT_EQ(0x6627e8d5u, block[0]);
+  EXPECT_EQ(0xe169c58du, block[1]);
+  EXPECT_EQ(0xbc57ac4cu, block[2]);
+  EXPECT_EQ(0x9b00dbd8u, block[3]);
+
+  block = philox4x32(0xffffffffffffffffULL)(
+      philox4x32::block_type{{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}});
+  EXPECT_EQ(0x408f276du, block[0]);
+  EXPECT_EQ(0x41c83b0eu, block[1]);
+  EXPECT_EQ(0xa20bc7c6u, block[2]);
+  EXPECT_EQ(0x6d5451fdu, block[3]);
+}
+
+TEST(Random, Seed)
+{
+  ndt::type dst_tp = ndt::type("1000 * float64");
+  nd::array a = nd::random::uniform(kwds("dst_tp", dst_tp, "seed", 42));
+  EXPECT_ARRAY_EQ(a, nd::random::uniform(kwds("dst_tp", dst_tp, "seed", 42)));
+  EXPECT_ARRAY_EQ(a, nd::random::uniform(kwds("dst_tp", dst_tp, "seed", 42, "stream", 0)));
+  EXPECT_FALSE(nd::random::uniform(kwds("dst_tp", dst_tp, "seed", 42, "stream", 1))(0).as<double>() ==
+               a(0).as<double>());
+  EXPECT_FALSE(nd::random::uniform(kwds("dst_tp", dst_tp, "seed", 43))(0).as<double>() == a(0).as<double>());
+
+  // Without a seed, each call gets its own stream
+  EXPECT_FALSE(nd::random::uniform(kwds("dst_tp", dst_tp))(0).as<double>() ==
+               nd::random::uniform(kwds("dst_tp", dst_tp))(0).as<double>());
+}
+
+TEST(Random, Shape)
+{
+  // Values follow the C order of the destination, whatever its strides
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::type("6 * 5 * int64"), "seed", 7));
+  nd::array b = nd::empty(5, 6, ndt::type::make<int64_t>());
+  nd::random::uniform(kwds("dst", b.permute(2, std::vector<intptr_t>{1, 0}.data()), "seed", 7));
+  EXPECT_ARRAY_EQ(a, b.permute(2, std::vector<intptr_t>{1, 0}.data()));
+
+  nd::array c = nd::random::uniform(kwds("dst_tp", ndt::type("30 * int64"), "seed", 7));
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_EQ(c(i).as<int64_t>(), a(i / 5, i % 5).as<int64_t>());
+  }
+}
+
+TEST(Random, Parallel)
+{
+  ndt::type dst_tp = ndt::type("100003 * float32");
+  nd::array serial = nd::random::normal(kwds("dst_tp", dst_tp, "seed", 3, "stream", 5));
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 1000;
+  nd::array parallel = nd::random::normal(kwds("dst_tp", dst_tp, "seed", 3, "stream", 5));
+  eval::default_eval_context = saved_ectx;
+
+  EXPECT_ARRAY_EQ(serial, parallel);
+}
+
+TEST(Random, IntegerRange)
+{
+  nd::array a = nd::random::uniform(kwds("a", -3, "b", 3, "dst_tp", ndt::type("10000 * int32"), "seed", 1));
+  int counts[7] = {0};
+  for (intptr_t i = 0; i < 10000; ++i) {
+    int value = a(i).as<int>();
+    ASSERT_TRUE(value >= -3 && value <= 3);
+    ++counts[value + 3];
+  }
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_NEAR(10000.0 / 7, counts[i], 150);
+  }
+
+  EXPECT_THROW(nd::random::uniform(kwds("a", 3, "b", -3, "dst_tp", ndt::type("10 * int32"))), invalid_argument);
+}
+
+TEST(Random, Normal)
+{
+  intptr_t size = 100000;
+  nd::array a =
+      nd::random::normal(kwds("mean", 2.0, "stddev", 3.0, "dst_tp", ndt::make_fixed_dim(size, ndt::type("float64"))));
+  const double *data = reinterpret_cast<const double *>(a.cdata());
+  double mean = 0, var = 0;
+  for (intptr_t i = 0; i < size; ++i) {
+    mean += data[i];
+  }
+  mean /= size;
+  for (intptr_t i = 0; i < size; ++i) {
+    var += (data[i] - mean) * (data[i] - mean);
+  }
+  var /= size;
+
+  EXPECT_NEAR(2.0, mean, 0.05);
+  EXPECT_NEAR(9.0, var, 0.2);
+}
+
+TEST(Random, Exponential)
+{
+  intptr_t size = 100000;
+  nd::array a = nd::random::exponential(kwds("lambda", 4.0, "dst_tp", ndt::make_fixed_dim(size, ndt::type("float64"))));
+  const double *data = reinterpret_cast<const double *>(a.cdata());
+  double mean = 0;
+  for (intptr_t i = 0; i < size; ++i) {
+    ASSERT_GE(data[i], 0.0);
+    mean += data[i];
+  }
+  mean /= size;
+
+  EXPECT_NEAR(0.25, mean, 0.005);
+  EXPECT_THROW(nd::random::exponential(kwds("lambda", -1.0, "dst_tp", ndt::type("10 * float64"))), invalid_argument);
+}
+
+TEST(Random, VarDim)
+{
+  // Dimensions that are not strided are lifted by elwise, each element continuing the stream
+  nd::array a = nd::random::uniform(kwds("a", 2.0, "b", 3.0, "dst_tp", ndt::type("3 * var * float64"), "seed", 11));
+  EXPECT_EQ(ndt::type("3 * var * float64"), a.get_type());
+  std::vector<double> vals;
+  for (intptr_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(1, a(i).get_dim_size());
+    vals.push_back(a(i, 0).as<double>());
+    EXPECT_LE(2.0, vals.back());
+    EXPECT_GT(3.0, vals.back());
+  }
+  EXPECT_NE(vals[0], vals[1]);
+  EXPECT_NE(vals[1], vals[2]);
+  EXPECT_NE(vals[0], vals[2]);
+
+  EXPECT_EQ(format_json(a).as<std::string>(),
+            format_json(nd::random::uniform(kwds("a", 2.0, "b", 3.0, "dst_tp", ndt::type("3 * var * float64"),
+                                                 "seed", 11))).as<std::string>());
+}
+
+TEST(Random, Empty)
+{
+  nd::array a = nd::random::uniform(kwds("dst_tp", ndt::type("0 * float64"), "seed", 5));
+  EXPECT_EQ(ndt::type("0 * float64"), a.get_type());
+  EXPECT_EQ(0, a.get_dim_size());
+
+  a = nd::random::uniform(kwds("dst_tp", ndt::type("3 * 0 * float64"), "seed", 5));
+  EXPECT_EQ(ndt::type("3 * 0 * float64"), a.get_type());
+  EXPECT_EQ(0, a(0).get_dim_size());
+}
@@ -11,6 +11,7 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/sort.hpp>
+#include <dynd/json_parser.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -28,11 +29,197 @@ TEST(Sort, 1D)
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19}), a);
 }
 
-/*
+TEST(Sort, Typed)
+{
+  // Long enough for the radix sort, with negative values and a strided view
+  const int n = 5000;
+  nd::array a = nd::empty(n, ndt::type::make<int64_t>());
+  nd::array b = nd::empty(2 * n, ndt::type::make<float>());
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  float *b_data = reinterpret_cast<float *>(b.data());
+  vector<int64_t> a_expected(n);
+  vector<float> b_expected(n);
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = a_expected[i] = (i * 7919LL) % 10007 - 5000 + (i % 3) * 4000000000LL;
+    b_data[2 * i] = b_expected[i] = 0.5f * ((i * 31) % 997) - 200.0f;
+    b_data[2 * i + 1] = 1.0f;
+  }
+  sort(a_expected.begin(), a_expected.end());
+  sort(b_expected.begin(), b_expected.end());
+
+  nd::sort(a);
+  nd::sort(b(irange().by(2)));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(a_expected[i], a_data[i]);
+    EXPECT_EQ(b_expected[i], b_data[2 * i]);
+    EXPECT_EQ(1.0f, b_data[2 * i + 1]);
+  }
+
+  // NaNs sort after everything else
+  nd::array c{2.0, numeric_limits<double>::quiet_NaN(), -1.0, -numeric_limits<double>::infinity(), -0.5};
+  nd::sort(c);
+  EXPECT_EQ(-numeric_limits<double>::infinity(), c(0).as<double>());
+  EXPECT_EQ(-1.0, c(1).as<double>());
+  EXPECT_EQ(-0.5, c(2).as<double>());
+  EXPECT_EQ(2.0, c(3).as<double>());
+  EXPECT_TRUE(dynd::isnan(c(4).as<double>()));
+
+  a = {int8_t(5), int8_t(-128), int8_t(127), int8_t(0), int8_t(-1)};
+  nd::sort(a);
+  EXPECT_ARRAY_EQ((nd::array{int8_t(-128), int8_t(-1), int8_t(0), int8_t(5), int8_t(127)}), a);
+}
+
+TEST(Sort, SignedZeros)
+{
+  // -0.0 equals +0.0, so both the comparison sort and the radix sort keep the
+  // zeros in their input order
+  for (int n : {8, 2000}) {
+    nd::array a = nd::empty(n, ndt::type::make<double>());
+    double *a_data = reinterpret_cast<double *>(a.data());
+    vector<bool> zero_signs;
+    for (int i = 0; i < n; ++i) {
+      if (i % 4 == 0) {
+        a_data[i] = (i % 8 == 0) ? 1.0 : -1.0;
+      }
+      else {
+        a_data[i] = (i % 3 == 0) ? -0.0 : 0.0;
+        zero_signs.push_back(signbit(a_data[i]));
+      }
+    }
+
+    nd::array indices = nd::argsort(a);
+    const int64_t *indices_data = reinterpret_cast<const int64_t *>(indices.cdata());
+    vector<bool> argsort_zero_signs;
+    for (int i = 0; i < n; ++i) {
+      if (a_data[indices_data[i]] == 0) {
+        argsort_zero_signs.push_back(signbit(a_data[indices_data[i]]));
+      }
+    }
+    EXPECT_EQ(zero_signs, argsort_zero_signs);
+
+    nd::sort(a);
+    EXPECT_TRUE(is_sorted(a_data, a_data + n));
+    vector<bool> sort_zero_signs;
+    for (int i = 0; i < n; ++i) {
+      if (a_data[i] == 0) {
+        sort_zero_signs.push_back(signbit(a_data[i]));
+      }
+    }
+    EXPECT_EQ(zero_signs, sort_zero_signs);
+  }
+}
+
+TEST(Sort, Parallel)
+{
+  const int n = 100003;
+  nd::array a = nd::empty(n, ndt::type::make<uint32_t>());
+  nd::array b = nd::empty(n, ndt::type::make<double>());
+  uint32_t *a_data = reinterpret_cast<uint32_t *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = static_cast<uint32_t>(i * 2654435761U);
+    b_data[i] = (i % 2 ? -1.0 : 1.0) * ((i * 7919) % 1000);
+  }
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 3;
+  eval::default_eval_context.min_grain_size = 1000;
+
+  nd::sort(a);
+  nd::sort(b);
+  EXPECT_TRUE(is_sorted(a_data, a_data + n));
+  EXPECT_TRUE(is_sorted(b_data, b_data + n));
+  EXPECT_EQ(-999.0, b_data[0]);
+  EXPECT_EQ(998.0, b_data[n - 1]);
+
+  eval::default_eval_context = saved_ectx;
+}
+
+TEST(Argsort, 1D)
+{
+  EXPECT_ARRAY_EQ((nd::array{2LL, 0LL, 3LL, 1LL}), nd::argsort(nd::array{1.5, 9.0, -2.0, 3.0}));
+  // Equal values keep their order
+  EXPECT_ARRAY_EQ((nd::array{1LL, 3LL, 0LL, 2LL, 4LL}), nd::argsort(nd::array{7, 2, 7, 2, 9}));
+  // A type without a typed path uses the less comparison
+  EXPECT_ARRAY_EQ((nd::array{1LL, 2LL, 0LL}), nd::argsort(parse_json("3 * string", "[\"pear\", \"apple\", \"fig\"]")));
+
+  const int n = 3000;
+  nd::array a = nd::empty(n, ndt::type::make<int16_t>());
+  int16_t *a_data = reinterpret_cast<int16_t *>(a.data());
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = static_cast<int16_t>((i * 37) % 101 - 50);
+  }
+  nd::array indices = nd::argsort(a);
+  EXPECT_EQ(ndt::type("3000 * int64"), indices.get_type());
+  const int64_t *indices_data = reinterpret_cast<const int64_t *>(indices.cdata());
+  for (int i = 1; i < n; ++i) {
+    int16_t prev = a_data[indices_data[i - 1]], cur = a_data[indices_data[i]];
+    EXPECT_TRUE(prev < cur || (prev == cur && indices_data[i - 1] < indices_data[i]));
+  }
+}
+
 TEST(Unique, 1D)
 {
   nd::array a{0, 0, 1, 2, 2, 3};
   nd::unique(a);
   EXPECT_ARRAY_EQ((nd::array{0, 1, 2, 3}), a);
+
+  // The input does not need to be sorted, and the first occurrences are kept in order
+  a = {5.0, -1.0, 5.0, 0.0, -0.0, -1.0, 7.5};
+  nd::unique(a);
+  EXPECT_ARRAY_EQ((nd::array{5.0, -1.0, 0.0, 7.5}), a);
+
+  a = parse_json("6 * string", "[\"b\", \"a\", \"b\", \"a long string value\", \"a\", \"\"]");
+  nd::unique(a);
+  EXPECT_ARRAY_EQ(parse_json("4 * string", "[\"b\", \"a\", \"a long string value\", \"\"]"), a);
+
+  // Values without a hash, compared with nd::equal, give the same result
+  a = {dynd::complex<double>(1, 2), dynd::complex<double>(0, 1), dynd::complex<double>(1, 2),
+       dynd::complex<double>(3, 0), dynd::complex<double>(0, 1)};
+  nd::unique(a);
+  EXPECT_ARRAY_EQ((nd::array{dynd::complex<double>(1, 2), dynd::complex<double>(0, 1), dynd::complex<double>(3, 0)}),
+                  a);
+}
+
+TEST(ValueCounts, 1D)
+{
+  nd::array counts = nd::value_counts(nd::array{3, 1, 3, 3, 2, 1});
+  EXPECT_EQ(ndt::type("3 * {value: int32, count: int64}"), counts.get_type());
+  EXPECT_ARRAY_EQ((nd::array{3, 1, 2}), counts(irange(), 0));
+  EXPECT_ARRAY_EQ((nd::array{3LL, 2LL, 1LL}), counts(irange(), 1));
+
+  counts = nd::value_counts(parse_json("5 * string", "[\"x\", \"y\", \"x\", \"z\", \"x\"]"));
+  EXPECT_ARRAY_EQ(parse_json("3 * string", "[\"x\", \"y\", \"z\"]"), counts(irange(), 0));
+  EXPECT_ARRAY_EQ((nd::array{3LL, 1LL, 1LL}), counts(irange(), 1));
+
+  EXPECT_ARRAY_EQ(0LL, nd::count_distinct(nd::empty(0, ndt::type::make<double>())));
+  EXPECT_ARRAY_EQ(3LL, nd::count_distinct(nd::array{1.5, numeric_limits<double>::quiet_NaN(), 1.5, 2.0,
+                                                    numeric_limits<double>::quiet_NaN()}));
+}
+
+TEST(ValueCounts, Parallel)
+{
+  const int n = 100000;
+  nd::array a = nd::empty(n, ndt::type::make<int64_t>());
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = (i * 7919LL) % 1009;
+  }
+  nd::array serial_counts = nd::value_counts(a);
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 1000;
+
+  EXPECT_ARRAY_EQ(1009LL, nd::count_distinct(a));
+  nd::array counts = nd::value_counts(a);
+  EXPECT_ARRAY_EQ(serial_counts, counts);
+  EXPECT_EQ(0, counts(0, 0).as<int64_t>());
+  EXPECT_EQ(7919 % 1009, counts(1, 0).as<int64_t>());
+
+  nd::unique(a);
+  EXPECT_EQ(ndt::type("1009 * int64"), a.get_type());
+  EXPECT_EQ(7919 % 1009, a(1).as<int64_t>());
+
+  eval::default_eval_context = saved_ectx;
 }
-*/
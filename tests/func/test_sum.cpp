@@ -11,6 +11,7 @@
 #include "inc_gtest.hpp"
 
 #include <dynd/func/sum.hpp>
+#include <dynd/kernels/simd_kernels.hpp>
 
 #include "dynd_assertions.hpp"
 
@@ -56,6 +57,76 @@ TEST(Sum, 1D)
                                     dynd::complex<double>(12.125, 12345.0)}));
 }
 
+TEST(Sum, Pairwise)
+{
+  // Accumulating one element at a time drifts by about 1% here
+  nd::array a = nd::empty(1000000, ndt::type::make<float>());
+  float *a_data = reinterpret_cast<float *>(a.data());
+  for (int i = 0; i < 1000000; ++i) {
+    a_data[i] = 0.1f;
+  }
+  EXPECT_NEAR(100000.0f, nd::sum(a).as<float>(), 1.0f);
+}
+
+TEST(Sum, Contiguous)
+{
+  // Long enough for the multiple accumulators and a remainder
+  const int n = 1237;
+  nd::array a = nd::empty(n, ndt::type::make<int8_t>());
+  nd::array b = nd::empty(n, ndt::type::make<int64_t>());
+  nd::array c = nd::empty(n, ndt::type::make<double>());
+  int8_t *a_data = reinterpret_cast<int8_t *>(a.data());
+  int64_t *b_data = reinterpret_cast<int64_t *>(b.data());
+  double *c_data = reinterpret_cast<double *>(c.data());
+  int a_sum = 0;
+  int64_t b_sum = 0;
+  for (int i = 0; i < n; ++i) {
+    a_data[i] = static_cast<int8_t>(i % 7 - 3);
+    b_data[i] = 1000000007LL * (i % 5);
+    c_data[i] = 0.5 * (i % 9);
+    a_sum += a_data[i];
+    b_sum += b_data[i];
+  }
+
+  simd_level_t max_level = get_max_simd_level();
+  for (int level = simd_level_none; level <= max_level; ++level) {
+    set_simd_level(static_cast<simd_level_t>(level));
+
+    EXPECT_ARRAY_EQ(static_cast<int8_t>(a_sum), nd::sum(a));
+    EXPECT_ARRAY_EQ(b_sum, nd::sum(b));
+    EXPECT_ARRAY_EQ(2469.0, nd::sum(c));
+    EXPECT_ARRAY_EQ(static_cast<int8_t>(0), nd::sum(a(irange() < 7)));
+    EXPECT_ARRAY_EQ(0.5 * 36, nd::sum(c(irange() < 9)));
+  }
+  set_simd_level(max_level);
+}
+
+TEST(Sum, Parallel)
+{
+  nd::array a = nd::empty(100003, ndt::type::make<int64_t>());
+  nd::array b = nd::empty(100003, ndt::type::make<double>());
+  int64_t *a_data = reinterpret_cast<int64_t *>(a.data());
+  double *b_data = reinterpret_cast<double *>(b.data());
+  for (int i = 0; i < 100003; ++i) {
+    a_data[i] = i % 1000 - 300;
+    b_data[i] = 0.25 * (i % 8);
+  }
+  nd::array serial_a = nd::sum(a);
+  nd::array serial_b = nd::sum(b);
+
+  eval::eval_context saved_ectx = eval::default_eval_context;
+  eval::default_eval_context.num_threads = 4;
+  eval::default_eval_context.min_grain_size = 1000;
+
+  EXPECT_ARRAY_EQ(serial_a, nd::sum(a));
+  EXPECT_ARRAY_EQ(serial_b, nd::sum(b));
+  EXPECT_ARRAY_EQ(87500.75, nd::sum(b));
+  // A strided view
+  EXPECT_ARRAY_EQ(37500.5, nd::sum(b(irange().by(2))));
+
+  eval::default_eval_context = saved_ectx;
+}
+
 /*
 TEST(Sum, 2D)
 {
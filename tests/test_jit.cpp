@@ -0,0 +1,236 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/jit.hpp>
+#include <dynd/func/apply.hpp>
+#include <dynd/func/callable.hpp>
+#include <dynd/func/elwise.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(JIT, BoundKernel)
+{
+  nd::callable f = nd::functional::apply([](int x, int y) { return x - y; });
+
+  ndt::type src_tp[2] = {ndt::type::make<int>(), ndt::type::make<int>()};
+  const char *src_arrmeta[2] = {NULL, NULL};
+  nd::bound_kernel bk = f.prepare(2, src_tp, src_arrmeta, kernel_request_strided);
+
+  // Whether or not the kernel could be compiled, it computes the same thing
+  bool specialized = bk.specialize();
+  if (!nd::jit::is_available()) {
+    EXPECT_FALSE(specialized);
+  }
+
+  int xs[3] = {5, 6, 7}, ys[3] = {1, 2, 3}, dsts[3] = {0, 0, 0};
+  char *src[2] = {reinterpret_cast<char *>(xs), reinterpret_cast<char *>(ys)};
+  intptr_t src_stride[2] = {sizeof(int), sizeof(int)};
+  bk.strided(reinterpret_cast<char *>(dsts), sizeof(int), src, src_stride, 3);
+  EXPECT_EQ(4, dsts[0]);
+  EXPECT_EQ(4, dsts[1]);
+  EXPECT_EQ(4, dsts[2]);
+
+  // Only strided ckernels are specialized
+  bk = f.prepare(2, src_tp, src_arrmeta);
+  EXPECT_FALSE(bk.specialize());
+}
+
+#ifdef DYND_LLVM
+
+namespace {
+
+// A ckernel tree with a parent that scales the result of its child, which
+// adds one. The IR is written by hand here, as this file may not be built
+// with the clang plugin.
+struct scale_kernel {
+  ckernel_prefix base;
+  double factor;
+  intptr_t child_offset;
+};
+
+void plus_one_single(ckernel_prefix *DYND_UNUSED(self), char *dst, char *const *src)
+{
+  *reinterpret_cast<double *>(dst) = *reinterpret_cast<double *>(src[0]) + 1.0;
+}
+
+void plus_one_strided(ckernel_prefix *DYND_UNUSED(self), char *DYND_UNUSED(dst), intptr_t DYND_UNUSED(dst_stride),
+                      char *const *DYND_UNUSED(src), const intptr_t *DYND_UNUSED(src_stride), size_t DYND_UNUSED(count))
+{
+  throw runtime_error("not used");
+}
+
+void scale_single(ckernel_prefix *DYND_UNUSED(self), char *DYND_UNUSED(dst), char *const *DYND_UNUSED(src))
+{
+  throw runtime_error("not used");
+}
+
+void scale_strided(ckernel_prefix *self, char *dst, intptr_t dst_stride, char *const *src,
+                   const intptr_t *src_stride, size_t count)
+{
+  scale_kernel *sk = reinterpret_cast<scale_kernel *>(self);
+  ckernel_prefix *child = reinterpret_cast<ckernel_prefix *>(reinterpret_cast<char *>(self) + sk->child_offset);
+  expr_single_t child_fn = child->get_function<expr_single_t>();
+  for (size_t i = 0; i != count; ++i) {
+    char *child_src = src[0] + i * src_stride[0];
+    child_fn(child, dst, &child_src);
+    *reinterpret_cast<double *>(dst) *= sk->factor;
+    dst += dst_stride;
+  }
+}
+
+const char *plus_one_ir = R"(
+define void @single_wrapper(i8* %self, i8* %dst, i8** %src) {
+  %s = load i8*, i8** %src
+  %sd = bitcast i8* %s to double*
+  %v = load double, double* %sd
+  %a = fadd double %v, 1.0
+  %dd = bitcast i8* %dst to double*
+  store double %a, double* %dd
+  ret void
+}
+)";
+
+const char *scale_ir = R"(
+define void @strided_wrapper(i8* %self, i8* %dst, i64 %dst_stride, i8** %src, i64* %src_stride, i64 %count) {
+entry:
+  %src0 = load i8*, i8** %src
+  %ss0 = load i64, i64* %src_stride
+  %fp = getelementptr i8, i8* %self, i64 16
+  %fpd = bitcast i8* %fp to double*
+  %factor = load double, double* %fpd
+  %op = getelementptr i8, i8* %self, i64 24
+  %opi = bitcast i8* %op to i64*
+  %off = load i64, i64* %opi
+  %child = getelementptr i8, i8* %self, i64 %off
+  %fpp = getelementptr i8, i8* %child, i64 8
+  %fnp = bitcast i8* %fpp to void (i8*, i8*, i8**)**
+  %fn = load void (i8*, i8*, i8**)*, void (i8*, i8*, i8**)** %fnp
+  %srcbuf = alloca i8*
+  %c0 = icmp eq i64 %count, 0
+  br i1 %c0, label %exit, label %loop
+loop:
+  %i = phi i64 [0, %entry], [%inext, %loop]
+  %doff = mul i64 %i, %dst_stride
+  %d = getelementptr i8, i8* %dst, i64 %doff
+  %soff = mul i64 %i, %ss0
+  %s = getelementptr i8, i8* %src0, i64 %soff
+  store i8* %s, i8** %srcbuf
+  call void %fn(i8* %child, i8* %d, i8** %srcbuf)
+  %dd = bitcast i8* %d to double*
+  %v = load double, double* %dd
+  %m = fmul double %v, %factor
+  store double %m, double* %dd
+  %inext = add i64 %i, 1
+  %done = icmp eq i64 %inext, %count
+  br i1 %done, label %exit, label %loop
+exit:
+  ret void
+}
+)";
+
+// The same parent, but it counts its calls in its own data
+const char *counting_ir = R"(
+define void @strided_wrapper(i8* %self, i8* %dst, i64 %dst_stride, i8** %src, i64* %src_stride, i64 %count) {
+  %fp = getelementptr i8, i8* %self, i64 16
+  %fpd = bitcast i8* %fp to double*
+  %factor = load double, double* %fpd
+  %next = fadd double %factor, 1.0
+  store double %next, double* %fpd
+  ret void
+}
+)";
+
+void counting_single(ckernel_prefix *DYND_UNUSED(self), char *DYND_UNUSED(dst), char *const *DYND_UNUSED(src)) {}
+
+void counting_strided(ckernel_prefix *DYND_UNUSED(self), char *DYND_UNUSED(dst), intptr_t DYND_UNUSED(dst_stride),
+                      char *const *DYND_UNUSED(src), const intptr_t *DYND_UNUSED(src_stride),
+                      size_t DYND_UNUSED(count))
+{
+}
+
+struct scale_tree {
+  union {
+    char data[64];
+    double align;
+  };
+
+  scale_tree(double factor)
+  {
+    memset(data, 0, sizeof(data));
+    scale_kernel *sk = reinterpret_cast<scale_kernel *>(data);
+    sk->base.function = reinterpret_cast<void *>(&scale_strided);
+    sk->factor = factor;
+    sk->child_offset = 32;
+    reinterpret_cast<ckernel_prefix *>(data + 32)->function = reinterpret_cast<void *>(&plus_one_single);
+  }
+
+  ckernel_prefix *get() { return reinterpret_cast<ckernel_prefix *>(data); }
+};
+
+} // anonymous namespace
+
+TEST(JIT, Specialize)
+{
+  EXPECT_TRUE(nd::jit::is_available());
+  nd::jit::register_ir(reinterpret_cast<void *>(&plus_one_single), reinterpret_cast<void *>(&plus_one_strided),
+                       plus_one_ir);
+  nd::jit::register_ir(reinterpret_cast<void *>(&scale_single), reinterpret_cast<void *>(&scale_strided), scale_ir);
+
+  scale_tree tree(3.0);
+  expr_strided_t fn = nd::jit::specialize(tree.get(), sizeof(tree.data));
+  ASSERT_TRUE(fn != NULL);
+
+  // A partial vector at the end, and a non-unit stride
+  vector<double> src(1003), expected(1003), dst(1003);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = 0.5 * i;
+  }
+  char *src_data = reinterpret_cast<char *>(src.data());
+  intptr_t src_stride = sizeof(double);
+  scale_strided(tree.get(), reinterpret_cast<char *>(expected.data()), sizeof(double), &src_data, &src_stride,
+                src.size());
+  fn(tree.get(), reinterpret_cast<char *>(dst.data()), sizeof(double), &src_data, &src_stride, src.size());
+  EXPECT_EQ(expected, dst);
+
+  src_stride = 2 * sizeof(double);
+  scale_strided(tree.get(), reinterpret_cast<char *>(expected.data()), sizeof(double), &src_data, &src_stride, 501);
+  fn(tree.get(), reinterpret_cast<char *>(dst.data()), sizeof(double), &src_data, &src_stride, 501);
+  EXPECT_EQ(expected, dst);
+
+  // The same tree gives the cached function, and a different one a new function
+  scale_tree same(3.0);
+  EXPECT_EQ(fn, nd::jit::specialize(same.get(), sizeof(same.data)));
+  scale_tree other(2.0);
+  expr_strided_t other_fn = nd::jit::specialize(other.get(), sizeof(other.data));
+  ASSERT_TRUE(other_fn != NULL);
+  EXPECT_NE(fn, other_fn);
+  other_fn(other.get(), reinterpret_cast<char *>(dst.data()), sizeof(double), &src_data, &src_stride, 1);
+  EXPECT_EQ(2.0 * (src[0] + 1.0), dst[0]);
+}
+
+TEST(JIT, NotSpecialized)
+{
+  nd::jit::register_ir(reinterpret_cast<void *>(&counting_single), reinterpret_cast<void *>(&counting_strided),
+                       counting_ir);
+
+  // A kernel which writes to its own data can't have it folded
+  scale_tree tree(3.0);
+  tree.get()->function = reinterpret_cast<void *>(&counting_strided);
+  EXPECT_TRUE(nd::jit::specialize(tree.get(), sizeof(tree.data)) == NULL);
+
+  // A kernel without IR can't be compiled
+  tree.get()->function = reinterpret_cast<void *>(&plus_one_strided);
+  EXPECT_TRUE(nd::jit::specialize(tree.get(), sizeof(tree.data)) == NULL);
+}
+
+#endif // DYND_LLVM
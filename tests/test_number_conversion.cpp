@@ -0,0 +1,176 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
+
+#include <dynd/number_conversion.hpp>
+#include <dynd/json_formatter.hpp>
+#include <dynd/json_parser.hpp>
+#include <dynd/types/string_type.hpp>
+#include <dynd/array.hpp>
+
+using namespace std;
+using namespace dynd;
+
+static std::string format_double(double value)
+{
+  char buffer[number_format_max_size];
+  return std::string(buffer, format_float64(buffer, value));
+}
+
+static double parse_double(const std::string &s)
+{
+  double value = -1;
+  EXPECT_TRUE(parse_float64(s.data(), s.data() + s.size(), value)) << s;
+  return value;
+}
+
+static bool same_bits(double x, double y) { return memcmp(&x, &y, sizeof(double)) == 0; }
+
+TEST(NumberConversion, ParseFloat64)
+{
+  EXPECT_EQ(0.0, parse_double("0"));
+  EXPECT_TRUE(std::signbit(parse_double("-0")));
+  EXPECT_EQ(1.5, parse_double("1.5"));
+  EXPECT_EQ(0.5, parse_double(".5"));
+  EXPECT_EQ(5.0, parse_double("5."));
+  EXPECT_EQ(3.0, parse_double("+3"));
+  EXPECT_EQ(-1.25e-10, parse_double("-1.25E-10"));
+  EXPECT_EQ(0.1, parse_double("0.1"));
+  EXPECT_EQ(1.0, parse_double("0000000000000000000000000001"));
+  EXPECT_EQ(1.2345678901234568e+29, parse_double("123456789012345678901234567890"));
+
+  // Near the ends of the range
+  EXPECT_EQ(1.7976931348623157e308, parse_double("1.7976931348623157e308"));
+  EXPECT_EQ(numeric_limits<double>::infinity(), parse_double("1.7976931348623159e308"));
+  EXPECT_EQ(numeric_limits<double>::infinity(), parse_double("1e400"));
+  EXPECT_EQ(2.2250738585072014e-308, parse_double("2.2250738585072014e-308"));
+  EXPECT_EQ(5e-324, parse_double("4.9e-324"));
+  EXPECT_EQ(0.0, parse_double("2.4703282292062327e-324"));
+  EXPECT_EQ(5e-324, parse_double("2.4703282292062328e-324"));
+  EXPECT_EQ(0.0, parse_double("1e-400"));
+
+  // Exactly halfway between two floats rounds to even
+  EXPECT_EQ(9007199254740992.0, parse_double("9007199254740993"));
+  EXPECT_EQ(9007199254740996.0, parse_double("9007199254740995"));
+  // Halfway, but only decided by a digit past the 19th
+  EXPECT_EQ(9007199254740994.0, parse_double("9007199254740993.0000000000001"));
+
+  double value = -1;
+  EXPECT_FALSE(parse_float64(NULL, NULL, value));
+  const char *bad[] = {"", "-", ".", "e5", "1e", "1e+", "1.2.3", "0x10", "nan", " 1", "1 "};
+  for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+    EXPECT_FALSE(parse_float64(bad[i], bad[i] + strlen(bad[i]), value)) << bad[i];
+  }
+  EXPECT_EQ(-1, value);
+}
+
+TEST(NumberConversion, FormatFloat64)
+{
+  EXPECT_EQ("0", format_double(0.0));
+  EXPECT_EQ("-0", format_double(-0.0));
+  EXPECT_EQ("1", format_double(1.0));
+  EXPECT_EQ("-2.5", format_double(-2.5));
+  EXPECT_EQ("0.1", format_double(0.1));
+  EXPECT_EQ("0.30000000000000004", format_double(0.1 + 0.2));
+  EXPECT_EQ("123456", format_double(123456.0));
+  EXPECT_EQ("100000000000000000000", format_double(1e20));
+  EXPECT_EQ("1e+21", format_double(1e21));
+  EXPECT_EQ("0.000001", format_double(1e-6));
+  EXPECT_EQ("1e-7", format_double(1e-7));
+  EXPECT_EQ("1.5e-7", format_double(1.5e-7));
+  EXPECT_EQ("5e-324", format_double(5e-324));
+  EXPECT_EQ("1.7976931348623157e+308", format_double(1.7976931348623157e308));
+  EXPECT_EQ("nan", format_double(numeric_limits<double>::quiet_NaN()));
+  EXPECT_EQ("inf", format_double(numeric_limits<double>::infinity()));
+  EXPECT_EQ("-inf", format_double(-numeric_limits<double>::infinity()));
+
+  char buffer[number_format_max_size];
+  EXPECT_EQ("0.1", std::string(buffer, format_float32(buffer, 0.1f)));
+  EXPECT_EQ("3.4028235e+38", std::string(buffer, format_float32(buffer, numeric_limits<float>::max())));
+}
+
+TEST(NumberConversion, FormatInteger)
+{
+  char buffer[number_format_max_size];
+  EXPECT_EQ("0", std::string(buffer, format_int64(buffer, 0)));
+  EXPECT_EQ("-7", std::string(buffer, format_int64(buffer, -7)));
+  EXPECT_EQ("100", std::string(buffer, format_int64(buffer, 100)));
+  EXPECT_EQ("-9223372036854775808", std::string(buffer, format_int64(buffer, numeric_limits<int64_t>::min())));
+  EXPECT_EQ("9223372036854775807", std::string(buffer, format_int64(buffer, numeric_limits<int64_t>::max())));
+  EXPECT_EQ("18446744073709551615", std::string(buffer, format_uint64(buffer, numeric_limits<uint64_t>::max())));
+}
+
+TEST(NumberConversion, RoundTripRandom)
+{
+  std::mt19937_64 rng(0);
+  char buffer[number_format_max_size];
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t bits = rng();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) {
+      continue;
+    }
+    // The formatted value parses back to the same float, both with
+    // parse_float64 and with strtod
+    std::string s(buffer, format_float64(buffer, value));
+    ASSERT_TRUE(same_bits(value, parse_double(s))) << s;
+    ASSERT_TRUE(same_bits(value, strtod(s.c_str(), NULL))) << s;
+
+    float f;
+    uint32_t fbits = static_cast<uint32_t>(bits);
+    memcpy(&f, &fbits, sizeof(f));
+    if (std::isfinite(f)) {
+      s.assign(buffer, format_float32(buffer, f));
+      ASSERT_EQ(f, strtof(s.c_str(), NULL)) << s;
+    }
+
+    // Parsing agrees with strtod on numbers with any count of digits
+    snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(rng() % 25), value);
+    ASSERT_TRUE(same_bits(strtod(buffer, NULL), parse_double(buffer))) << buffer;
+  }
+}
+
+TEST(NumberConversion, Strided)
+{
+  nd::array a = parse_json("5 * string", "[\"1.5\", \" -2e3 \", \"nan\", \"inf\", \"0.1\"]");
+  nd::array b = nd::empty(5, ndt::type::make<double>());
+  parse_float64_strided(b.data(), sizeof(double), a.cdata(), sizeof(dynd::string), 5,
+                        assign_error_fractional);
+  EXPECT_EQ(1.5, b(0).as<double>());
+  EXPECT_EQ(-2000, b(1).as<double>());
+  EXPECT_TRUE(std::isnan(b(2).as<double>()));
+  EXPECT_EQ(numeric_limits<double>::infinity(), b(3).as<double>());
+  EXPECT_EQ(0.1, b(4).as<double>());
+
+  // Assigning strings to float64 goes through the same path
+  nd::array c = nd::empty(5, ndt::type::make<double>());
+  c.vals() = a;
+  EXPECT_EQ(-2000, c(1).as<double>());
+  EXPECT_EQ(0.1, c(4).as<double>());
+  EXPECT_THROW(parse_json("string", "\"1.5x\"").ucast<double>().eval(), invalid_argument);
+
+  nd::array d = nd::empty(5, ndt::string_type::make());
+  format_float64_strided(d.data(), sizeof(dynd::string), b.cdata(), sizeof(double), 5);
+  EXPECT_EQ("1.5", d(0).as<std::string>());
+  EXPECT_EQ("-2000", d(1).as<std::string>());
+  EXPECT_EQ("nan", d(2).as<std::string>());
+  EXPECT_EQ("inf", d(3).as<std::string>());
+  EXPECT_EQ("0.1", d(4).as<std::string>());
+
+  // Float to string assignment prints the shortest round trip form
+  EXPECT_EQ("0.30000000000000004", nd::array(0.1 + 0.2).ucast(ndt::string_type::make()).eval().as<std::string>());
+  EXPECT_EQ("[0.30000000000000004,1e+100]", format_json(parse_json("2 * float64", "[0.30000000000000004, 1e100]"))
+                                                 .as<std::string>());
+}
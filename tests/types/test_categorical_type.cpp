@@ -7,6 +7,7 @@
 #include <sstream>
 #include <stdexcept>
 #include "inc_gtest.hpp"
+#include "dynd_assertions.hpp"
 
 #include <dynd/array.hpp>
 #include <dynd/types/categorical_type.hpp>
@@ -15,6 +16,8 @@
 #include <dynd/types/convert_type.hpp>
 #include <dynd/array_range.hpp>
 #include <dynd/func/comparison.hpp>
+#include <dynd/func/take.hpp>
+#include <dynd/sort.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -203,6 +206,130 @@ TEST(CategoricalType, Values)
                std::runtime_error);
 }
 
+TEST(CategoricalType, DictionaryEncodeString)
+{
+  const char *a_vals[] = {"foo", "bar", "foo", "baz", "bar", "foo"};
+  nd::array a = nd::dictionary_encode(a_vals);
+  ndt::type cd = a.get_dtype();
+  EXPECT_EQ(categorical_type_id, cd.get_type_id());
+  EXPECT_EQ(ndt::type::make<uint8_t>(), cd.p("storage_type").as<ndt::type>());
+
+  // Codes are given in order of first occurrence
+  const char *cats_vals[] = {"foo", "bar", "baz"};
+  nd::array cats = cd.extended<ndt::categorical_type>()->get_categories();
+  EXPECT_ARRAY_EQ(nd::array(cats_vals), cats);
+  uint8_t codes[] = {0, 1, 0, 2, 1, 0};
+  EXPECT_ARRAY_EQ(nd::array(codes), a.p("ints"));
+
+  // factor_categorical finds the same categories, in sorted order
+  const char *sorted_cats_vals[] = {"bar", "baz", "foo"};
+  EXPECT_EQ(ndt::categorical_type::make(sorted_cats_vals), ndt::factor_categorical(a_vals));
+  EXPECT_EQ("baz", a(3).as<std::string>());
+  EXPECT_EQ("foo", a(5).as<std::string>());
+
+  a = nd::dictionary_encode(nd::empty(0, ndt::string_type::make()));
+  EXPECT_EQ(0, a.get_dim_size());
+  EXPECT_EQ(0u, a.get_dtype().extended<ndt::categorical_type>()->get_category_count());
+}
+
+TEST(CategoricalType, DictionaryEncodeInt)
+{
+  nd::array values = nd::empty(1000, ndt::type::make<int64_t>());
+  for (int i = 0; i < 1000; ++i) {
+    values(i).vals() = (i * 7) % 300 - 150;
+  }
+
+  nd::array a = nd::dictionary_encode(values);
+  EXPECT_EQ(ndt::type::make<uint16_t>(), a.get_dtype().p("storage_type").as<ndt::type>());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ((i * 7) % 300 - 150, a(i).as<int64_t>());
+  }
+
+  EXPECT_THROW(nd::dictionary_encode(nd::empty(2, 2, ndt::type::make<int32_t>())), std::invalid_argument);
+}
+
+TEST(CategoricalType, Equal)
+{
+  const char *a_vals[] = {"foo", "bar", "foo", "baz"};
+  nd::array a = nd::dictionary_encode(a_vals);
+  nd::array b = nd::empty(4, a.get_dtype());
+  b.vals() = a;
+  b(1).vals() = a(3);
+
+  EXPECT_ARRAY_EQ((nd::array{true, false, true, true}), nd::equal(a, b));
+  EXPECT_ARRAY_EQ((nd::array{false, true, false, false}), nd::not_equal(a, b));
+
+  // Codes of different categorical types can't be compared
+  const char *c_vals[] = {"foo", "bar", "qux", "baz"};
+  EXPECT_THROW(nd::equal(a, nd::dictionary_encode(c_vals)), not_comparable_error);
+}
+
+TEST(CategoricalType, AssignOtherCategories)
+{
+  const char *a_vals[] = {"foo", "bar", "foo", "baz"};
+  nd::array a = nd::dictionary_encode(a_vals);
+
+  // Values are converted to the codes of the destination categories
+  const char *b_vals[] = {"baz", "qux", "foo", "bar"};
+  nd::array b = nd::empty(4, nd::dictionary_encode(b_vals).get_dtype());
+  b.vals() = a;
+  uint8_t codes[] = {2, 3, 2, 0};
+  EXPECT_ARRAY_EQ(nd::array(codes), b.p("ints"));
+  EXPECT_EQ("bar", b(1).as<std::string>());
+
+  // A value missing from the destination categories can't be assigned
+  const char *c_vals[] = {"foo", "bar"};
+  nd::array c = nd::empty(4, nd::dictionary_encode(c_vals).get_dtype());
+  EXPECT_THROW(c.vals() = a, std::runtime_error);
+
+  // Nor can categories of a different type
+  int d_vals[] = {1, 2};
+  nd::array d = nd::empty(4, nd::dictionary_encode(d_vals).get_dtype());
+  EXPECT_THROW(d.vals() = a, type_error);
+}
+
+TEST(CategoricalType, Take)
+{
+  const char *a_vals[] = {"foo", "bar", "baz", "qux"};
+  nd::array a = nd::dictionary_encode(a_vals);
+  intptr_t indices[] = {3, 0, 0};
+  nd::array b = nd::take(a, indices);
+  EXPECT_EQ(a.get_dtype(), b.get_dtype());
+  uint8_t codes[] = {3, 0, 0};
+  EXPECT_ARRAY_EQ(nd::array(codes), b.p("ints"));
+}
+
+TEST(CategoricalType, Sort)
+{
+  const char *a_vals[] = {"foo", "bar", "foo", "baz", "bar", "qux", "foo"};
+  nd::array a = nd::dictionary_encode(a_vals);
+
+  // Sorting is by category, not by code
+  int64_t indices[] = {1, 4, 3, 0, 2, 6, 5};
+  EXPECT_ARRAY_EQ(nd::array(indices), nd::argsort(a));
+
+  nd::sort(a);
+  const char *sorted_vals[] = {"bar", "bar", "baz", "foo", "foo", "foo", "qux"};
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(sorted_vals[i], a(i).as<std::string>());
+  }
+}
+
+TEST(CategoricalType, ValueCounts)
+{
+  const char *a_vals[] = {"foo", "bar", "foo", "baz", "bar", "foo"};
+  nd::array a = nd::dictionary_encode(a_vals);
+
+  EXPECT_ARRAY_EQ(3LL, nd::count_distinct(a));
+  nd::array counts = nd::value_counts(a);
+  EXPECT_EQ(a.get_dtype(), counts(irange(), 0).get_dtype());
+  EXPECT_ARRAY_EQ((nd::array{3LL, 2LL, 1LL}), counts(irange(), 1));
+
+  nd::unique(a);
+  uint8_t codes[] = {0, 1, 2};
+  EXPECT_ARRAY_EQ(nd::array(codes), a.p("ints"));
+}
+
 /*
 TEST(CategoricalType, ValuesLonger)
 {
@@ -14,6 +14,8 @@
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/convert_type.hpp>
 #include <dynd/json_parser.hpp>
+#include <dynd/memblock/objectarray_memory_block.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 
 using namespace std;
 using namespace dynd;
@@ -398,6 +400,156 @@ TEST(StringType, StringToFloat64SpecialValues)
   EXPECT_EQ(0xfff0000000000000ULL, nd::array("-1.#INF").ucast<double>().view_scalars<uint64_t>().as<uint64_t>());
 }
 
+TEST(StringType, InlineStorage)
+{
+  EXPECT_EQ(sizeof(char *) + sizeof(size_t), sizeof(dynd::string));
+
+  // Short strings are stored inside the object
+  std::string short_str(dynd::string::inline_capacity, 'x');
+  dynd::string s(short_str.data(), short_str.size());
+  EXPECT_TRUE(s.is_inline());
+  EXPECT_EQ(short_str.size(), s.size());
+  EXPECT_EQ(short_str, std::string(s.begin(), s.end()));
+  EXPECT_EQ(reinterpret_cast<char *>(&s), s.data());
+
+  // One more byte goes to the heap
+  std::string long_str(dynd::string::inline_capacity + 1, 'y');
+  dynd::string t(long_str.data(), long_str.size());
+  EXPECT_FALSE(t.is_inline());
+  EXPECT_EQ(long_str, std::string(t.begin(), t.end()));
+
+  // Copies keep the representation of their size
+  dynd::string u(s), v(t);
+  EXPECT_TRUE(u.is_inline());
+  EXPECT_TRUE(u == s);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_TRUE(v == t);
+  EXPECT_NE(t.data(), v.data());
+  u = t;
+  v = s;
+  EXPECT_FALSE(u.is_inline());
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(long_str, std::string(u.begin(), u.end()));
+  EXPECT_EQ(short_str, std::string(v.begin(), v.end()));
+
+  // The all-zero object is the empty string
+  dynd::string empty;
+  EXPECT_EQ(0u, empty.size());
+  EXPECT_TRUE(empty == dynd::string("", 0));
+  u.clear();
+  EXPECT_TRUE(u == empty);
+
+  // Resizing across the boundary keeps the prefix
+  dynd::string w("abcdef", 6);
+  w.resize(40);
+  EXPECT_FALSE(w.is_inline());
+  EXPECT_EQ("abcdef", std::string(w.begin(), w.begin() + 6));
+  w.resize(3);
+  EXPECT_TRUE(w.is_inline());
+  EXPECT_EQ("abc", std::string(w.begin(), w.end()));
+
+  // Assigning from a part of itself
+  w.assign(w.data() + 1, 2);
+  EXPECT_EQ("bc", std::string(w.begin(), w.end()));
+  w.assign(long_str.data(), long_str.size());
+  w.assign(w.data() + 2, 10);
+  EXPECT_TRUE(w.is_inline());
+  EXPECT_EQ(long_str.substr(2, 10), std::string(w.begin(), w.end()));
+
+  // Short and long strings within arrays
+  nd::array a = parse_json("3 * string", "[\"a\", \"a string longer than fifteen bytes\", \"\"]");
+  EXPECT_EQ("a", a(0).as<std::string>());
+  EXPECT_EQ("a string longer than fifteen bytes", a(1).as<std::string>());
+  EXPECT_EQ("", a(2).as<std::string>());
+  nd::array b = a(irange() < 2).eval();
+  EXPECT_EQ("a", b(0).as<std::string>());
+  EXPECT_EQ("a string longer than fifteen bytes", b(1).as<std::string>());
+}
+
+TEST(StringType, ArenaStorage)
+{
+  intrusive_ptr<memory_block_data> objects =
+      make_objectarray_memory_block(ndt::string_type::make(), NULL, sizeof(dynd::string), 4);
+  memory_block_data *arena = get_objectarray_memory_block_arena(objects.get());
+  EXPECT_EQ(arena, get_objectarray_memory_block_arena(objects.get()));
+
+  std::string long_str = "a string longer than fifteen bytes";
+  dynd::string *strs = reinterpret_cast<dynd::string *>(objects->get_api()->allocate(objects.get(), 4));
+  strs[0].assign("short", 5, arena);
+  EXPECT_TRUE(strs[0].is_inline());
+  for (int i = 1; i < 4; ++i) {
+    strs[i].assign(long_str.data(), long_str.size(), arena);
+    EXPECT_FALSE(strs[i].is_inline());
+  }
+  // Consecutive payloads come from the same arena chunk
+  EXPECT_EQ(strs[1].data() + long_str.size(), strs[2].data());
+  EXPECT_EQ(long_str, std::string(strs[3].begin(), strs[3].end()));
+
+  // Copies of arena strings own their data, and reassigning an arena string
+  // leaves the arena alone
+  dynd::string copy(strs[1]);
+  EXPECT_TRUE(copy == strs[1]);
+  EXPECT_NE(copy.data(), strs[1].data());
+  strs[2] = copy;
+  strs[3].assign("x", 1);
+  EXPECT_EQ("x", std::string(strs[3].begin(), strs[3].end()));
+
+  // Growing the objects moves them to a new chunk
+  strs = reinterpret_cast<dynd::string *>(objects->get_api()->resize(objects.get(), reinterpret_cast<char *>(strs), 64));
+  EXPECT_EQ("short", std::string(strs[0].begin(), strs[0].end()));
+  EXPECT_EQ(long_str, std::string(strs[1].begin(), strs[1].end()));
+  EXPECT_EQ(0u, strs[63].size());
+
+  EXPECT_THROW(get_objectarray_memory_block_arena(make_pod_memory_block(ndt::type::make<int>()).get()),
+               runtime_error);
+}
+
+TEST(StringType, ArenaAssignment)
+{
+  std::string long_str = "a string longer than fifteen bytes";
+  std::string json = "[\"short\", \"" + long_str + "\", \"" + long_str + "\"]";
+  nd::array a = parse_json(ndt::type("var * string"), json.c_str());
+
+  // By default, the strings own their data
+  nd::array b = nd::empty("var * string");
+  b.val_assign(a);
+  EXPECT_EQ(long_str, b(1).as<std::string>());
+  EXPECT_FALSE(reinterpret_cast<const dynd::string *>(b(1).cdata())->is_borrowed());
+
+  // With the option, they allocate it from the arena of the var dimension
+  eval::eval_context ectx;
+  ectx.use_string_arena = true;
+  b = nd::empty("var * string");
+  b.val_assign(a, &ectx);
+  const dynd::string *strs = reinterpret_cast<const dynd::string *>(b(0).cdata());
+  EXPECT_EQ("short", b(0).as<std::string>());
+  EXPECT_TRUE(strs[0].is_inline());
+  for (int i = 1; i < 3; ++i) {
+    EXPECT_EQ(long_str, b(i).as<std::string>());
+    EXPECT_TRUE(strs[i].is_borrowed());
+  }
+  EXPECT_EQ(strs[1].data() + long_str.size(), strs[2].data());
+  // The arena is only visible to the kernels while the var dimension is assigned
+  EXPECT_TRUE(get_string_arena() == NULL);
+
+  // Nested var dimensions and bytes use the arena too
+  json = "[[\"" + long_str + "\"], []]";
+  a = parse_json(ndt::type("2 * var * string"), json.c_str());
+  b = nd::empty("2 * var * string");
+  b.val_assign(a, &ectx);
+  EXPECT_EQ(long_str, b(0, 0).as<std::string>());
+  EXPECT_EQ(0, b(1).get_dim_size());
+  EXPECT_TRUE(reinterpret_cast<const dynd::string *>(b(0, 0).cdata())->is_borrowed());
+
+  a = nd::empty("1 * bytes");
+  reinterpret_cast<dynd::bytes *>(a.data())->assign(long_str.data(), long_str.size());
+  b = nd::empty("var * bytes");
+  b.val_assign(a, &ectx);
+  const dynd::bytes *bytes_d = reinterpret_cast<const dynd::bytes *>(b(0).cdata());
+  EXPECT_EQ(long_str, std::string(bytes_d->data(), bytes_d->size()));
+  EXPECT_TRUE(bytes_d->is_borrowed());
+}
+
 TEST(StringType, Comparisons)
 {
   nd::array a, b;
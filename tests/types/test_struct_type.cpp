@@ -83,6 +83,43 @@ TEST(StructType, CreateOneField)
   EXPECT_EQ("x", tdt->get_field_name(0));
 }
 
+TEST(StructType, FieldIndex)
+{
+  vector<std::string> names;
+  vector<ndt::type> types;
+  for (int i = 0; i < 300; ++i) {
+    names.push_back("field_" + std::to_string(i));
+    types.push_back(ndt::type::make<int32_t>());
+  }
+  ndt::type tp = ndt::struct_type::make(names, types);
+  const ndt::struct_type *sd = tp.extended<ndt::struct_type>();
+
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(i, sd->get_field_index(names[i]));
+  }
+  EXPECT_EQ(-1, sd->get_field_index("field_300"));
+  EXPECT_EQ(-1, sd->get_field_index("field_"));
+  EXPECT_EQ(-1, sd->get_field_index(""));
+
+  // Before any records, the fields are predicted in the order of the type,
+  // afterwards in the order they were last seen
+  for (int i = 0; i < 300; ++i) {
+    const std::string &name = names[299 - i];
+    EXPECT_EQ(299 - i, sd->get_field_index_after(i == 0 ? -1 : 300 - i, name.data(), name.data() + name.size()));
+  }
+  for (int i = 0; i < 300; ++i) {
+    const std::string &name = names[i];
+    EXPECT_EQ(i, sd->get_field_index_after(i - 1, name.data(), name.data() + name.size()));
+  }
+  EXPECT_EQ(-1, sd->get_field_index_after(-1, "x", "x" + 1));
+
+  // With a duplicated name, the first field is found
+  tp = ndt::struct_type::make({"a", "b", "a"}, {ndt::type::make<int32_t>(), ndt::type::make<int32_t>(),
+                                                ndt::type::make<int32_t>()});
+  EXPECT_EQ(0, tp.extended<ndt::struct_type>()->get_field_index("a"));
+  EXPECT_EQ(1, tp.extended<ndt::struct_type>()->get_field_index("b"));
+}
+
 struct two_field_struct {
   int64_t a;
   int32_t b;
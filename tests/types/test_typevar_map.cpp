@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include "inc_gtest.hpp"
+
+#include <dynd/types/typevar_map.hpp>
+#include <dynd/types/typevar_type.hpp>
+
+using namespace std;
+using namespace dynd;
+
+TEST(TypeVarSymbol, Interning)
+{
+  ndt::typevar_symbol a("T"), b(std::string("T")), c("S");
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(&a.str(), &b.str());
+  EXPECT_EQ("T", a.str());
+  EXPECT_EQ(ndt::typevar_type::make("T").extended<ndt::typevar_type>()->get_symbol(), a);
+}
+
+TEST(TypeVarMap, Lookup)
+{
+  ndt::typevar_map tp_vars;
+  EXPECT_TRUE(tp_vars.empty());
+  EXPECT_TRUE(tp_vars["T"].is_null());
+  EXPECT_EQ(1u, tp_vars.size());
+
+  tp_vars["T"] = ndt::type::make<int>();
+  tp_vars[std::string("S")] = ndt::type::make<float>();
+  EXPECT_EQ(2u, tp_vars.size());
+  EXPECT_EQ(ndt::type::make<int>(), tp_vars.at("T"));
+  EXPECT_EQ(ndt::type::make<float>(), tp_vars.at(std::string("S")));
+  EXPECT_EQ(1u, tp_vars.count("S"));
+  EXPECT_EQ(0u, tp_vars.count("R"));
+  EXPECT_TRUE(tp_vars.find("R") == tp_vars.end());
+  EXPECT_THROW(tp_vars.at("R"), out_of_range);
+
+  tp_vars.clear();
+  EXPECT_TRUE(tp_vars.empty());
+  EXPECT_TRUE(tp_vars.find("T") == tp_vars.end());
+}
+
+TEST(TypeVarMap, Overflow)
+{
+  ndt::typevar_map tp_vars;
+  for (int i = 0; i < 20; ++i) {
+    stringstream ss;
+    ss << "T" << i;
+    tp_vars[ss.str()] = ndt::make_fixed_dim(i, ndt::type::make<int>());
+  }
+  EXPECT_EQ(20u, tp_vars.size());
+
+  ndt::typevar_map copied(tp_vars);
+  ndt::typevar_map moved(std::move(tp_vars));
+  EXPECT_TRUE(tp_vars.empty());
+  for (int i = 0; i < 20; ++i) {
+    stringstream ss;
+    ss << "T" << i;
+    EXPECT_EQ(ndt::make_fixed_dim(i, ndt::type::make<int>()), copied.at(ss.str()));
+    EXPECT_EQ(ndt::make_fixed_dim(i, ndt::type::make<int>()), moved.at(ss.str()));
+  }
+
+  tp_vars = copied;
+  EXPECT_EQ(20u, tp_vars.size());
+  EXPECT_EQ(ndt::make_fixed_dim(3, ndt::type::make<int>()), tp_vars.at("T3"));
+}
+
+TEST(TypeVarMap, Match)
+{
+  ndt::typevar_map tp_vars;
+  EXPECT_TRUE(ndt::type("Fixed * T").match(ndt::type("3 * int32"), tp_vars));
+  EXPECT_EQ(1u, tp_vars.size());
+  EXPECT_EQ(ndt::type::make<int>(), tp_vars.at("T"));
+  EXPECT_FALSE(ndt::type("(T, T)").match(ndt::type("(int32, float64)"), tp_vars));
+}